@@ -1,3 +1,4 @@
+import os
 import requests
 from datetime import datetime, timezone, timedelta
 
@@ -6,6 +7,7 @@ API_KEY = "9d2280e95c6d673406795ecc6080e513"
 LAT = 37.5665   # 위도 (서울 예시)
 LON = 126.9780  # 경도 (서울 예시)
 OUTPUT_FILE = "assets/weather_state.txt"
+FORECAST_FILE = "assets/weather_forecast.txt"
 # =====================================
 
 # 한국 표준시 (UTC+9)
@@ -103,7 +105,54 @@ def save_weather(info: dict) -> None:
         f.write(f"SUNSET=\"{info['sunset_str']}\"\n")
 
 
+def fetch_forecast() -> list:
+    """
+    3시간 간격 5일 예보. 게임은 이 사이를 보간해서 쓰므로 하루 몇 번만 받아도 됨.
+    """
+    url = "https://api.openweathermap.org/data/2.5/forecast"
+
+    params = {
+        "lat": LAT,
+        "lon": LON,
+        "appid": API_KEY,
+        "units": "metric",
+    }
+
+    resp = requests.get(url, params=params, timeout=5)
+    resp.raise_for_status()
+
+    rows = []
+    for item in resp.json()["list"]:
+        rows.append((
+            int(item["dt"]),
+            map_weather_tag(item["weather"][0]["main"]),
+            float(item["main"]["temp"]),
+            int(item["main"]["humidity"]),
+        ))
+    return rows
+
+
+def save_forecast(rows: list) -> None:
+    """
+    한 줄에 "유닉스시각 태그 온도 습도". 게임이 파일 바뀜을 감시하므로
+    임시 파일에 다 쓴 뒤 이름을 바꿔서, 쓰다 만 파일을 읽지 않게 함.
+    """
+    tmp = FORECAST_FILE + ".tmp"
+    with open(tmp, "w", encoding="utf-8") as f:
+        f.write("# ts tag temp humidity\n")
+        for ts, tag, temp, hum in rows:
+            f.write(f"{ts} {tag} {temp:.2f} {hum}\n")
+    os.replace(tmp, FORECAST_FILE)
+
+
 def main():
+    try:
+        save_forecast(fetch_forecast())
+        print(f"→ {FORECAST_FILE} 예보 저장 완료")
+    except requests.RequestException as e:
+        # 예보는 없어도 됨 (지난 예보를 그대로 씀)
+        print("예보 가져오기 실패:", e)
+
     try:
         info = fetch_weather()
     except requests.RequestException as e:
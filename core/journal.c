@@ -0,0 +1,707 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include "../include/journal.h"
+#include "../include/rollup.h"
+#include "../include/save.h"
+#include "../include/utils.h"
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <string.h>
+
+#define JOURNAL_CACHE_MAX   32
+#define JOURNAL_TAIL_BYTES  (64 * 1024)   // 재오픈 시 체크포인트 찾을 때 읽는 끝부분 크기
+#define JOURNAL_LINE_MAX    2048
+#define CHECKPOINT_TAG_LEN  (sizeof(JOURNAL_CHECKPOINT_TAG) - 1)
+
+#define JOURNAL_INDEX_MAGIC     "GRJI"
+#define JOURNAL_INDEX_VERSION   1
+
+// 열어본 저널의 누적 요약 (세션 동안 유지 → append 마다 파일을 다시 읽지 않음)
+typedef struct JournalState {
+    bool   used;
+    char   id[32];
+    JournalSummary sum;
+    Uint32 last_use;
+    Uint64 size;        // 반영이 끝난 .jsonl 크기. 읽는 쪽은 여기까지만 봄 (뒤는 쓰는 중일 수 있음)
+    int    pinned;      // 락을 풀고 파일에 쓰는 중 (캐시에서 내보내지 않음)
+
+    // 기록 줄의 파일 오프셋 (logs/<id>.idx 와 같은 내용). 처음 범위 읽기할 때 로드
+    bool    indexed;
+    Uint64* offsets;
+    int     offsetCount, offsetCap;
+    int     indexSaved;     // .idx 파일에 들어 있는 오프셋 수
+    bool    indexDirty;     // 메모리에서 다시 만듦 → .idx 를 통째로 다시 써야 함
+} JournalState;
+
+// logs/<id>.idx 헤더. 뒤에 Uint64 오프셋 count 개 (로컬 캐시라 바이트 순서는 네이티브)
+typedef struct JournalIndexHeader {
+    char   magic[4];
+    Uint32 version;
+    Uint64 covered;     // 인덱스가 반영한 .jsonl 크기. 실제 크기와 다르면 다시 만듦
+    Uint32 count;
+    Uint32 reserved;
+} JournalIndexHeader;
+
+static JournalState s_cache[JOURNAL_CACHE_MAX];
+static Uint32 s_useTick = 0;
+
+// ---------- 경로 ----------
+bool journal_get_path(const char* plant_id, char* out, int outsz)
+{
+    char logs[1024];
+    if (!plant_id || !save_get_logs_dir(logs, sizeof(logs))) return false;
+    SDL_snprintf(out, outsz, "%s/%s.jsonl", logs, plant_id);
+    return true;
+}
+
+static bool get_index_path(const char* plant_id, char* out, int outsz)
+{
+    char logs[1024];
+    if (!save_get_logs_dir(logs, sizeof(logs))) return false;
+    SDL_snprintf(out, outsz, "%s/%s.idx", logs, plant_id);
+    return true;
+}
+
+static bool get_legacy_path(const char* plant_id, char* out, int outsz)
+{
+    char logs[1024];
+    if (!save_get_logs_dir(logs, sizeof(logs))) return false;
+    SDL_snprintf(out, outsz, "%s/%s.json", logs, plant_id);
+    return true;
+}
+
+static bool file_exists(const char* path)
+{
+    FILE* fp = fopen(path, "rb");
+    if (!fp) return false;
+    fclose(fp);
+    return true;
+}
+
+// ---------- 요약 ----------
+JournalEventType journal_event_type(const char* event)
+{
+    if (!event) return JOURNAL_EV_OTHER;
+    if (SDL_strcmp(event, "water") == 0)  return JOURNAL_EV_WATER;
+    if (SDL_strcmp(event, "sun") == 0)    return JOURNAL_EV_SUN;
+    if (SDL_strcmp(event, "stage") == 0)  return JOURNAL_EV_STAGE;
+    if (SDL_strcmp(event, "window") == 0) return JOURNAL_EV_WINDOW;
+    return JOURNAL_EV_OTHER;
+}
+
+static const char* s_countKeys[JOURNAL_EV_COUNT] = { "water", "sun", "stage", "window", "other" };
+
+static void summary_apply(JournalSummary* sum, const JSON_Object* e)
+{
+    JournalEventType t = journal_event_type(json_object_get_string(e, "event"));
+    sum->records++;
+    sum->counts[t]++;
+    if (t == JOURNAL_EV_STAGE) {
+        const char* v = json_object_get_string(e, "value");
+        SDL_strlcpy(sum->last_stage, v ? v : "", sizeof(sum->last_stage));
+    }
+}
+
+static void summary_from_checkpoint(JournalSummary* sum, const JSON_Object* cp)
+{
+    SDL_memset(sum, 0, sizeof(*sum));
+    sum->records = (int)json_object_get_number(cp, "checkpoint");
+    for (int i = 0; i < JOURNAL_EV_COUNT; i++)
+        sum->counts[i] = (int)json_object_get_number(cp, s_countKeys[i]);
+    const char* st = json_object_get_string(cp, "last_stage");
+    SDL_strlcpy(sum->last_stage, st ? st : "", sizeof(sum->last_stage));
+}
+
+static JSON_Value* checkpoint_to_json(const JournalSummary* sum)
+{
+    JSON_Value* v = json_value_init_object();
+    JSON_Object* o = json_value_get_object(v);
+    json_object_set_number(o, "checkpoint", sum->records);
+    for (int i = 0; i < JOURNAL_EV_COUNT; i++)
+        json_object_set_number(o, s_countKeys[i], sum->counts[i]);
+    json_object_set_string(o, "last_stage", sum->last_stage);
+    return v;
+}
+
+static bool is_header(const JSON_Object* o) { return json_object_has_value(o, "journal"); }
+// 버전 1 파일의 태그 없는 체크포인트 줄
+static bool is_checkpoint(const JSON_Object* o) { return json_object_has_value(o, "checkpoint"); }
+
+// 체크포인트 줄은 JOURNAL_CHECKPOINT_TAG 로 시작 (기록 줄은 항상 '{' 로 시작)
+static bool is_checkpoint_line(const char* line)
+{
+    return SDL_strncmp(line, JOURNAL_CHECKPOINT_TAG, CHECKPOINT_TAG_LEN) == 0;
+}
+
+// ---------- 줄 단위 쓰기/읽기 ----------
+// tag(없으면 NULL) + v 를 한 줄로 직렬화해서 buf 뒤에 붙임 (buf 는 SDL_realloc 으로 늘어남)
+static bool line_append(char** buf, size_t* len, const char* tag, const JSON_Value* v)
+{
+    char* s = json_serialize_to_string(v);
+    if (!s) return false;
+    size_t t = tag ? SDL_strlen(tag) : 0;
+    size_t n = SDL_strlen(s);
+    char* nb = (char*)SDL_realloc(*buf, *len + t + n + 2);
+    if (!nb) { json_free_serialized_string(s); return false; }
+    SDL_memcpy(nb + *len, tag, t);
+    SDL_memcpy(nb + *len + t, s, n);
+    nb[*len + t + n] = '\n';
+    nb[*len + t + n + 1] = '\0';
+    *buf = nb;
+    *len += t + n + 1;
+    json_free_serialized_string(s);
+    return true;
+}
+
+static bool checkpoint_append(char** buf, size_t* len, const JournalSummary* sum)
+{
+    JSON_Value* cp = checkpoint_to_json(sum);
+    bool ok = line_append(buf, len, JOURNAL_CHECKPOINT_TAG, cp);
+    json_value_free(cp);
+    return ok;
+}
+
+static bool header_append(char** buf, size_t* len, const char* plant_id)
+{
+    JSON_Value* v = json_value_init_object();
+    JSON_Object* o = json_value_get_object(v);
+    json_object_set_string(o, "journal", "growing");
+    json_object_set_number(o, "version", JOURNAL_VERSION);
+    json_object_set_string(o, "plant_id", plant_id);
+    bool ok = line_append(buf, len, NULL, v);
+    json_value_free(v);
+    return ok;
+}
+
+// fgets 로 한 줄 읽기. 버퍼보다 긴 줄은 잘라서 나머지는 버림
+static bool read_line(FILE* fp, char* line, int size)
+{
+    if (!fgets(line, size, fp)) return false;
+    size_t n = SDL_strlen(line);
+    if (n > 0 && line[n - 1] != '\n' && !feof(fp)) {
+        int c;
+        while ((c = fgetc(fp)) != EOF && c != '\n') {}
+    }
+    return true;
+}
+
+// 처음부터 끝까지 읽어서 요약 계산 (체크포인트가 끝부분에 없을 때만)
+static void scan_full(FILE* fp, JournalSummary* sum)
+{
+    char line[JOURNAL_LINE_MAX];
+    SDL_memset(sum, 0, sizeof(*sum));
+    fseek(fp, 0, SEEK_SET);
+
+    while (read_line(fp, line, sizeof(line))) {
+        if (is_checkpoint_line(line)) continue;
+        JSON_Value* v = json_parse_string(line);
+        JSON_Object* o = json_value_get_object(v);
+        if (o && !is_header(o) && !is_checkpoint(o))
+            summary_apply(sum, o);
+        if (v) json_value_free(v);
+    }
+}
+
+// 끝 JOURNAL_TAIL_BYTES 에서 마지막 체크포인트를 찾고, 그 뒤 기록만 반영
+static void load_summary(FILE* fp, JournalSummary* sum)
+{
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    if (size <= JOURNAL_TAIL_BYTES) {
+        scan_full(fp, sum);
+        return;
+    }
+
+    char* tail = (char*)SDL_malloc(JOURNAL_TAIL_BYTES + 1);
+    if (!tail) { scan_full(fp, sum); return; }
+    fseek(fp, size - JOURNAL_TAIL_BYTES, SEEK_SET);
+    size_t got = fread(tail, 1, JOURNAL_TAIL_BYTES, fp);
+    tail[got] = '\0';
+
+    // 마지막 체크포인트 줄. JSON 문자열 안의 줄바꿈은 \n 으로 이스케이프되므로 "\n태그" 는 줄 머리에만 나옴
+    const char* cp = NULL;
+    for (const char* p = SDL_strstr(tail, "\n" JOURNAL_CHECKPOINT_TAG); p; p = SDL_strstr(p + 1, "\n" JOURNAL_CHECKPOINT_TAG))
+        cp = p + 1;
+
+    if (!cp) {
+        SDL_free(tail);
+        scan_full(fp, sum);
+        return;
+    }
+
+    bool first = true;
+    const char* p = cp;
+    while (p && *p) {
+        const char* nl = SDL_strchr(p, '\n');
+        size_t n = nl ? (size_t)(nl - p) : SDL_strlen(p);
+        if (n > 0 && n < JOURNAL_LINE_MAX) {
+            char line[JOURNAL_LINE_MAX];
+            SDL_memcpy(line, p, n);
+            line[n] = '\0';
+            // cp 가 마지막 체크포인트라 뒤에는 기록 줄만 있음
+            JSON_Value* v = json_parse_string(first ? line + CHECKPOINT_TAG_LEN : line);
+            JSON_Object* o = json_value_get_object(v);
+            if (o) {
+                if (first) summary_from_checkpoint(sum, o);
+                else if (!is_header(o) && !is_checkpoint(o)) summary_apply(sum, o);
+            }
+            if (v) json_value_free(v);
+        }
+        first = false;
+        p = nl ? nl + 1 : NULL;
+    }
+    SDL_free(tail);
+}
+
+// ---------- 마이그레이션: logs/<id>.json → logs/<id>.jsonl ----------
+static bool migrate_legacy(const char* plant_id, const char* jsonl_path)
+{
+    char legacy[1024], tmp[1100], moved[1100];
+    if (!get_legacy_path(plant_id, legacy, sizeof(legacy))) return false;
+
+    JSON_Value* root = json_parse_file(legacy);
+    if (!root) return false;   // 예전 파일 없음
+
+    JSON_Array* history = json_object_get_array(json_value_get_object(root), "history");
+    size_t n = history ? json_array_get_count(history) : 0;
+
+    char* buf = NULL;
+    size_t len = 0;
+    JournalSummary sum;
+    SDL_memset(&sum, 0, sizeof(sum));
+
+    bool ok = header_append(&buf, &len, plant_id);
+    for (size_t i = 0; ok && i < n; i++) {
+        JSON_Object* e = json_array_get_object(history, i);
+        if (!e) continue;
+        ok = line_append(&buf, &len, NULL, json_object_get_wrapping_value(e));
+        summary_apply(&sum, e);
+        if (ok && sum.records % JOURNAL_CHECKPOINT_EVERY == 0)
+            ok = checkpoint_append(&buf, &len, &sum);
+    }
+    json_value_free(root);
+
+    if (ok) {
+        SDL_snprintf(tmp, sizeof(tmp), "%s.tmp", jsonl_path);
+        FILE* fp = fopen(tmp, "wb");
+        ok = fp && fwrite(buf, 1, len, fp) == len;
+        if (fp) ok = (fclose(fp) == 0) && ok;
+        if (ok) ok = rename(tmp, jsonl_path) == 0;
+        if (!ok) remove(tmp);
+    }
+    SDL_free(buf);
+
+    if (!ok) {
+        SDL_Log("[JOURNAL] migrate failed: %s", legacy);
+        return false;
+    }
+
+    // 원본은 지우지 않고 이름만 바꿔둠
+    SDL_snprintf(moved, sizeof(moved), "%s.migrated", legacy);
+    remove(moved);
+    rename(legacy, moved);
+    SDL_Log("[JOURNAL] migrated %s (%d entries)", plant_id, (int)n);
+    return true;
+}
+
+// 마지막 줄이 \n 으로 안 끝나면 (쓰다가 꺼진 경우) 줄바꿈을 채워서 다음 기록이 섞이지 않게
+static void repair_tail(FILE* fp)
+{
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    if (size <= 0) return;
+    fseek(fp, size - 1, SEEK_SET);
+    if (fgetc(fp) != '\n') {
+        fseek(fp, 0, SEEK_END);
+        fputc('\n', fp);
+        SDL_Log("[JOURNAL] repaired torn last line");
+    }
+}
+
+// ---------- 캐시 ----------
+static JournalState* open_state(const char* plant_id)
+{
+    JournalState* slot = NULL;
+    char path[1024];
+
+    for (int i = 0; i < JOURNAL_CACHE_MAX; i++) {
+        if (s_cache[i].used && SDL_strcmp(s_cache[i].id, plant_id) == 0) {
+            s_cache[i].last_use = ++s_useTick;
+            return &s_cache[i];
+        }
+    }
+
+    if (!journal_get_path(plant_id, path, sizeof(path))) return NULL;
+
+    // 새 저널은 파일을 만들지 않음 (첫 기록과 함께 헤더를 씀)
+    if (!file_exists(path)) migrate_legacy(plant_id, path);
+
+    // 빈 칸 또는 가장 오래 안 쓴 칸 (쓰는 중인 칸 제외)
+    for (int i = 0; i < JOURNAL_CACHE_MAX; i++) {
+        if (!s_cache[i].used) { slot = &s_cache[i]; break; }
+        if (s_cache[i].pinned) continue;
+        if (!slot || s_cache[i].last_use < slot->last_use) slot = &s_cache[i];
+    }
+    if (!slot) return NULL;
+
+    SDL_free(slot->offsets);
+    SDL_memset(slot, 0, sizeof(*slot));
+    SDL_strlcpy(slot->id, plant_id, sizeof(slot->id));
+
+    FILE* fp = fopen(path, "r+b");
+    if (fp) {
+        repair_tail(fp);
+        load_summary(fp, &slot->sum);
+        fseek(fp, 0, SEEK_END);
+        slot->size = (Uint64)ftell(fp);
+        fclose(fp);
+    }
+    slot->used = true;
+    slot->last_use = ++s_useTick;
+    return slot;
+}
+
+// ---------- 오프셋 인덱스 ----------
+static bool index_push(JournalState* st, Uint64 off)
+{
+    if (st->offsetCount == st->offsetCap) {
+        int cap = st->offsetCap ? st->offsetCap * 2 : 256;
+        Uint64* p = (Uint64*)SDL_realloc(st->offsets, sizeof(Uint64) * cap);
+        if (!p) return false;
+        st->offsets = p;
+        st->offsetCap = cap;
+    }
+    st->offsets[st->offsetCount++] = off;
+    return true;
+}
+
+static bool index_write_header(FILE* fp, Uint64 covered, Uint32 count)
+{
+    JournalIndexHeader h;
+    SDL_memset(&h, 0, sizeof(h));
+    SDL_memcpy(h.magic, JOURNAL_INDEX_MAGIC, 4);
+    h.version = JOURNAL_INDEX_VERSION;
+    h.covered = covered;
+    h.count = count;
+    fseek(fp, 0, SEEK_SET);
+    return fwrite(&h, sizeof(h), 1, fp) == 1;
+}
+
+static bool index_load_file(JournalState* st)
+{
+    char path[1024];
+    JournalIndexHeader h;
+    if (!get_index_path(st->id, path, sizeof(path))) return false;
+
+    FILE* fp = fopen(path, "rb");
+    if (!fp) return false;
+    bool ok = fread(&h, sizeof(h), 1, fp) == 1 &&
+        SDL_memcmp(h.magic, JOURNAL_INDEX_MAGIC, 4) == 0 &&
+        h.version == JOURNAL_INDEX_VERSION &&
+        h.covered == st->size;
+
+    st->offsetCount = 0;
+    for (Uint32 i = 0; ok && i < h.count; i++) {
+        Uint64 off;
+        ok = fread(&off, sizeof(off), 1, fp) == 1 && off < st->size && index_push(st, off);
+    }
+    fclose(fp);
+    if (!ok) st->offsetCount = 0;
+    st->indexSaved = st->offsetCount;
+    return ok;
+}
+
+// .jsonl 을 반영된 크기까지 한 번 훑어서 기록 줄 오프셋을 다시 만든다 (요약도 같이 맞춤)
+static void index_rebuild(JournalState* st, FILE* fp)
+{
+    char line[JOURNAL_LINE_MAX];
+    JournalSummary sum;
+    SDL_memset(&sum, 0, sizeof(sum));
+    st->offsetCount = 0;
+
+    fseek(fp, 0, SEEK_SET);
+    for (;;) {
+        Uint64 off = (Uint64)ftell(fp);
+        if (off >= st->size || !read_line(fp, line, sizeof(line))) break;
+        if (is_checkpoint_line(line)) continue;
+        JSON_Value* v = json_parse_string(line);
+        JSON_Object* o = json_value_get_object(v);
+        if (o && !is_header(o) && !is_checkpoint(o)) {
+            index_push(st, off);
+            summary_apply(&sum, o);
+        }
+        if (v) json_value_free(v);
+    }
+    st->sum = sum;
+}
+
+// 읽는 쪽에서 부름: 메모리에만 다시 만들고 .idx 파일은 I/O 스레드가 journal_save_indexes 로 씀
+static bool ensure_index(JournalState* st, const char* path)
+{
+    if (st->indexed) return true;
+
+    if (!index_load_file(st) || st->offsetCount != st->sum.records) {
+        FILE* fp = fopen(path, "rb");
+        if (!fp) return false;
+        index_rebuild(st, fp);
+        fclose(fp);
+        st->indexDirty = true;
+        SDL_Log("[JOURNAL] index rebuilt: %s (%d records)", st->id, st->offsetCount);
+    }
+    st->indexed = true;
+    return true;
+}
+
+// .idx 쓰기 작업 (락 안에서 복사해 두고 락 밖에서 씀)
+typedef struct IndexJob {
+    char    id[32];
+    int     from;       // 파일에 이미 있는 오프셋 수 (0 이면 통째로 다시 씀)
+    int     count;      // 쓴 뒤 전체 수
+    Uint64  covered;
+    Uint64* offs;       // [from, count)
+} IndexJob;
+
+static bool index_write_job(const IndexJob* j)
+{
+    char path[1024], tmp[1100];
+    if (!get_index_path(j->id, path, sizeof(path))) return false;
+    size_t n = (size_t)(j->count - j->from);
+
+    if (j->from > 0) {
+        // 뒤에 붙이고 헤더 갱신 (헤더를 마지막에 써서 중간에 꺼져도 예전 개수로 읽힘)
+        JournalIndexHeader h;
+        FILE* fp = fopen(path, "r+b");
+        if (!fp) return false;
+        bool ok = fread(&h, sizeof(h), 1, fp) == 1 &&
+            SDL_memcmp(h.magic, JOURNAL_INDEX_MAGIC, 4) == 0 &&
+            h.version == JOURNAL_INDEX_VERSION &&
+            h.count == (Uint32)j->from;
+        if (ok) {
+            fseek(fp, (long)(sizeof(h) + sizeof(Uint64) * (size_t)j->from), SEEK_SET);
+            ok = fwrite(j->offs, sizeof(Uint64), n, fp) == n;
+            ok = ok && index_write_header(fp, j->covered, (Uint32)j->count);
+        }
+        return (fclose(fp) == 0) && ok;
+    }
+
+    SDL_snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    FILE* fp = fopen(tmp, "wb");
+    if (!fp) return false;
+    bool ok = index_write_header(fp, j->covered, (Uint32)j->count);
+    if (ok && n > 0) ok = fwrite(j->offs, sizeof(Uint64), n, fp) == n;
+    ok = (fclose(fp) == 0) && ok;
+
+    if (!ok || !file_replace(tmp, path)) {
+        remove(tmp);
+        return false;
+    }
+    return true;
+}
+
+static JournalState* find_state(const char* plant_id)
+{
+    for (int i = 0; i < JOURNAL_CACHE_MAX; i++)
+        if (s_cache[i].used && SDL_strcmp(s_cache[i].id, plant_id) == 0) return &s_cache[i];
+    return NULL;
+}
+
+void journal_save_indexes(SDL_mutex* io_lock)
+{
+    IndexJob jobs[JOURNAL_CACHE_MAX];
+    int n = 0;
+
+    // 락 안: 파일에 없는 오프셋만 복사 (다시 만든 것은 전부)
+    for (int i = 0; i < JOURNAL_CACHE_MAX; i++) {
+        JournalState* st = &s_cache[i];
+        if (!st->used || !st->indexed) continue;
+        if (!st->indexDirty && st->indexSaved == st->offsetCount) continue;
+
+        IndexJob* j = &jobs[n];
+        SDL_strlcpy(j->id, st->id, sizeof(j->id));
+        j->from = st->indexDirty ? 0 : st->indexSaved;
+        j->count = st->offsetCount;
+        j->covered = st->size;
+        j->offs = (Uint64*)SDL_malloc(sizeof(Uint64) * (size_t)(j->count - j->from + 1));
+        if (!j->offs) continue;
+        SDL_memcpy(j->offs, st->offsets + j->from, sizeof(Uint64) * (size_t)(j->count - j->from));
+        st->indexSaved = st->offsetCount;
+        st->indexDirty = false;
+        n++;
+    }
+    if (n == 0) return;
+
+    bool ok[JOURNAL_CACHE_MAX];
+    if (io_lock) SDL_UnlockMutex(io_lock);
+    for (int i = 0; i < n; i++) {
+        ok[i] = index_write_job(&jobs[i]);
+        SDL_free(jobs[i].offs);
+    }
+    if (io_lock) SDL_LockMutex(io_lock);
+
+    // 실패한 것은 다음에 통째로
+    for (int i = 0; i < n; i++) {
+        if (ok[i]) continue;
+        SDL_Log("[JOURNAL] index write failed: %s", jobs[i].id);
+        JournalState* st = find_state(jobs[i].id);
+        if (st && st->indexed) st->indexDirty = true;
+    }
+}
+
+void journal_reset_cache(void)
+{
+    for (int i = 0; i < JOURNAL_CACHE_MAX; i++) SDL_free(s_cache[i].offsets);
+    SDL_memset(s_cache, 0, sizeof(s_cache));
+    s_useTick = 0;
+}
+
+// ---------- 공개 API ----------
+bool journal_append_many(const char* plant_id, const JSON_Value* const* entries, int n, SDL_mutex* io_lock)
+{
+    if (!plant_id || !entries || n <= 0) return false;
+
+    JournalState* st = open_state(plant_id);
+    char path[1024];
+    if (!st || !journal_get_path(plant_id, path, sizeof(path))) return false;
+
+    char* buf = NULL;
+    size_t len = 0;
+    JournalSummary next = st->sum;
+    bool ok = st->size > 0 || header_append(&buf, &len, plant_id);     // 새 저널이면 헤더부터
+    Uint64* rel = (Uint64*)SDL_malloc(sizeof(Uint64) * n);  // buf 안에서 기록 줄 시작 위치
+    int relCount = 0;
+    if (!rel) { SDL_free(buf); return false; }
+
+    for (int i = 0; ok && i < n; i++) {
+        const JSON_Object* e = json_value_get_object(entries[i]);
+        if (!e) continue;
+        rel[relCount++] = (Uint64)len;
+        ok = line_append(&buf, &len, NULL, entries[i]);
+        summary_apply(&next, e);
+        if (ok && next.records % JOURNAL_CHECKPOINT_EVERY == 0)
+            ok = checkpoint_append(&buf, &len, &next);
+    }
+
+    // 기록 + (있으면) 체크포인트를 write 한 번으로. 쓰는 동안은 I/O 락을 풀어 둠
+    // (읽는 쪽은 st->size 까지만 보므로 쓰는 중인 줄을 안 봄)
+    Uint64 base = 0;
+    if (ok && len > 0) {
+        st->pinned++;
+        if (io_lock) SDL_UnlockMutex(io_lock);
+
+        FILE* fp = fopen(path, "ab");
+        if (fp) {
+            fseek(fp, 0, SEEK_END);
+            base = (Uint64)ftell(fp);
+        }
+        ok = fp && fwrite(buf, 1, len, fp) == len;
+        if (fp) ok = (fclose(fp) == 0) && ok;
+
+        if (io_lock) SDL_LockMutex(io_lock);
+        st->pinned--;
+    }
+    SDL_free(buf);
+
+    if (!ok) {
+        SDL_free(rel);
+        SDL_Log("[JOURNAL] append failed: %s", path);
+        return false;
+    }
+
+    // 여기서부터 읽는 쪽에 보임
+    st->sum = next;
+    st->size = base + len;
+    if (st->indexed) {
+        for (int i = 0; i < relCount; i++) {
+            if (!index_push(st, base + rel[i])) { st->indexed = false; break; }
+        }
+    }
+    SDL_free(rel);
+    rollup_append(plant_id, entries, n, next.records);   // 일/주 집계 (logs/<id>.agg)
+    return true;
+}
+
+int journal_read(const char* plant_id, JournalVisitFn fn, void* user)
+{
+    char path[1024];
+    char line[JOURNAL_LINE_MAX];
+    int visited = 0;
+
+    if (!plant_id || !journal_get_path(plant_id, path, sizeof(path))) return 0;
+
+    // 기록이 한 번도 없는 식물이면 파일을 만들지 않음
+    char legacy[1024];
+    if (!file_exists(path) && !(get_legacy_path(plant_id, legacy, sizeof(legacy)) && file_exists(legacy)))
+        return 0;
+    JournalState* st = open_state(plant_id);
+    if (!st) return 0;
+
+    FILE* fp = fopen(path, "rb");
+    if (!fp) return 0;
+
+    while ((Uint64)ftell(fp) < st->size && read_line(fp, line, sizeof(line))) {
+        if (is_checkpoint_line(line)) continue;
+        JSON_Value* v = json_parse_string(line);
+        JSON_Object* o = json_value_get_object(v);
+        bool keep = true;
+        if (o && !is_header(o) && !is_checkpoint(o)) {
+            visited++;
+            if (fn) keep = fn(o, user);
+        }
+        if (v) json_value_free(v);
+        if (!keep) break;
+    }
+    fclose(fp);
+    return visited;
+}
+
+int journal_read_range(const char* plant_id, int first, int count, JournalVisitFn fn, void* user)
+{
+    char path[1024];
+    char line[JOURNAL_LINE_MAX];
+    int visited = 0;
+
+    if (!plant_id || count <= 0 || first < 0) return 0;
+    if (journal_record_count(plant_id) <= first) return 0;
+
+    JournalState* st = open_state(plant_id);
+    if (!st || !journal_get_path(plant_id, path, sizeof(path)) || !ensure_index(st, path)) return 0;
+    if (first >= st->offsetCount) return 0;
+
+    FILE* fp = fopen(path, "rb");
+    if (!fp) return 0;
+
+    // 한 번 seek 하고 이어서 읽음 (중간 체크포인트 줄은 건너뜀)
+    fseek(fp, (long)st->offsets[first], SEEK_SET);
+    while (visited < count && (Uint64)ftell(fp) < st->size && read_line(fp, line, sizeof(line))) {
+        if (is_checkpoint_line(line)) continue;
+        JSON_Value* v = json_parse_string(line);
+        JSON_Object* o = json_value_get_object(v);
+        bool keep = true;
+        if (o && !is_header(o) && !is_checkpoint(o)) {
+            visited++;
+            if (fn) keep = fn(o, user);
+        }
+        if (v) json_value_free(v);
+        if (!keep) break;
+    }
+    fclose(fp);
+    return visited;
+}
+
+int journal_record_count(const char* plant_id)
+{
+    char path[1024], legacy[1024];
+    if (!plant_id || !journal_get_path(plant_id, path, sizeof(path))) return 0;
+    if (!file_exists(path) && !(get_legacy_path(plant_id, legacy, sizeof(legacy)) && file_exists(legacy)))
+        return 0;
+
+    JournalState* st = open_state(plant_id);
+    return st ? st->sum.records : 0;
+}
+
+bool journal_get_summary(const char* plant_id, JournalSummary* out)
+{
+    JournalState* st = plant_id ? open_state(plant_id) : NULL;
+    if (!st || !out) return false;
+    *out = st->sum;
+    return true;
+}
@@ -0,0 +1,349 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include "../include/plant_blob.h"
+#include "../include/utils.h"
+#include <parson.h>
+#include <stdio.h>
+#include <sys/stat.h>
+
+#define PLANTBLOB_ID_MAX 32     // core.h 인터닝 표와 같은 길이 (널 포함)
+
+Uint32 plantblob_hash(const void* data, size_t len)
+{
+    const Uint8* p = (const Uint8*)data;
+    Uint32 h = 2166136261u;             // FNV-1a
+    for (size_t i = 0; i < len; i++) { h ^= p[i]; h *= 16777619u; }
+    return h;
+}
+
+static Uint32 hash_str(const char* s)
+{
+    return plantblob_hash(s, SDL_strlen(s));
+}
+
+static Uint32 crc32(const void* data, size_t len)
+{
+    const Uint8* p = (const Uint8*)data;
+    Uint32 c = 0xFFFFFFFFu;
+    for (size_t i = 0; i < len; i++) {
+        c ^= p[i];
+        for (int k = 0; k < 8; k++) c = (c >> 1) ^ (0xEDB88320u & (0u - (c & 1u)));
+    }
+    return ~c;
+}
+
+bool plantblob_stat(const char* path, Sint64* mtime, Sint64* size)
+{
+    struct stat st;
+    if (stat(path, &st) != 0) return false;
+    *mtime = (Sint64)st.st_mtime;
+    *size = (Sint64)st.st_size;
+    return true;
+}
+
+// 파일 전체를 버퍼 하나로 (끝에 널). out_size 는 NULL 가능
+static char* read_all(const char* path, Uint32* out_size)
+{
+    FILE* fp = fopen(path, "rb");
+    if (!fp) return NULL;
+    fseek(fp, 0, SEEK_END);
+    long len = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    char* buf = len >= 0 ? (char*)SDL_malloc((size_t)len + 1) : NULL;
+    if (!buf) { fclose(fp); return NULL; }
+    size_t got = fread(buf, 1, (size_t)len, fp);
+    fclose(fp);
+    buf[got] = '\0';
+    if (out_size) *out_size = (Uint32)got;
+    return buf;
+}
+
+char* plantblob_read_text(const char* path, Uint32* hash)
+{
+    Uint32 len = 0;
+    char* text = read_all(path, &len);
+    if (text && hash) *hash = plantblob_hash(text, len);
+    return text;
+}
+
+void plantblob_path_for(const char* json_path, char* out, int outsz)
+{
+    SDL_strlcpy(out, json_path, outsz);
+    size_t n = SDL_strlen(out);
+    if (n >= 5 && SDL_strcmp(out + n - 5, ".json") == 0) out[n - 5] = '\0';
+    SDL_strlcat(out, ".bin", outsz);
+}
+
+// ---------- 컴파일 ----------
+typedef struct BlobBuilder {
+    char* strings;
+    Uint32 strSize, strCap;
+    PlantBlobRecord* recs;
+    int count;
+    Uint32* hash;
+    Uint32 hashCap;
+} BlobBuilder;
+
+static Uint32 builder_str(BlobBuilder* b, const char* s)
+{
+    if (!s || !*s) return 0;
+    size_t len = SDL_strlen(s);
+    if (b->strSize + len + 1 > b->strCap) {
+        Uint32 cap = b->strCap ? b->strCap : 4096;
+        while (cap < b->strSize + len + 1) cap *= 2;
+        char* p = (char*)SDL_realloc(b->strings, cap);
+        if (!p) return 0;
+        b->strings = p;
+        b->strCap = cap;
+    }
+    Uint32 off = b->strSize;
+    SDL_memcpy(b->strings + off, s, len + 1);
+    b->strSize += (Uint32)len + 1;
+    return off;
+}
+
+static Uint32 builder_find_slot(const BlobBuilder* b, const char* id)
+{
+    Uint32 mask = b->hashCap - 1;
+    Uint32 i = hash_str(id) & mask;
+    for (;;) {
+        Uint32 v = b->hash[i];
+        if (v == 0 || SDL_strcmp(b->strings + b->recs[v - 1].id, id) == 0) return i;
+        i = (i + 1) & mask;             // 선형 탐사
+    }
+}
+
+Uint8* plantblob_compile(const char* json_text, Uint32 src_hash, Sint64 src_mtime, Sint64 src_size,
+    Uint32* out_size)
+{
+    JSON_Value* root = json_parse_string(json_text);
+    if (!root) { SDL_Log("[CATALOG] JSON parse fail"); return NULL; }
+    JSON_Array* arr = json_value_get_array(root);
+    if (!arr) { SDL_Log("[CATALOG] not array root"); json_value_free(root); return NULL; }
+
+    int n = (int)json_array_get_count(arr);
+    BlobBuilder b;
+    SDL_memset(&b, 0, sizeof(b));
+    b.hashCap = 16;
+    while (b.hashCap < (Uint32)n * 2) b.hashCap *= 2;  // 부하율 1/2 이하
+    b.recs = (PlantBlobRecord*)SDL_calloc(n > 0 ? n : 1, sizeof(PlantBlobRecord));
+    b.hash = (Uint32*)SDL_calloc(b.hashCap, sizeof(Uint32));
+    b.strCap = 4096;
+    b.strings = (char*)SDL_malloc(b.strCap);
+    if (b.strings) b.strings[0] = '\0';
+    b.strSize = 1;                      // 오프셋 0 = 빈 문자열 자리
+
+    Uint8* blob = NULL;
+    if (!b.recs || !b.hash || !b.strings) goto done;
+
+    for (int i = 0; i < n; i++) {
+        JSON_Object* o = json_array_get_object(arr, i);
+        char key[PLANTBLOB_ID_MAX];
+        const char* id = json_object_get_string(o, "id");
+        SDL_strlcpy(key, id ? id : "", sizeof(key));   // 잘린 id 기준
+        if (!key[0]) { SDL_Log("[CATALOG] entry %d has no id, skipped", i); continue; }
+
+        Uint32 slot = builder_find_slot(&b, key);
+        if (b.hash[slot] != 0) {
+            SDL_Log("[CATALOG] duplicate id '%s' (entry %d ignored)", key, i);
+            continue;   // 같은 id 가 여럿이면 앞의 것
+        }
+
+        PlantBlobRecord* r = &b.recs[b.count];
+        r->id = builder_str(&b, key);
+        r->name_kr = builder_str(&b, json_object_get_string(o, "name_kr"));
+        r->latin = builder_str(&b, json_object_get_string(o, "latin"));
+        r->icon = builder_str(&b, json_object_get_string(o, "icon"));
+        if (!r->id) goto done;
+        r->light_level = (Sint32)json_object_get_number(o, "light_level");
+        r->water_days = (Sint32)json_object_get_number(o, "water_days");
+        r->min_temp = (Sint32)json_object_get_number(o, "min_temp");
+        r->max_temp = (Sint32)json_object_get_number(o, "max_temp");
+        r->moisture_opt = (float)json_object_get_number(o, "moisture_opt");
+        r->temp_min = (float)json_object_get_number(o, "temp_min");
+        r->temp_max = (float)json_object_get_number(o, "temp_max");
+        r->humidity_min = (float)json_object_get_number(o, "humidity_min");
+        r->humidity_max = (float)json_object_get_number(o, "humidity_max");
+        b.hash[slot] = (Uint32)++b.count;
+    }
+
+    if (b.strSize > PLANTBLOB_STRINGS_MAX) {
+        SDL_Log("[CATALOG] string table too large (%u bytes)", b.strSize);
+        goto done;
+    }
+
+    // 헤더 | 레코드 | 해시 | 문자열 (4바이트 정렬)
+    Uint32 recOff = (Uint32)sizeof(PlantBlobHeader);
+    Uint32 hashOff = recOff + (Uint32)(sizeof(PlantBlobRecord) * b.count);
+    Uint32 strOff = hashOff + b.hashCap * (Uint32)sizeof(Uint32);
+    Uint32 total = strOff + ((b.strSize + 3u) & ~3u);
+
+    blob = (Uint8*)SDL_calloc(1, total);
+    if (!blob) goto done;
+    PlantBlobHeader* h = (PlantBlobHeader*)blob;
+    SDL_memcpy(h->magic, PLANTBLOB_MAGIC, 4);
+    h->version = PLANTBLOB_VERSION;
+    h->count = (Uint32)b.count;
+    h->hash_cap = b.hashCap;
+    h->records_off = recOff;
+    h->hash_off = hashOff;
+    h->strings_off = strOff;
+    h->strings_size = b.strSize;
+    h->total_size = total;
+    h->src_mtime = src_mtime;
+    h->src_size = src_size;
+    h->src_hash = src_hash;
+    SDL_memcpy(blob + recOff, b.recs, sizeof(PlantBlobRecord) * b.count);
+    SDL_memcpy(blob + hashOff, b.hash, b.hashCap * sizeof(Uint32));
+    SDL_memcpy(blob + strOff, b.strings, b.strSize);
+    h->crc = crc32(blob + sizeof(*h), total - sizeof(*h));
+    if (out_size) *out_size = total;
+
+done:
+    SDL_free(b.strings);
+    SDL_free(b.recs);
+    SDL_free(b.hash);
+    json_value_free(root);
+    return blob;
+}
+
+// ---------- 읽기 ----------
+bool plantblob_check(const Uint8* blob, Uint32 size)
+{
+    if (!blob || size < sizeof(PlantBlobHeader)) return false;
+    const PlantBlobHeader* h = (const PlantBlobHeader*)blob;
+    if (SDL_memcmp(h->magic, PLANTBLOB_MAGIC, 4) != 0 || h->version != PLANTBLOB_VERSION) return false;
+    if (h->total_size != size) return false;
+    if (h->hash_cap == 0 || (h->hash_cap & (h->hash_cap - 1)) != 0 || h->hash_cap <= h->count) return false;
+    if ((Uint64)h->records_off + (Uint64)h->count * sizeof(PlantBlobRecord) > size) return false;
+    if ((Uint64)h->hash_off + (Uint64)h->hash_cap * sizeof(Uint32) > size) return false;
+    if (h->strings_size == 0 || h->strings_size > PLANTBLOB_STRINGS_MAX ||
+        (Uint64)h->strings_off + h->strings_size > size) return false;
+    if ((h->records_off | h->hash_off) & 3u) return false;
+    if (crc32(blob + sizeof(*h), size - sizeof(*h)) != h->crc) return false;
+
+    // 문자열 표가 널로 끝나고 모든 오프셋이 안쪽이어야 그대로 쓸 수 있음
+    const char* strings = (const char*)blob + h->strings_off;
+    if (strings[0] != '\0' || strings[h->strings_size - 1] != '\0') return false;
+    const PlantBlobRecord* r = plantblob_records(blob);
+    for (Uint32 i = 0; i < h->count; i++) {
+        if (r[i].id == 0 || r[i].id >= h->strings_size || r[i].name_kr >= h->strings_size ||
+            r[i].latin >= h->strings_size || r[i].icon >= h->strings_size) return false;
+    }
+    const Uint32* hash = (const Uint32*)(blob + h->hash_off);
+    for (Uint32 i = 0; i < h->hash_cap; i++)
+        if (hash[i] > h->count) return false;
+    return true;
+}
+
+Uint8* plantblob_read(const char* path, Uint32* out_size)
+{
+    Uint32 size = 0;
+    Uint8* blob = (Uint8*)read_all(path, &size);     // read 한 번
+    if (!blob) return NULL;
+    if (!plantblob_check(blob, size)) {
+        SDL_Log("[CATALOG] ignoring invalid or old catalog: %s", path);
+        SDL_free(blob);
+        return NULL;
+    }
+    if (out_size) *out_size = size;
+    return blob;
+}
+
+bool plantblob_write(const char* path, const Uint8* blob, Uint32 size)
+{
+    char tmp[1100];
+    SDL_snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    FILE* fp = fopen(tmp, "wb");
+    if (!fp) return false;
+    bool ok = fwrite(blob, size, 1, fp) == 1;
+    ok = (fclose(fp) == 0) && ok;
+
+    if (!ok || !file_replace(tmp, path)) {
+        remove(tmp);
+        return false;
+    }
+    return true;
+}
+
+const PlantBlobRecord* plantblob_records(const Uint8* blob)
+{
+    return (const PlantBlobRecord*)(blob + ((const PlantBlobHeader*)blob)->records_off);
+}
+
+const char* plantblob_str(const Uint8* blob, Uint32 off)
+{
+    const PlantBlobHeader* h = (const PlantBlobHeader*)blob;
+    if (off >= h->strings_size) return "";
+    return (const char*)blob + h->strings_off + off;
+}
+
+int plantblob_find(const Uint8* blob, const char* id)
+{
+    if (!blob || !id || !*id) return -1;
+    const PlantBlobHeader* h = (const PlantBlobHeader*)blob;
+    const Uint32* hash = (const Uint32*)(blob + h->hash_off);
+    const PlantBlobRecord* r = plantblob_records(blob);
+    Uint32 mask = h->hash_cap - 1;
+    Uint32 i = hash_str(id) & mask;
+    for (Uint32 probes = 0; probes < h->hash_cap; probes++) {
+        Uint32 v = hash[i];
+        if (v == 0) return -1;
+        if (SDL_strcmp(plantblob_str(blob, r[v - 1].id), id) == 0) return (int)v - 1;
+        i = (i + 1) & mask;
+    }
+    return -1;
+}
+
+// ---------- 컴파일 도구 ----------
+static void print_usage(void)
+{
+    printf("usage: GROWING --compile-catalog [plants.json] [plants.bin]\n"
+           "  plants.json 을 읽어 바이너리 카탈로그를 만든다 (기본: assets/plants.json → assets/plants.bin).\n"
+           "  게임은 JSON 이 바뀌면 알아서 다시 만들지만, 배포 전에 미리 만들어 두면 첫 실행에 JSON 을 안 읽음.\n");
+}
+
+int plantblob_main(int argc, char** argv)
+{
+    for (int i = 2; i < argc; i++) {
+        if (SDL_strcmp(argv[i], "--help") == 0 || SDL_strcmp(argv[i], "-h") == 0) {
+            print_usage();
+            return 0;
+        }
+    }
+
+    const char* json = argc > 2 ? argv[2] : ASSETS_DIR "plants.json";
+    char bin[512];
+    if (argc > 3) SDL_strlcpy(bin, argv[3], sizeof(bin));
+    else plantblob_path_for(json, bin, sizeof(bin));
+
+    Sint64 mtime = 0, size = -1;
+    Uint32 hash = 0;
+    char* text = plantblob_stat(json, &mtime, &size) ? plantblob_read_text(json, &hash) : NULL;
+    if (!text) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[CATALOG] cannot read %s", json);
+        return 1;
+    }
+
+    Uint32 blobSize = 0;
+    Uint8* blob = plantblob_compile(text, hash, mtime, size, &blobSize);
+    SDL_free(text);
+    if (!blob || !plantblob_write(bin, blob, blobSize)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[CATALOG] compile/write failed: %s", bin);
+        SDL_free(blob);
+        return 1;
+    }
+    SDL_free(blob);
+
+    // 다시 읽어서 모든 id 가 해시 표로 찾아지는지 확인
+    blob = plantblob_read(bin, &blobSize);
+    if (!blob) return 1;
+    const PlantBlobHeader* h = (const PlantBlobHeader*)blob;
+    const PlantBlobRecord* r = plantblob_records(blob);
+    int bad = 0;
+    for (Uint32 i = 0; i < h->count; i++)
+        if (plantblob_find(blob, plantblob_str(blob, r[i].id)) != (int)i) bad++;
+    SDL_Log("[CATALOG] %s: %u plants, %u bytes (strings %u), %d lookup errors",
+        bin, h->count, blobSize, h->strings_size, bad);
+    SDL_free(blob);
+    return bad ? 1 : 0;
+}
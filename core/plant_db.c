@@ -1,73 +1,365 @@
+#define _CRT_SECURE_NO_WARNINGS
 #include "../include/common.h"
 #include "../include/core.h"
-#include <parson.h>   // vcpkg or local header
+#include "../include/plant_blob.h"
 
+// 카탈로그는 시작할 때 한 번 읽고, plants.json 이 바뀌면 같은 자리에 덮어씀.
+// JSON 은 plant_blob.c 가 바이너리(plants.bin)로 컴파일해 두고, 여기서는 그 바이너리만 읽음.
+// PlantInfo 는 고정 크기 블록에 들어 있어 realloc 으로 옮겨지지 않음 → 다른 씬이 들고 있는
+// const PlantInfo* 와 인덱스가 다시 읽은 뒤에도 그대로 유효.
+#define PLANTDB_BLOCK_SHIFT 6
+#define PLANTDB_BLOCK_SIZE  (1 << PLANTDB_BLOCK_SHIFT)
+#define PLANTDB_POLL_MS     1000    // 파일 변경 확인 간격
+#define PLANTDB_POOL_MAX    256     // 문자열 풀 조각 수 (오프셋 위 8비트)
 
-static PlantInfo* g_plants = NULL;
+static PlantInfo** g_blocks = NULL;     // 블록 포인터 배열 (이 배열만 늘어나며 옮겨짐)
+static int g_blockCount = 0;
 static int g_count = 0;
+static int* s_seen = NULL;              // 인덱스별 마지막으로 카탈로그에 나온 세대 (삭제 확인)
+
+// 차가운 문자열(이름/학명/아이콘 경로)은 PlantInfo 밖의 풀에 두고 오프셋만 들고 있음.
+// 풀 조각 = 읽어 들인 카탈로그 바이너리 하나 (문자열 표를 복사하지 않고 그대로 씀).
+// 오프셋 = (조각 번호 << 24) | 문자열 표 안 위치. 조각은 plantdb_free 까지 살아 있으므로
+// 돌려준 const char* 도 그때까지 유효. 오프셋 0 = 빈 문자열 (문자열 표 첫 바이트는 항상 널).
+typedef struct PoolChunk {
+    Uint8* blob;                        // 카탈로그 바이너리 전체 (이 조각이 소유)
+    const char* strings;
+    Uint32 size;
+} PoolChunk;
+static PoolChunk s_pool[PLANTDB_POOL_MAX];
+static int       s_poolChunks = 0;
+
+// 원본 파일 정보 (변경 감지)
+static char   s_path[512];
+static Sint64 s_mtime = 0, s_size = -1;
+static Uint32 s_contentHash = 0;
+static Uint32 s_generation = 0;         // 내용이 바뀌어 다시 읽을 때마다 +1
+static Uint32 s_lastPoll = 0;
+
+// id 인터닝: 문자열 → 정수 핸들 (1부터, 0 = 없음)
+// 핸들은 프로세스가 끝날 때까지 유지 → plantdb 를 다시 읽어도 같은 id 는 같은 핸들
+static char (*s_names)[32] = NULL;      // 핸들 - 1 → id 문자열
+static int  s_nameCount = 0, s_nameCap = 0;
+static int* s_nameHash = NULL;          // 칸마다 핸들, 0 = 빈 칸 (오픈 어드레싱)
+static int  s_nameHashCap = 0;          // 2의 거듭제곱
+
+// 핸들 → 카탈로그 인덱스 (-1 = 카탈로그에 없음). 한 번 정해진 인덱스는 바뀌지 않음
+static int* s_handleIndex = NULL;
+static int  s_handleIndexCap = 0;
+
+static Uint32 hash_id(const char* s) {
+    Uint32 h = 2166136261u;             // FNV-1a
+    while (*s) { h ^= (Uint8)*s++; h *= 16777619u; }
+    return h;
+}
+
+static int name_find_slot(const char* id) {
+    Uint32 mask = (Uint32)s_nameHashCap - 1;
+    Uint32 i = hash_id(id) & mask;
+    for (;;) {
+        int v = s_nameHash[i];
+        if (v == 0 || SDL_strcmp(s_names[v - 1], id) == 0) return (int)i;
+        i = (i + 1) & mask;             // 선형 탐사
+    }
+}
+
+static int name_rehash(int cap) {
+    int* h = (int*)SDL_calloc((size_t)cap, sizeof(int));
+    if (!h) return 0;
+    SDL_free(s_nameHash);
+    s_nameHash = h;
+    s_nameHashCap = cap;
+    for (int i = 0; i < s_nameCount; ++i)
+        s_nameHash[name_find_slot(s_names[i])] = i + 1;
+    return 1;
+}
+
+PlantId plantdb_lookup_id(const char* id) {
+    if (!id || !*id || s_nameHashCap == 0) return PLANT_ID_NONE;
+    return s_nameHash[name_find_slot(id)];
+}
+
+PlantId plantdb_intern(const char* id) {
+    if (!id || !*id) return PLANT_ID_NONE;
+    PlantId h = plantdb_lookup_id(id);
+    if (h != PLANT_ID_NONE) return h;
+
+    // 부하율 1/2 이하 유지
+    if ((s_nameCount + 1) * 2 > s_nameHashCap &&
+        !name_rehash(s_nameHashCap ? s_nameHashCap * 2 : 64))
+        return PLANT_ID_NONE;
+
+    if (s_nameCount == s_nameCap) {
+        int cap = s_nameCap ? s_nameCap * 2 : 32;
+        char (*p)[32] = (char (*)[32])SDL_realloc(s_names, sizeof(*s_names) * cap);
+        if (!p) return PLANT_ID_NONE;
+        s_names = p;
+        s_nameCap = cap;
+    }
+    SDL_strlcpy(s_names[s_nameCount], id, sizeof(s_names[0]));
+    s_nameHash[name_find_slot(s_names[s_nameCount])] = s_nameCount + 1;
+    return ++s_nameCount;
+}
+
+const char* plantdb_id_str(PlantId h) {
+    if (h <= 0 || h > s_nameCount) return NULL;
+    return s_names[h - 1];
+}
+
+static const char* pool_str(Uint32 off) {
+    int c = (int)(off >> 24);
+    Uint32 pos = off & 0xFFFFFFu;
+    if (c >= s_poolChunks || pos >= s_pool[c].size) return "";
+    return s_pool[c].strings + pos;
+}
+
+// 바이너리 문자열 오프셋 → 풀 오프셋. 지금 값(cur)과 글자가 같으면 그대로 둠
+// (다시 읽어도 안 바뀐 식물은 예전 조각을 계속 가리킴). 새 조각을 썼으면 *used = 1
+static Uint32 pool_pick(Uint32 cur, int chunk, Uint32 off, int* used) {
+    if (off == 0) return 0;
+    const char* str = s_pool[chunk].strings + off;
+    if (cur && SDL_strcmp(pool_str(cur), str) == 0) return cur;
+    *used = 1;
+    return ((Uint32)chunk << 24) | off;
+}
+
+const char* plantdb_id(const PlantInfo* p) {
+    const char* s = p ? plantdb_id_str(p->handle) : NULL;
+    return s ? s : "";
+}
+const char* plantdb_name(const PlantInfo* p) { return p ? pool_str(p->name_off) : ""; }
+const char* plantdb_latin(const PlantInfo* p) { return p ? pool_str(p->latin_off) : ""; }
+const char* plantdb_icon(const PlantInfo* p) { return p ? pool_str(p->icon_off) : ""; }
 
 void plantdb_free(void) {
-    if (g_plants) { SDL_free(g_plants); g_plants = NULL; }
+    for (int i = 0; i < g_blockCount; ++i) SDL_free(g_blocks[i]);
+    for (int i = 0; i < s_poolChunks; ++i) SDL_free(s_pool[i].blob);
+    SDL_memset(s_pool, 0, sizeof(s_pool));
+    s_poolChunks = 0;
+    SDL_free(g_blocks);
+    SDL_free(s_seen);
+    g_blocks = NULL;
+    s_seen = NULL;
+    g_blockCount = 0;
     g_count = 0;
+    s_path[0] = '\0';
+    s_mtime = 0;
+    s_size = -1;
+    s_contentHash = 0;
+    // 인터닝 표는 남겨 둠 (핸들 유지). 인덱스 표만 비움
+    for (int i = 0; i < s_handleIndexCap; ++i) s_handleIndex[i] = -1;
 }
 
 int plantdb_count(void) { return g_count; }
 const PlantInfo* plantdb_get(int idx) {
     if (idx < 0 || idx >= g_count) return NULL;
-    return &g_plants[idx];
+    return &g_blocks[idx >> PLANTDB_BLOCK_SHIFT][idx & (PLANTDB_BLOCK_SIZE - 1)];
 }
 
-int plantdb_load(const char* json_path) {
-    plantdb_free();
-
-    JSON_Value* root = json_parse_file(json_path);
-    if (!root) { SDL_Log("plantdb: JSON open fail: %s", json_path); return -1; }
-
-    JSON_Array* arr = json_value_get_array(root);
-    if (!arr) { SDL_Log("plantdb: not array root"); json_value_free(root); return -1; }
-
-    g_count = (int)json_array_get_count(arr);
-    if (g_count <= 0) { json_value_free(root); return 0; }
-
-    g_plants = (PlantInfo*)SDL_calloc(g_count, sizeof(PlantInfo));
-    if (!g_plants) { json_value_free(root); return -1; }
-
-    for (int i = 0;i < g_count;i++) {
-        JSON_Object* o = json_array_get_object(arr, i);
-        const char* id = json_object_get_string(o, "id");
-        const char* namek = json_object_get_string(o, "name_kr");
-        const char* latin = json_object_get_string(o, "latin");
-        const char* icon = json_object_get_string(o, "icon");
-        int light = (int)json_object_get_number(o, "light_level");
-        int water = (int)json_object_get_number(o, "water_days");
-        int tmin = (int)json_object_get_number(o, "min_temp");
-        int tmax = (int)json_object_get_number(o, "max_temp");
-
-        PlantInfo* p = &g_plants[i];
-        SDL_strlcpy(p->id, id ? id : "", sizeof(p->id));
-        SDL_strlcpy(p->name_kr, namek ? namek : "", sizeof(p->name_kr));
-        SDL_strlcpy(p->latin, latin ? latin : "", sizeof(p->latin));
-        SDL_strlcpy(p->icon_path, icon ? icon : "", sizeof(p->icon_path));
-        p->light_level = light;
-        p->water_days = water;
-        p->min_temp = tmin;
-        p->max_temp = tmax;
+Uint32 plantdb_generation(void) { return s_generation; }
+
+static int handle_index_reserve(int n) {
+    if (n <= s_handleIndexCap) return 1;
+    int cap = s_handleIndexCap ? s_handleIndexCap : 64;
+    while (cap < n) cap *= 2;
+    int* p = (int*)SDL_realloc(s_handleIndex, sizeof(int) * cap);
+    if (!p) return 0;
+    for (int i = s_handleIndexCap; i < cap; ++i) p[i] = -1;
+    s_handleIndex = p;
+    s_handleIndexCap = cap;
+    return 1;
+}
+
+// 새 인덱스 하나 (필요하면 블록 추가). 기존 항목은 절대 옮기지 않음
+static PlantInfo* alloc_slot(int* outIdx) {
+    int idx = g_count;
+    int b = idx >> PLANTDB_BLOCK_SHIFT;
+    if (b >= g_blockCount) {
+        PlantInfo** bl = (PlantInfo**)SDL_realloc(g_blocks, sizeof(*g_blocks) * (b + 1));
+        if (!bl) return NULL;
+        g_blocks = bl;
+        int* seen = (int*)SDL_realloc(s_seen, sizeof(int) * (b + 1) * PLANTDB_BLOCK_SIZE);
+        if (!seen) return NULL;
+        s_seen = seen;
+        g_blocks[b] = (PlantInfo*)SDL_calloc(PLANTDB_BLOCK_SIZE, sizeof(PlantInfo));
+        if (!g_blocks[b]) return NULL;
+        g_blockCount = b + 1;
+    }
+    s_seen[idx] = 0;
+    g_count++;
+    *outIdx = idx;
+    return &g_blocks[b][idx & (PLANTDB_BLOCK_SIZE - 1)];
+}
+
+// 카탈로그 바이너리를 합침 (blob 소유권을 가져감): 있던 id 는 같은 인덱스에 덮어쓰고 새 id 는 뒤에 붙임
+static int merge_blob(Uint8* blob) {
+    if (s_poolChunks >= PLANTDB_POOL_MAX) {
+        SDL_Log("plantdb: too many reloads, restart to pick up %s", s_path);
+        SDL_free(blob);
+        return -1;
     }
+    const PlantBlobHeader* bh = (const PlantBlobHeader*)blob;
+    const PlantBlobRecord* recs = plantblob_records(blob);
+    int chunk = s_poolChunks++;
+    s_pool[chunk].blob = blob;
+    s_pool[chunk].strings = plantblob_str(blob, 0);
+    s_pool[chunk].size = bh->strings_size;
+
+    int stamp = (int)s_generation + 1;
+    int added = 0, present = 0, used = 0;
+
+    for (Uint32 i = 0; i < bh->count; i++) {
+        const PlantBlobRecord* r = &recs[i];
+        PlantId h = plantdb_intern(plantblob_str(blob, r->id));
+        if (h == PLANT_ID_NONE || !handle_index_reserve(h)) break;
 
-    json_value_free(root);
-    SDL_Log("plantdb: loaded %d plants", g_count);
+        int idx = s_handleIndex[h - 1];
+        PlantInfo* p;
+        if (idx < 0) {
+            p = alloc_slot(&idx);
+            if (!p) break;
+            s_handleIndex[h - 1] = idx;
+            added++;
+        } else {
+            p = &g_blocks[idx >> PLANTDB_BLOCK_SHIFT][idx & (PLANTDB_BLOCK_SIZE - 1)];
+        }
+        s_seen[idx] = stamp;
+        present++;
+
+        p->handle = h;
+        p->name_off = pool_pick(p->name_off, chunk, r->name_kr, &used);
+        p->latin_off = pool_pick(p->latin_off, chunk, r->latin, &used);
+        p->icon_off = pool_pick(p->icon_off, chunk, r->icon, &used);
+        p->light_level = r->light_level;
+        p->water_days = r->water_days;
+        p->min_temp = r->min_temp;
+        p->max_temp = r->max_temp;
+        p->moisture_opt = r->moisture_opt;
+        p->temp_min = r->temp_min;
+        p->temp_max = r->temp_max;
+        p->humidity_min = r->humidity_min;
+        p->humidity_max = r->humidity_max;
+    }
+
+    // 글자가 하나도 안 바뀌었으면 이번 조각은 필요 없음
+    if (!used) {
+        SDL_free(s_pool[chunk].blob);
+        SDL_memset(&s_pool[chunk], 0, sizeof(s_pool[chunk]));
+        s_poolChunks--;
+    }
+
+    // 파일에서 빠진 id 는 인덱스를 지키려고 마지막 값 그대로 둠 (다음 실행 때 사라짐)
+    int missing = 0;
+    for (int i = 0; i < g_count; ++i) if (s_seen[i] != stamp) missing++;
+    if (missing > 0)
+        SDL_Log("plantdb: %d plant(s) no longer in %s, kept until restart", missing, s_path);
+
+    s_generation = (Uint32)stamp;
+    SDL_Log("plantdb: loaded %d plants (%d new, generation %u)", present, added, s_generation);
     return g_count;
 }
 
-int plantdb_find_index_by_id(const char* id) {
-    if (!id || !*id) return -1; // 빈 문자열 방어
-    int n = plantdb_count();    // 전체 식물 개수
-    for (int i = 0; i < n; ++i) {
-        const PlantInfo* p = plantdb_get(i);
-        if (p && SDL_strcmp(p->id, id) == 0) {
-            return i; // ✅ 일치하는 인덱스 반환
+// plants.bin 이 plants.json 과 맞으면 그대로, 아니면 JSON 을 다시 컴파일해 돌려줌 (SDL_free)
+static Uint8* load_catalog_blob(const char* json_path, int statOk, Sint64 mtime, Sint64 size) {
+    char bin[512];
+    plantblob_path_for(json_path, bin, sizeof(bin));
+
+    Uint32 blobSize = 0;
+    Uint8* blob = plantblob_read(bin, &blobSize);
+    PlantBlobHeader* bh = (PlantBlobHeader*)blob;
+    if (bh && statOk && bh->src_mtime == mtime && bh->src_size == size)
+        return blob;                    // JSON 을 열지도 않음
+
+    Uint32 hash = 0;
+    char* text = statOk ? plantblob_read_text(json_path, &hash) : NULL;
+    if (!text) {
+        if (bh) {
+            SDL_Log("plantdb: %s missing, using %s", json_path, bin);
+            return blob;
         }
+        SDL_Log("plantdb: JSON open fail: %s", json_path);
+        return NULL;
+    }
+
+    if (bh && bh->src_hash == hash && bh->src_size == size) {
+        // 시각만 바뀜 (체크아웃/다시 저장) → 헤더만 고쳐서 다음 실행부터는 바로 쓰게
+        bh->src_mtime = mtime;
+        plantblob_write(bin, blob, blobSize);
+        SDL_free(text);
+        return blob;
+    }
+
+    SDL_free(blob);
+    blob = plantblob_compile(text, hash, mtime, size, &blobSize);
+    SDL_free(text);
+    if (!blob) return NULL;
+    if (!plantblob_write(bin, blob, blobSize))
+        SDL_Log("plantdb: could not write %s (catalog compiled in memory only)", bin);
+    else
+        SDL_Log("plantdb: compiled %s", bin);
+    return blob;
+}
+
+int plantdb_load(const char* json_path) {
+    if (!json_path) return -1;
+
+    // 같은 파일을 이미 읽었고 그대로면 아무것도 안 함
+    Sint64 mtime = 0, size = -1;
+    int statOk = plantblob_stat(json_path, &mtime, &size);
+    if (s_path[0] && SDL_strcmp(s_path, json_path) == 0 && statOk &&
+        mtime == s_mtime && size == s_size)
+        return g_count;
+
+    // 다른 파일로 바꾸면 처음부터
+    if (s_path[0] && SDL_strcmp(s_path, json_path) != 0) plantdb_free();
+
+    Uint8* blob = load_catalog_blob(json_path, statOk, mtime, size);
+    if (!blob) {
+        // 저장 중간의 깨진 JSON 이면 지금 카탈로그를 유지하고, 다음에 바뀔 때 다시 시도
+        if (SDL_strcmp(s_path, json_path) == 0) { s_mtime = mtime; s_size = size; }
+        return -1;
     }
-    return -1; // 찾지 못함
+
+    SDL_strlcpy(s_path, json_path, sizeof(s_path));
+    s_mtime = mtime;
+    s_size = size;
+    s_lastPoll = SDL_GetTicks();
+
+    // 시각만 바뀌고 내용이 같으면 (저장만 다시 한 경우) 합치지 않음
+    Uint32 hash = ((const PlantBlobHeader*)blob)->src_hash;
+    if (s_generation != 0 && g_count > 0 && hash == s_contentHash) {
+        SDL_free(blob);
+        return g_count;
+    }
+
+    int r = merge_blob(blob);
+    if (r >= 0) s_contentHash = hash;
+    return r;
 }
 
+int plantdb_reload_if_changed(void) {
+    if (!s_path[0]) return 0;
+    Uint32 now = SDL_GetTicks();
+    if (now - s_lastPoll < PLANTDB_POLL_MS) return 0;
+    s_lastPoll = now;
+
+    Sint64 mtime = 0, size = -1;
+    if (!plantblob_stat(s_path, &mtime, &size)) return 0;   // 저장 도중이면 다음에
+    if (mtime == s_mtime && size == s_size) return 0;
+
+    char path[512];
+    SDL_strlcpy(path, s_path, sizeof(path));
+    Uint32 before = s_generation;
+    if (plantdb_load(path) < 0) return 0;   // 깨진 JSON 이면 지금 카탈로그 유지
+    return s_generation != before;
+}
+
+int plantdb_find_index(PlantId h) {
+    if (h <= 0 || h > s_nameCount || h > s_handleIndexCap) return -1;
+    return s_handleIndex[h - 1];
+}
+
+int plantdb_find_index_by_id(const char* id) {
+    if (!id || !*id) return -1; // 빈 문자열 방어
+    return plantdb_find_index(plantdb_lookup_id(id));  // 해시 한 번 + 표 조회
+}
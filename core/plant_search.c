@@ -0,0 +1,471 @@
+#include "../include/plant_search.h"
+#include "../include/core.h"
+#include <stdlib.h>
+
+enum { SF_NAME, SF_CHO, SF_LATIN, SF_ID, SF_COUNT };
+
+typedef struct SearchEntry {
+    Uint32 off[SF_COUNT];       // s_units 오프셋
+    Uint16 len[SF_COUNT];
+} SearchEntry;
+
+typedef struct PrefixKey {
+    Uint32 off;
+    Uint16 len;
+    Uint16 field;
+    int    entry;
+} PrefixKey;
+
+typedef struct GramSlot {
+    Uint32 gram;                // (앞 << 16) | 뒤, 0 = 빈 칸
+    Uint32 start, count;        // s_post 범위
+    int    last;                // 만들 때 마지막으로 넣은 식물 (중복 제거)
+} GramSlot;
+
+// 질의 결과 단계: s_levels[i] 는 질의 앞 len 유닛의 결과 (len 이 늘어나는 순)
+typedef struct SearchLevel {
+    int     len;
+    int*    match;
+    Uint32* score;
+    int     count, cap;
+} SearchLevel;
+
+static Uint16*      s_units = NULL;
+static Uint32       s_unitCount = 0, s_unitCap = 0;
+static SearchEntry* s_entries = NULL;
+static int          s_entryCount = 0;
+static PrefixKey*   s_prefix = NULL;
+static int          s_prefixCount = 0;
+static GramSlot*    s_grams = NULL;
+static Uint32       s_gramCap = 0;      // 2의 거듭제곱
+static int*         s_post = NULL;
+static int*         s_mark = NULL;      // 한 글자 질의 중복 제거용
+static int          s_markGen = 0;
+static Uint32       s_builtGen = 0;
+static int          s_built = 0;
+
+static SearchLevel  s_levels[PLANT_SEARCH_QUERY_MAX + 1];
+static int          s_depth = 0;
+static Uint16       s_q[PLANT_SEARCH_QUERY_MAX];
+static int          s_qn = 0;
+static int          s_lastTotal = 0;
+
+// ---------- 자모 분해 ----------
+static const Uint16 k_cho[19] = {
+    0x3131, 0x3132, 0x3134, 0x3137, 0x3138, 0x3139, 0x3141, 0x3142, 0x3143, 0x3145,
+    0x3146, 0x3147, 0x3148, 0x3149, 0x314A, 0x314B, 0x314C, 0x314D, 0x314E
+};
+static const Uint16 k_jong[28] = {
+    0, 0x3131, 0x3132, 0x3133, 0x3134, 0x3135, 0x3136, 0x3137, 0x3139, 0x313A,
+    0x313B, 0x313C, 0x313D, 0x313E, 0x313F, 0x3140, 0x3141, 0x3142, 0x3144, 0x3145,
+    0x3146, 0x3147, 0x3148, 0x314A, 0x314B, 0x314C, 0x314D, 0x314E
+};
+
+// 겹받침/겹모음은 두 자모로 (입력 도중 모양과 맞추기 위해)
+static int jamo_split(Uint16 c, Uint16 out[2])
+{
+    switch (c) {
+    case 0x3133: out[0] = 0x3131; out[1] = 0x3145; return 2;   // ㄳ
+    case 0x3135: out[0] = 0x3134; out[1] = 0x3148; return 2;   // ㄵ
+    case 0x3136: out[0] = 0x3134; out[1] = 0x314E; return 2;   // ㄶ
+    case 0x313A: out[0] = 0x3139; out[1] = 0x3131; return 2;   // ㄺ
+    case 0x313B: out[0] = 0x3139; out[1] = 0x3141; return 2;   // ㄻ
+    case 0x313C: out[0] = 0x3139; out[1] = 0x3142; return 2;   // ㄼ
+    case 0x313D: out[0] = 0x3139; out[1] = 0x3145; return 2;   // ㄽ
+    case 0x313E: out[0] = 0x3139; out[1] = 0x314C; return 2;   // ㄾ
+    case 0x313F: out[0] = 0x3139; out[1] = 0x314D; return 2;   // ㄿ
+    case 0x3140: out[0] = 0x3139; out[1] = 0x314E; return 2;   // ㅀ
+    case 0x3144: out[0] = 0x3142; out[1] = 0x3145; return 2;   // ㅄ
+    case 0x3158: out[0] = 0x3157; out[1] = 0x314F; return 2;   // ㅘ
+    case 0x3159: out[0] = 0x3157; out[1] = 0x3150; return 2;   // ㅙ
+    case 0x315A: out[0] = 0x3157; out[1] = 0x3163; return 2;   // ㅚ
+    case 0x315D: out[0] = 0x315C; out[1] = 0x3153; return 2;   // ㅝ
+    case 0x315E: out[0] = 0x315C; out[1] = 0x3154; return 2;   // ㅞ
+    case 0x315F: out[0] = 0x315C; out[1] = 0x3163; return 2;   // ㅟ
+    case 0x3162: out[0] = 0x3161; out[1] = 0x3163; return 2;   // ㅢ
+    default: out[0] = c; return 1;
+    }
+}
+
+static int is_consonant(Uint16 c) { return c >= 0x3131 && c <= 0x314E; }
+
+static const char* utf8_next(const char* s, Uint32* cp)
+{
+    const Uint8* p = (const Uint8*)s;
+    if (p[0] < 0x80) { *cp = p[0]; return s + 1; }
+    int n = (p[0] >= 0xF0) ? 3 : (p[0] >= 0xE0) ? 2 : (p[0] >= 0xC0) ? 1 : 0;
+    Uint32 c = p[0] & (0x3F >> n);
+    for (int i = 1; i <= n; i++) {
+        if ((p[i] & 0xC0) != 0x80) { *cp = 0xFFFD; return s + i; }
+        c = (c << 6) | (p[i] & 0x3F);
+    }
+    *cp = n ? c : 0xFFFD;
+    return s + 1 + n;
+}
+
+// UTF-8 → 비교용 유닛 (자모 분해, 소문자, 공백/_/- 제거). cho 가 있으면 초성열도 같이
+static int normalize(const char* s, Uint16* out, int max, Uint16* cho, int* choLen, int choMax)
+{
+    int n = 0, cn = 0;
+    Uint16 tmp[2];
+#define PUSH(c) do { if (n < max) out[n++] = (Uint16)(c); } while (0)
+#define PUSH_SPLIT(c) do { int k_ = jamo_split((Uint16)(c), tmp); for (int j_ = 0; j_ < k_; j_++) PUSH(tmp[j_]); } while (0)
+#define PUSH_CHO(c) do { if (cho && cn < choMax) cho[cn++] = (Uint16)(c); } while (0)
+    while (s && *s) {
+        Uint32 c;
+        s = utf8_next(s, &c);
+        if (c <= 0x20 || c == '_' || c == '-') continue;
+        if (c >= 'A' && c <= 'Z') c += 'a' - 'A';
+
+        if (c >= 0xAC00 && c <= 0xD7A3) {
+            Uint32 si = c - 0xAC00;
+            Uint16 l = k_cho[si / 588];
+            PUSH(l);
+            PUSH_SPLIT(0x314F + (si % 588) / 28);
+            if (si % 28) PUSH_SPLIT(k_jong[si % 28]);
+            PUSH_CHO(l);
+        } else if (c >= 0x3131 && c <= 0x3163) {
+            PUSH_SPLIT(c);
+            PUSH_CHO(c);
+        } else {
+            if (c > 0xFFFF) c = 0xFFFD;
+            PUSH(c);
+            PUSH_CHO(c);
+        }
+    }
+#undef PUSH
+#undef PUSH_SPLIT
+#undef PUSH_CHO
+    if (choLen) *choLen = cn;
+    return n;
+}
+
+// ---------- 색인 ----------
+static Uint32 add_units(const Uint16* u, int n)
+{
+    if (n <= 0) return s_unitCount;
+    if (s_unitCount + (Uint32)n > s_unitCap) {
+        Uint32 cap = s_unitCap ? s_unitCap : 4096;
+        while (cap < s_unitCount + (Uint32)n) cap *= 2;
+        Uint16* p = (Uint16*)SDL_realloc(s_units, sizeof(Uint16) * cap);
+        if (!p) return 0;
+        s_units = p;
+        s_unitCap = cap;
+    }
+    Uint32 off = s_unitCount;
+    SDL_memcpy(s_units + off, u, sizeof(Uint16) * n);
+    s_unitCount += (Uint32)n;
+    return off;
+}
+
+static int cmp_units(const Uint16* a, int an, const Uint16* b, int bn)
+{
+    int n = an < bn ? an : bn;
+    for (int i = 0; i < n; i++)
+        if (a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+    return an - bn;
+}
+
+static int cmp_prefix(const void* a, const void* b)
+{
+    const PrefixKey* x = (const PrefixKey*)a;
+    const PrefixKey* y = (const PrefixKey*)b;
+    int c = cmp_units(s_units + x->off, x->len, s_units + y->off, y->len);
+    return c ? c : x->entry - y->entry;
+}
+
+static Uint32 gram_hash(Uint32 g)
+{
+    g ^= g >> 16; g *= 0x7feb352du; g ^= g >> 15; g *= 0x846ca68bu; g ^= g >> 16;
+    return g;
+}
+
+static const GramSlot* gram_find(Uint32 gram)
+{
+    if (s_gramCap == 0) return NULL;
+    Uint32 mask = s_gramCap - 1;
+    for (Uint32 i = gram_hash(gram) & mask;; i = (i + 1) & mask) {
+        if (s_grams[i].gram == gram) return &s_grams[i];
+        if (s_grams[i].gram == 0) return NULL;
+    }
+}
+
+// 만들 때만: 찾거나 새로 넣음 (부하율 1/2 넘으면 두 배로)
+static GramSlot* gram_insert(Uint32 gram, Uint32* distinct)
+{
+    if ((*distinct + 1) * 2 > s_gramCap) {
+        Uint32 cap = s_gramCap ? s_gramCap * 2 : 1024;
+        GramSlot* g = (GramSlot*)SDL_calloc(cap, sizeof(GramSlot));
+        if (!g) return NULL;
+        for (Uint32 k = 0; k < s_gramCap; k++) {
+            if (s_grams[k].gram == 0) continue;
+            Uint32 h = gram_hash(s_grams[k].gram) & (cap - 1);
+            while (g[h].gram != 0) h = (h + 1) & (cap - 1);
+            g[h] = s_grams[k];
+        }
+        SDL_free(s_grams);
+        s_grams = g;
+        s_gramCap = cap;
+    }
+    Uint32 mask = s_gramCap - 1;
+    Uint32 h = gram_hash(gram) & mask;
+    while (s_grams[h].gram != 0 && s_grams[h].gram != gram) h = (h + 1) & mask;
+    if (s_grams[h].gram == 0) {
+        s_grams[h].gram = gram;
+        s_grams[h].last = -1;
+        (*distinct)++;
+    }
+    return &s_grams[h];
+}
+
+static void levels_reset(void)
+{
+    for (int i = 0; i < s_depth; i++) s_levels[i].count = 0;
+    s_depth = 0;
+    s_qn = 0;
+    s_lastTotal = 0;
+}
+
+void plant_search_free(void)
+{
+    SDL_free(s_units); s_units = NULL; s_unitCount = s_unitCap = 0;
+    SDL_free(s_entries); s_entries = NULL; s_entryCount = 0;
+    SDL_free(s_prefix); s_prefix = NULL; s_prefixCount = 0;
+    SDL_free(s_grams); s_grams = NULL; s_gramCap = 0;
+    SDL_free(s_post); s_post = NULL;
+    SDL_free(s_mark); s_mark = NULL; s_markGen = 0;
+    levels_reset();
+    for (int i = 0; i <= PLANT_SEARCH_QUERY_MAX; i++) {
+        SDL_free(s_levels[i].match);
+        SDL_free(s_levels[i].score);
+        SDL_memset(&s_levels[i], 0, sizeof(s_levels[i]));
+    }
+    s_built = 0;
+}
+
+void plant_search_rebuild(void)
+{
+    Uint64 t0 = SDL_GetPerformanceCounter();
+    plant_search_free();
+    s_builtGen = plantdb_generation();
+    s_built = 1;
+
+    int n = plantdb_count();
+    if (n <= 0) return;
+    s_entries = (SearchEntry*)SDL_calloc(n, sizeof(SearchEntry));
+    s_mark = (int*)SDL_calloc(n, sizeof(int));
+    s_prefix = (PrefixKey*)SDL_malloc(sizeof(PrefixKey) * n * SF_COUNT);
+    if (!s_entries || !s_mark || !s_prefix) { plant_search_free(); s_built = 1; return; }
+    s_entryCount = n;
+
+    // 1) 키 만들기
+    Uint16 buf[256], cho[128];
+    for (int i = 0; i < n; i++) {
+        const PlantInfo* p = plantdb_get(i);
+        SearchEntry* e = &s_entries[i];
+        int choLen = 0;
+        int len = normalize(plantdb_name(p), buf, 256, cho, &choLen, 128);
+        e->off[SF_NAME] = add_units(buf, len); e->len[SF_NAME] = (Uint16)len;
+        e->off[SF_CHO] = add_units(cho, choLen); e->len[SF_CHO] = (Uint16)choLen;
+        len = normalize(plantdb_latin(p), buf, 256, NULL, NULL, 0);
+        e->off[SF_LATIN] = add_units(buf, len); e->len[SF_LATIN] = (Uint16)len;
+        len = normalize(plantdb_id(p), buf, 256, NULL, NULL, 0);
+        e->off[SF_ID] = add_units(buf, len); e->len[SF_ID] = (Uint16)len;
+
+        for (int f = 0; f < SF_COUNT; f++) {
+            if (e->len[f] == 0) continue;
+            PrefixKey* k = &s_prefix[s_prefixCount++];
+            k->off = e->off[f];
+            k->len = e->len[f];
+            k->field = (Uint16)f;
+            k->entry = i;
+        }
+    }
+    if (!s_units) { plant_search_free(); s_built = 1; return; }
+
+    // 2) 접두 배열
+    qsort(s_prefix, s_prefixCount, sizeof(PrefixKey), cmp_prefix);
+
+    // 3) 2-gram → 식물 목록: 한 번 세고, 자리 잡고, 한 번 더 돌며 채움 (식물 순으로 들어가 정렬 불필요)
+    Uint32 distinct = 0, posts = 0;
+    for (int pass = 0; pass < 2; pass++) {
+        for (int i = 0; i < n; i++) {
+            const SearchEntry* e = &s_entries[i];
+            for (int f = 0; f < SF_COUNT; f++) {
+                const Uint16* u = s_units + e->off[f];
+                for (int j = 0; j + 1 < e->len[f]; j++) {
+                    GramSlot* g = gram_insert(((Uint32)u[j] << 16) | u[j + 1], &distinct);
+                    if (!g) { plant_search_free(); s_built = 1; return; }
+                    if (g->last == i) continue;     // 같은 식물 안 중복
+                    g->last = i;
+                    if (pass == 1) s_post[g->start + g->count] = i;
+                    g->count++;
+                }
+            }
+        }
+        if (pass == 0) {
+            for (Uint32 k = 0; k < s_gramCap; k++) {
+                if (s_grams[k].gram == 0) continue;
+                s_grams[k].start = posts;
+                posts += s_grams[k].count;
+                s_grams[k].count = 0;
+                s_grams[k].last = -1;
+            }
+            s_post = (int*)SDL_malloc(sizeof(int) * (posts ? posts : 1));
+            if (!s_post) { plant_search_free(); s_built = 1; return; }
+        }
+    }
+
+    double ms = (double)(SDL_GetPerformanceCounter() - t0) * 1000.0 / (double)SDL_GetPerformanceFrequency();
+    SDL_Log("[SEARCH] index: %d plants, %d keys, %u grams, %u postings (%.1f ms)",
+        n, s_prefixCount, distinct, posts, ms);
+}
+
+// ---------- 질의 ----------
+static int find_units(const Uint16* key, int kn, const Uint16* q, int qn)
+{
+    for (int i = 0; i + qn <= kn; i++) {
+        if (key[i] != q[0]) continue;
+        int j = 1;
+        while (j < qn && key[i + j] == q[j]) j++;
+        if (j == qn) return i;
+    }
+    return -1;
+}
+
+// 낮을수록 앞. 안 걸리면 UINT32_MAX
+// 순서: 이름 접두 < 초성 접두 < 이름 중간 < 초성 중간 < 학명 접두 < id 접두 < 학명 중간 < id 중간
+static Uint32 entry_score(int e, const Uint16* q, int qn, int choOnly)
+{
+    static const Uint8 prefixRank[SF_COUNT] = { 0, 1, 4, 5 };
+    static const Uint8 innerRank[SF_COUNT] = { 2, 3, 6, 7 };
+    const SearchEntry* se = &s_entries[e];
+    Uint32 best = 0xFFFFFFFFu;
+    for (int f = 0; f < SF_COUNT; f++) {
+        if (f == SF_CHO && !choOnly) continue;
+        int pos = find_units(s_units + se->off[f], se->len[f], q, qn);
+        if (pos < 0) continue;
+        Uint32 rank = pos == 0 ? prefixRank[f] : innerRank[f];
+        Uint32 s = (rank << 24) | ((Uint32)(pos < 255 ? pos : 255) << 16) | se->len[f];
+        if (s < best) best = s;
+    }
+    return best;
+}
+
+static int level_push(SearchLevel* lv, int e, Uint32 score)
+{
+    if (lv->count == lv->cap) {
+        int cap = lv->cap ? lv->cap * 2 : 256;
+        int* m = (int*)SDL_realloc(lv->match, sizeof(int) * cap);
+        if (!m) return 0;
+        lv->match = m;
+        Uint32* s = (Uint32*)SDL_realloc(lv->score, sizeof(Uint32) * cap);
+        if (!s) return 0;
+        lv->score = s;
+        lv->cap = cap;
+    }
+    lv->match[lv->count] = e;
+    lv->score[lv->count] = score;
+    lv->count++;
+    return 1;
+}
+
+static void full_query(SearchLevel* lv, const Uint16* q, int qn, int choOnly)
+{
+    if (qn == 1) {
+        // 한 글자: 접두 배열에서 그 글자로 시작하는 키 범위
+        int lo = 0, hi = s_prefixCount;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (s_units[s_prefix[mid].off] < q[0]) lo = mid + 1;
+            else hi = mid;
+        }
+        if (++s_markGen == 0x7FFFFFFF) { SDL_memset(s_mark, 0, sizeof(int) * s_entryCount); s_markGen = 1; }
+        for (int i = lo; i < s_prefixCount && s_units[s_prefix[i].off] == q[0]; i++) {
+            int e = s_prefix[i].entry;
+            if (s_mark[e] == s_markGen) continue;
+            if (s_prefix[i].field == SF_CHO && !choOnly) continue;
+            s_mark[e] = s_markGen;
+            if (!level_push(lv, e, entry_score(e, q, qn, choOnly))) return;
+        }
+        return;
+    }
+
+    // 두 글자 이상: 가장 짧은 2-gram 목록만 확인
+    const GramSlot* best = NULL;
+    for (int i = 0; i + 1 < qn; i++) {
+        const GramSlot* g = gram_find(((Uint32)q[i] << 16) | q[i + 1]);
+        if (!g) return;                 // 어느 식물에도 없는 2-gram
+        if (!best || g->count < best->count) best = g;
+    }
+    for (Uint32 i = 0; i < best->count; i++) {
+        int e = s_post[best->start + i];
+        Uint32 s = entry_score(e, q, qn, choOnly);
+        if (s != 0xFFFFFFFFu && !level_push(lv, e, s)) return;
+    }
+}
+
+void plant_search_prepare(void)
+{
+    if (!s_built || s_builtGen != plantdb_generation()) plant_search_rebuild();
+}
+
+int plant_search_query(const char* utf8, int* out, int max)
+{
+    if (!out || max <= 0) return 0;
+    plant_search_prepare();
+
+    Uint16 q[PLANT_SEARCH_QUERY_MAX];
+    int qn = normalize(utf8, q, PLANT_SEARCH_QUERY_MAX, NULL, NULL, 0);
+    if (qn == 0 || s_entryCount == 0) { levels_reset(); return 0; }
+
+    int choOnly = 1;
+    for (int i = 0; i < qn; i++) if (!is_consonant(q[i])) { choOnly = 0; break; }
+
+    // 앞 질의와 겹치는 만큼의 단계만 남김 (지우기 = 쌓인 단계로 되돌아감)
+    int common = 0;
+    while (common < qn && common < s_qn && q[common] == s_q[common]) common++;
+    while (s_depth > 0 && s_levels[s_depth - 1].len > common) s_levels[--s_depth].count = 0;
+    SDL_memcpy(s_q, q, sizeof(Uint16) * qn);
+    s_qn = qn;
+
+    SearchLevel* top = s_depth > 0 ? &s_levels[s_depth - 1] : NULL;
+    if (!top || top->len != qn) {
+        SearchLevel* lv = &s_levels[s_depth];
+        lv->len = qn;
+        lv->count = 0;
+        if (top && top->len >= 2) {
+            // 앞 질의를 늘린 것 → 앞 결과만 다시 확인
+            for (int i = 0; i < top->count; i++) {
+                Uint32 s = entry_score(top->match[i], q, qn, choOnly);
+                if (s != 0xFFFFFFFFu && !level_push(lv, top->match[i], s)) break;
+            }
+        } else {
+            full_query(lv, q, qn, choOnly);
+        }
+        s_depth++;
+        top = lv;
+    }
+    s_lastTotal = top->count;
+
+    // 상위 max 개 (점수, 카탈로그 순) 삽입 정렬. 꼴찌보다 못하면 바로 건너뜀
+    Uint32 outScore[256];
+    if (max > 256) max = 256;
+    int n = 0;
+    for (int i = 0; i < top->count; i++) {
+        int e = top->match[i];
+        Uint32 sc = top->score[i];
+        if (n == max && (sc > outScore[n - 1] || (sc == outScore[n - 1] && e > out[n - 1]))) continue;
+        int pos = n < max ? n++ : n - 1;
+        while (pos > 0 && (outScore[pos - 1] > sc || (outScore[pos - 1] == sc && out[pos - 1] > e))) {
+            out[pos] = out[pos - 1];
+            outScore[pos] = outScore[pos - 1];
+            pos--;
+        }
+        out[pos] = e;
+        outScore[pos] = sc;
+    }
+    return n;
+}
+
+int plant_search_match_count(void) { return s_lastTotal; }
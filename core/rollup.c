@@ -0,0 +1,623 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include "../include/rollup.h"
+#include "../include/save.h"
+#include "../include/common.h"
+#include "../include/core.h"
+#include "../include/utils.h"
+#include <stdio.h>
+#include <string.h>
+
+#define ROLLUP_CACHE_MAX  32
+#define ROLLUP_REBUILD_CHUNK 256    // 다시 만들 때 락을 잡고 한 번에 읽는 기록 수
+#define ROLLUP_MAGIC      "GRRU"
+
+// logs/<id>.agg 헤더. 뒤에 RollupBucket count 개 (일/주 섞여 있음, 순서 무관).
+// 로컬 캐시라 바이트 순서는 네이티브. 헤더는 칸을 다 쓴 뒤 마지막에 갱신
+typedef struct RollupFileHeader {
+    char   magic[4];
+    Uint32 version;
+    Sint32 records;             // 반영한 저널 기록 수. 저널과 다르면 다시 만듦
+    Sint32 count;               // 칸 수
+    Sint32 window_open_since;   // 창문이 열린 시각 (1970 기준 분), 닫혀 있으면 -1
+    Uint32 reserved;
+} RollupFileHeader;
+
+typedef struct RollupCell {
+    RollupBucket b;
+    Sint32 file_index;  // .agg 안의 위치 (-1 = 아직 안 씀)
+    bool   dirty;
+} RollupCell;
+
+typedef struct RollupState {
+    bool   used;
+    char   id[32];
+    Uint32 last_use;
+    Sint32 records;
+    Sint32 window_open_since;
+    int    fileCount;
+    bool   dirty;       // 파일에 안 쓴 칸이 있음
+    bool   needsFull;   // 다시 만들었거나 쓰기 실패 → .agg 를 통째로 다시 씀
+    bool   rebuildWanted;   // 질의 때 저널과 안 맞음 → I/O 스레드가 rollup_rebuild_pending 에서 다시 만듦
+
+    RollupCell* cells[2];       // [RollupKind], key 오름차순
+    int         count[2], cap[2];
+} RollupState;
+
+static RollupState s_cache[ROLLUP_CACHE_MAX];
+static Uint32 s_useTick = 0;
+
+static bool get_agg_path(const char* plant_id, char* out, int outsz)
+{
+    char logs[1024];
+    if (!plant_id || !save_get_logs_dir(logs, sizeof(logs))) return false;
+    SDL_snprintf(out, outsz, "%s/%s.agg", logs, plant_id);
+    return true;
+}
+
+// ---------- 날짜 ----------
+// 그레고리력 날짜 → 1970-01-01 기준 일 수
+static int days_from_civil(int y, int m, int d)
+{
+    y -= m <= 2;
+    int era = (y >= 0 ? y : y - 399) / 400;
+    int yoe = y - era * 400;
+    int doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+bool rollup_day_from_ts(const char* ts, int* day, int* minute_of_day)
+{
+    int y, mo, d, h = 0, mi = 0;
+    if (!ts || SDL_sscanf(ts, "%d-%d-%d %d:%d", &y, &mo, &d, &h, &mi) < 3) return false;
+    if (mo < 1 || mo > 12 || d < 1 || d > 31 || h < 0 || h > 23 || mi < 0 || mi > 59) return false;
+    if (day) *day = days_from_civil(y, mo, d);
+    if (minute_of_day) *minute_of_day = h * 60 + mi;
+    return true;
+}
+
+int rollup_week_of_day(int day)
+{
+    // 1970-01-01 은 목요일 → +3 하면 월요일이 경계
+    int x = day + 3;
+    return x >= 0 ? x / 7 : -((-x + 6) / 7);
+}
+
+// ---------- 칸 ----------
+static void state_clear(RollupState* st)
+{
+    for (int k = 0; k < 2; k++) {
+        SDL_free(st->cells[k]);
+        st->cells[k] = NULL;
+        st->count[k] = st->cap[k] = 0;
+    }
+    st->records = 0;
+    st->window_open_since = -1;
+    st->fileCount = 0;
+    st->dirty = st->needsFull = st->rebuildWanted = false;
+}
+
+// key 위치 (없으면 들어갈 자리)
+static int cell_lower_bound(const RollupState* st, int kind, int key)
+{
+    int lo = 0, hi = st->count[kind];
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (st->cells[kind][mid].b.key < key) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+// 없으면 정렬 위치에 새로 끼움. 보통은 마지막 칸이거나 끝에 붙는 경우
+static RollupCell* cell_get(RollupState* st, int kind, int key)
+{
+    int i = cell_lower_bound(st, kind, key);
+    if (i < st->count[kind] && st->cells[kind][i].b.key == key) return &st->cells[kind][i];
+
+    if (st->count[kind] == st->cap[kind]) {
+        int cap = st->cap[kind] ? st->cap[kind] * 2 : 64;
+        RollupCell* p = (RollupCell*)SDL_realloc(st->cells[kind], sizeof(RollupCell) * cap);
+        if (!p) return NULL;
+        st->cells[kind] = p;
+        st->cap[kind] = cap;
+    }
+    RollupCell* c = &st->cells[kind][i];
+    SDL_memmove(c + 1, c, sizeof(RollupCell) * (st->count[kind] - i));
+    st->count[kind]++;
+
+    SDL_memset(c, 0, sizeof(*c));
+    c->b.key = key;
+    c->b.kind = kind;
+    c->file_index = -1;
+    return c;
+}
+
+static void stat_add(RollupStat* s, int v)
+{
+    if (s->count == 0 || v < s->min) s->min = v;
+    if (s->count == 0 || v > s->max) s->max = v;
+    s->count++;
+    s->sum += v;
+}
+
+static void stat_merge(RollupStat* a, const RollupStat* b)
+{
+    if (b->count == 0) return;
+    if (a->count == 0 || b->min < a->min) a->min = b->min;
+    if (a->count == 0 || b->max > a->max) a->max = b->max;
+    a->count += b->count;
+    a->sum += b->sum;
+}
+
+static void bucket_merge(RollupBucket* a, const RollupBucket* b)
+{
+    for (int i = 0; i < JOURNAL_EV_COUNT; i++) a->events[i] += b->events[i];
+    stat_merge(&a->water_ml, &b->water_ml);
+    stat_merge(&a->sun_min, &b->sun_min);
+    stat_merge(&a->sun_ppfd, &b->sun_ppfd);
+    a->window_open_min += b->window_open_min;
+}
+
+static void apply_fields(RollupBucket* b, const JSON_Object* e, JournalEventType t)
+{
+    b->events[t]++;
+    if (t == JOURNAL_EV_WATER) {
+        stat_add(&b->water_ml, (int)json_object_get_number(e, "amount_ml"));
+    }
+    else if (t == JOURNAL_EV_SUN) {
+        stat_add(&b->sun_min, (int)json_object_get_number(e, "minutes"));
+        stat_add(&b->sun_ppfd, (int)json_object_get_number(e, "ppfd"));
+    }
+}
+
+// 그 날/그 주 칸에 반영 (바뀐 칸은 dirty). e == NULL 이면 창문 시간만
+static void add_to_day_and_week(RollupState* st, int day, const JSON_Object* e, JournalEventType t, int window_min)
+{
+    int keys[2] = { day, rollup_week_of_day(day) };
+    for (int k = 0; k < 2; k++) {
+        RollupCell* c = cell_get(st, k, keys[k]);
+        if (!c) continue;
+        if (e) apply_fields(&c->b, e, t);
+        c->b.window_open_min += window_min;
+        c->dirty = true;
+        st->dirty = true;
+    }
+}
+
+// [from, to) 분 구간을 날짜별로 나눠서 창문 열린 시간에 더함
+static void add_window_span(RollupState* st, int from, int to)
+{
+    while (from < to) {
+        int day = from / 1440;
+        int end = (day + 1) * 1440;
+        if (end > to) end = to;
+        add_to_day_and_week(st, day, NULL, JOURNAL_EV_OTHER, end - from);
+        from = end;
+    }
+}
+
+static void apply_entry(RollupState* st, const JSON_Object* e)
+{
+    int day, mod;
+    st->records++;
+    if (!rollup_day_from_ts(json_object_get_string(e, "ts"), &day, &mod)) return;
+
+    JournalEventType t = journal_event_type(json_object_get_string(e, "event"));
+    add_to_day_and_week(st, day, e, t, 0);
+
+    if (t == JOURNAL_EV_WINDOW) {
+        int now = day * 1440 + mod;
+        if (json_object_get_boolean(e, "open") == 1) {
+            if (st->window_open_since < 0) st->window_open_since = now;
+        }
+        else if (st->window_open_since >= 0) {
+            add_window_span(st, st->window_open_since, now);
+            st->window_open_since = -1;
+        }
+    }
+}
+
+// ---------- 파일 ----------
+// 쓰기 작업: I/O 락 안에서 바뀐 칸을 복사해 두고, 락 밖에서 파일에 씀
+typedef struct RollupJob {
+    char   id[32];
+    bool   full;            // 통째로 다시 씀 (아니면 바뀐 칸만 제자리에)
+    Sint32 prevCount;       // 패치 전 파일 칸 수. 파일 헤더와 다르면 패치하지 않음
+    RollupFileHeader h;     // 마지막에 쓸 헤더
+    int    n;
+    RollupBucket* b;
+    Sint32*       at;       // b[i] 의 파일 안 위치
+} RollupJob;
+
+static bool write_header(FILE* fp, const RollupFileHeader* h)
+{
+    fseek(fp, 0, SEEK_SET);
+    return fwrite(h, sizeof(*h), 1, fp) == 1;
+}
+
+static bool job_collect(RollupState* st, RollupJob* j)
+{
+    int total = st->count[ROLLUP_DAY] + st->count[ROLLUP_WEEK];
+    SDL_memset(j, 0, sizeof(*j));
+    j->b = (RollupBucket*)SDL_malloc(sizeof(RollupBucket) * (size_t)(total + 1));
+    j->at = (Sint32*)SDL_malloc(sizeof(Sint32) * (size_t)(total + 1));
+    if (!j->b || !j->at) {
+        SDL_free(j->b);
+        SDL_free(j->at);
+        return false;
+    }
+    SDL_strlcpy(j->id, st->id, sizeof(j->id));
+    j->full = st->needsFull || st->fileCount == 0;   // 아직 파일이 없으면 패치할 것도 없음
+    j->prevCount = st->fileCount;
+    if (j->full) st->fileCount = 0;
+
+    for (int k = 0; k < 2; k++) {
+        for (int i = 0; i < st->count[k]; i++) {
+            RollupCell* c = &st->cells[k][i];
+            if (j->full) c->file_index = st->fileCount++;
+            else if (!c->dirty) continue;
+            else if (c->file_index < 0) c->file_index = st->fileCount++;
+            j->b[j->n] = c->b;
+            j->at[j->n] = c->file_index;
+            j->n++;
+            c->dirty = false;
+        }
+    }
+
+    SDL_memcpy(j->h.magic, ROLLUP_MAGIC, 4);
+    j->h.version = ROLLUP_VERSION;
+    j->h.records = st->records;
+    j->h.count = st->fileCount;
+    j->h.window_open_since = st->window_open_since;
+    st->dirty = st->needsFull = false;
+    return true;
+}
+
+// 락 밖에서 실행. 헤더는 칸을 다 쓴 뒤 마지막에
+static bool job_write(const RollupJob* j)
+{
+    char path[1024], tmp[1100];
+    if (!get_agg_path(j->id, path, sizeof(path))) return false;
+
+    if (!j->full) {
+        RollupFileHeader old;
+        FILE* fp = fopen(path, "r+b");
+        if (!fp) return false;
+        bool ok = fread(&old, sizeof(old), 1, fp) == 1 &&
+            SDL_memcmp(old.magic, ROLLUP_MAGIC, 4) == 0 &&
+            old.version == ROLLUP_VERSION &&
+            old.count == j->prevCount;
+        for (int i = 0; ok && i < j->n; i++) {
+            fseek(fp, (long)(sizeof(RollupFileHeader) + sizeof(RollupBucket) * (size_t)j->at[i]), SEEK_SET);
+            ok = fwrite(&j->b[i], sizeof(RollupBucket), 1, fp) == 1;
+        }
+        ok = ok && write_header(fp, &j->h);
+        return (fclose(fp) == 0) && ok;
+    }
+
+    // 통째로: 칸은 file_index 순서 그대로
+    SDL_snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    FILE* fp = fopen(tmp, "wb");
+    if (!fp) return false;
+    bool ok = write_header(fp, &j->h) &&
+        (j->n == 0 || fwrite(j->b, sizeof(RollupBucket), (size_t)j->n, fp) == (size_t)j->n);
+    ok = (fclose(fp) == 0) && ok;
+
+    if (!ok || !file_replace(tmp, path)) {
+        remove(tmp);
+        return false;
+    }
+    return true;
+}
+
+static bool state_load_file(RollupState* st)
+{
+    char path[1024];
+    RollupFileHeader h;
+    if (!get_agg_path(st->id, path, sizeof(path))) return false;
+
+    FILE* fp = fopen(path, "rb");
+    if (!fp) return false;
+    bool ok = fread(&h, sizeof(h), 1, fp) == 1 &&
+        SDL_memcmp(h.magic, ROLLUP_MAGIC, 4) == 0 &&
+        h.version == ROLLUP_VERSION &&
+        h.count >= 0;
+
+    for (Sint32 i = 0; ok && i < h.count; i++) {
+        RollupBucket b;
+        ok = fread(&b, sizeof(b), 1, fp) == 1 && (b.kind == ROLLUP_DAY || b.kind == ROLLUP_WEEK);
+        RollupCell* c = ok ? cell_get(st, b.kind, b.key) : NULL;
+        ok = c && c->file_index < 0;    // 같은 칸이 두 번 나오면 깨진 파일
+        if (ok) {
+            c->b = b;
+            c->file_index = i;
+        }
+    }
+    fclose(fp);
+
+    if (!ok) {
+        state_clear(st);
+        return false;
+    }
+    st->records = h.records;
+    st->window_open_since = h.window_open_since;
+    st->fileCount = h.count;
+    return true;
+}
+
+static bool rebuild_visit(const JSON_Object* e, void* user)
+{
+    apply_entry((RollupState*)user, e);
+    return true;
+}
+
+static void state_rebuild(RollupState* st)
+{
+    state_clear(st);
+    journal_read(st->id, rebuild_visit, st);
+    st->needsFull = true;   // 파일은 rollup_save 에서
+    SDL_Log("[ROLLUP] rebuilt: %s (%d records, %d days, %d weeks)",
+        st->id, st->records, st->count[ROLLUP_DAY], st->count[ROLLUP_WEEK]);
+}
+
+// ---------- 캐시 ----------
+// 파일에 아직 안 쓴 상태는 되도록 남김 (내보내면 다음에 저널에서 다시 만들어야 함)
+static Uint64 evict_rank(const RollupState* st)
+{
+    return ((Uint64)(st->dirty || st->needsFull) << 32) | st->last_use;
+}
+
+static RollupState* open_state(const char* plant_id)
+{
+    RollupState* slot = NULL;
+
+    for (int i = 0; i < ROLLUP_CACHE_MAX; i++) {
+        if (s_cache[i].used && SDL_strcmp(s_cache[i].id, plant_id) == 0) {
+            s_cache[i].last_use = ++s_useTick;
+            return &s_cache[i];
+        }
+    }
+
+    // 빈 칸 또는 가장 오래 안 쓴 칸
+    for (int i = 0; i < ROLLUP_CACHE_MAX; i++) {
+        if (!s_cache[i].used) { slot = &s_cache[i]; break; }
+        if (!slot || evict_rank(&s_cache[i]) < evict_rank(slot)) slot = &s_cache[i];
+    }
+
+    state_clear(slot);
+    SDL_memset(slot, 0, sizeof(*slot));
+    SDL_strlcpy(slot->id, plant_id, sizeof(slot->id));
+    slot->window_open_since = -1;
+    if (!state_load_file(slot)) slot->records = -1;   // 파일 없음/깨짐 → 처음 쓸 때 다시 만듦
+    slot->used = true;
+    slot->last_use = ++s_useTick;
+    return slot;
+}
+
+// 질의용 상태. 저널 기록 수와 안 맞으면 다시 만들기만 요청하고 지금 있는 값(비었거나 일부)을 그대로 돌려줌
+// (저널 전체를 읽는 일은 I/O 스레드의 rollup_rebuild_pending 이 함 → 프레임이 멈추지 않음)
+static RollupState* open_synced(const char* plant_id)
+{
+    if (!plant_id) return NULL;
+    RollupState* st = open_state(plant_id);
+    int records = journal_record_count(plant_id);
+    if (st->records != records) {
+        if (records == 0) {
+            state_clear(st);    // 기록 없는 식물은 파일을 만들지 않음
+            return st;
+        }
+        st->rebuildWanted = true;
+    }
+    return st;
+}
+
+void rollup_reset_cache(void)
+{
+    for (int i = 0; i < ROLLUP_CACHE_MAX; i++) state_clear(&s_cache[i]);
+    SDL_memset(s_cache, 0, sizeof(s_cache));
+    s_useTick = 0;
+}
+
+// ---------- 공개 API ----------
+bool rollup_append(const char* plant_id, const JSON_Value* const* entries, int n, int journal_records)
+{
+    if (!plant_id || !entries || n <= 0) return false;
+    RollupState* st = open_state(plant_id);
+    int valid = 0;
+    for (int i = 0; i < n; i++)
+        if (json_value_get_object(entries[i])) valid++;
+
+    if (st->records == journal_records) return true;   // 이미 반영됨
+    if (st->records < 0 && journal_records == valid) state_clear(st);  // 이번 기록이 처음 → 새로 시작
+    if (st->records < 0 || st->records + valid != journal_records) {
+        // 안 맞으면 여기(I/O 스레드 쓰기 경로)서 저널을 다시 읽지 않고 표시만 해 둠 → 처음 질의할 때 다시 만듦
+        if (st->records >= 0) SDL_Log("[ROLLUP] out of sync: %s (rebuild on next query)", plant_id);
+        state_clear(st);
+        st->records = -1;
+        return false;
+    }
+
+    for (int i = 0; i < n; i++) {
+        const JSON_Object* e = json_value_get_object(entries[i]);
+        if (e) apply_entry(st, e);
+    }
+    return true;
+}
+
+bool rollup_save(SDL_mutex* io_lock)
+{
+    RollupJob jobs[ROLLUP_CACHE_MAX];
+    bool ok[ROLLUP_CACHE_MAX];
+    int n = 0;
+    bool all = true;
+
+    for (int i = 0; i < ROLLUP_CACHE_MAX; i++) {
+        RollupState* st = &s_cache[i];
+        if (!st->used || st->records < 0 || !(st->dirty || st->needsFull)) continue;
+        if (job_collect(st, &jobs[n])) n++;
+    }
+    if (n == 0) return true;
+
+    if (io_lock) SDL_UnlockMutex(io_lock);
+    for (int i = 0; i < n; i++) ok[i] = job_write(&jobs[i]);
+    if (io_lock) SDL_LockMutex(io_lock);
+
+    for (int i = 0; i < n; i++) {
+        SDL_free(jobs[i].b);
+        SDL_free(jobs[i].at);
+        if (ok[i]) continue;
+        all = false;
+        SDL_Log("[ROLLUP] write failed: %s", jobs[i].id);
+        for (int k = 0; k < ROLLUP_CACHE_MAX; k++) {
+            if (s_cache[k].used && SDL_strcmp(s_cache[k].id, jobs[i].id) == 0) s_cache[k].needsFull = true;
+        }
+    }
+    return all;
+}
+
+bool rollup_rebuild_wanted(void)
+{
+    for (int i = 0; i < ROLLUP_CACHE_MAX; i++)
+        if (s_cache[i].used && s_cache[i].rebuildWanted) return true;
+    return false;
+}
+
+void rollup_rebuild_pending(SDL_mutex* io_lock)
+{
+    for (;;) {
+        RollupState* want = NULL;
+        for (int i = 0; i < ROLLUP_CACHE_MAX && !want; i++)
+            if (s_cache[i].used && s_cache[i].rebuildWanted) want = &s_cache[i];
+        if (!want) return;
+
+        char id[32];
+        SDL_strlcpy(id, want->id, sizeof(id));
+        want->rebuildWanted = false;
+        int records = journal_record_count(id);
+
+        // 캐시 밖에서 새로 쌓음 (그동안 질의는 캐시에 있는 값을 봄)
+        RollupState tmp;
+        SDL_memset(&tmp, 0, sizeof(tmp));
+        SDL_strlcpy(tmp.id, id, sizeof(tmp.id));
+        tmp.window_open_since = -1;
+        int done = 0;
+        while (done < records) {
+            int got = journal_read_range(id, done, ROLLUP_REBUILD_CHUNK, rebuild_visit, &tmp);
+            if (got <= 0) break;
+            done += got;
+            // 조각 사이에 락을 내줘서 질의하는 쪽이 끝까지 기다리지 않게
+            if (io_lock) {
+                SDL_UnlockMutex(io_lock);
+                SDL_Delay(0);
+                SDL_LockMutex(io_lock);
+            }
+        }
+
+        // 읽는 사이 저널이 바뀌었으면(세이브 삭제 등) 버림. 다음 질의가 다시 요청함
+        if (done != records || journal_record_count(id) != records) {
+            state_clear(&tmp);
+            SDL_Log("[ROLLUP] rebuild dropped: %s (journal changed)", id);
+            continue;
+        }
+        RollupState* st = open_state(id);
+        tmp.used = true;
+        tmp.last_use = st->last_use;
+        tmp.needsFull = true;   // 파일은 rollup_save 에서
+        state_clear(st);
+        *st = tmp;
+        SDL_Log("[ROLLUP] rebuilt: %s (%d records, %d days, %d weeks)",
+            st->id, st->records, st->count[ROLLUP_DAY], st->count[ROLLUP_WEEK]);
+    }
+}
+
+int rollup_query(const char* plant_id, RollupKind kind, int from, int to, RollupBucket* out, int max)
+{
+    if (!out || max <= 0 || from > to || (kind != ROLLUP_DAY && kind != ROLLUP_WEEK)) return 0;
+    RollupState* st = open_synced(plant_id);
+    if (!st) return 0;
+
+    int n = 0;
+    for (int i = cell_lower_bound(st, kind, from); i < st->count[kind] && n < max; i++) {
+        if (st->cells[kind][i].b.key > to) break;
+        out[n++] = st->cells[kind][i].b;
+    }
+    return n;
+}
+
+bool rollup_total(const char* plant_id, RollupKind kind, int from, int to, RollupBucket* out)
+{
+    if (!out || from > to || (kind != ROLLUP_DAY && kind != ROLLUP_WEEK)) return false;
+    RollupState* st = open_synced(plant_id);
+    if (!st) return false;
+
+    SDL_memset(out, 0, sizeof(*out));
+    out->key = from;
+    out->kind = kind;
+    for (int i = cell_lower_bound(st, kind, from); i < st->count[kind]; i++) {
+        if (st->cells[kind][i].b.key > to) break;
+        bucket_merge(out, &st->cells[kind][i].b);
+    }
+    return true;
+}
+
+bool rollup_rebuild(const char* plant_id)
+{
+    if (!plant_id) return false;
+    RollupState* st = open_state(plant_id);
+    if (journal_record_count(plant_id) == 0) {
+        char path[1024];
+        state_clear(st);
+        if (get_agg_path(plant_id, path, sizeof(path))) remove(path);
+        return true;
+    }
+    state_rebuild(st);
+    return rollup_save(NULL);
+}
+
+// ---------- 재생성 도구 ----------
+static void print_usage(void)
+{
+    printf("usage: GROWING --rebuild-rollups [plant_id ...]\n"
+           "  logs/<id>.jsonl 을 처음부터 읽어 logs/<id>.agg 를 다시 만든다.\n"
+           "  id 를 안 주면 plants.json 의 모든 식물 중 기록이 있는 것만.\n");
+}
+
+int rollup_main(int argc, char** argv)
+{
+    int done = 0, failed = 0;
+
+    for (int i = 2; i < argc; i++) {
+        if (SDL_strcmp(argv[i], "--help") == 0 || SDL_strcmp(argv[i], "-h") == 0) {
+            print_usage();
+            return 0;
+        }
+    }
+
+    // 게임이 돌고 있지 않을 때 쓰는 도구라 save.c 락 없이 바로 journal/rollup 을 부름
+    if (argc > 2) {
+        for (int i = 2; i < argc; i++) {
+            if (rollup_rebuild(argv[i])) done++;
+            else failed++;
+        }
+    }
+    else {
+        int n = plantdb_load(ASSETS_DIR "plants.json");
+        if (n <= 0) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[ROLLUP] plants.json load failed");
+            return 1;
+        }
+        for (int i = 0; i < n; i++) {
+            const PlantInfo* p = plantdb_get(i);
+            if (!p || journal_record_count(plantdb_id(p)) == 0) continue;
+            if (rollup_rebuild(plantdb_id(p))) done++;
+            else failed++;
+        }
+        plantdb_free();
+    }
+
+    rollup_reset_cache();
+    journal_reset_cache();
+    SDL_Log("[ROLLUP] rebuilt %d, failed %d", done, failed);
+    return failed ? 1 : 0;
+}
@@ -1,5 +1,8 @@
 #define _CRT_SECURE_NO_WARNINGS
 #include "../include/save.h"
+#include "../include/utils.h"
+#include "../include/journal.h"
+#include "../include/rollup.h"
 #include <SDL2/SDL.h>
 #include <parson.h>
 #include <stdio.h>
@@ -16,21 +19,31 @@
 #endif
 
 // ---------- 경로 도우미 ----------
+// PrefPath 는 처음 한 번만 구해서 캐시 (버튼 콜백마다 SDL_GetPrefPath/mkdir 하지 않게)
+static char s_baseDir[1024];
+static char s_logsDir[1024];
+
 static int get_base_dir(char* out, int outsz) {
-    char* base = SDL_GetPrefPath("DOLSUI", "GROWING");
-    if (!base) return 0;
-    SDL_strlcpy(out, base, outsz);
-    SDL_free(base);
+    if (!s_baseDir[0]) {
+        char* base = SDL_GetPrefPath("DOLSUI", "GROWING");
+        if (!base) return 0;
+        SDL_strlcpy(s_baseDir, base, sizeof(s_baseDir));
+        SDL_free(base);
+    }
+    SDL_strlcpy(out, s_baseDir, outsz);
     return 1;
 }
 
 static int ensure_logs_dir(char* out_logs, int outsz) {
-    char base[1024];
-    if (!get_base_dir(base, sizeof(base))) return 0;
-    SDL_snprintf(out_logs, outsz, "%slogs", base);
+    if (!s_logsDir[0]) {
+        char base[1024];
+        if (!get_base_dir(base, sizeof(base))) return 0;
+        SDL_snprintf(s_logsDir, sizeof(s_logsDir), "%slogs", base);
 
-    // 간단 mkdir (이미 있으면 실패해도 무시)
-    MKDIR(out_logs);
+        // 간단 mkdir (이미 있으면 실패해도 무시)
+        MKDIR(s_logsDir);
+    }
+    SDL_strlcpy(out_logs, s_logsDir, outsz);
     return 1;
 }
 
@@ -41,145 +54,360 @@ static int get_codex_json_path(char* out, int outsz) {
     return 1;
 }
 
-static int get_log_json_path(const char* plant_id, char* out, int outsz) {
-    char logs[1024];
-    if (!ensure_logs_dir(logs, sizeof(logs))) return 0;
-    SDL_snprintf(out, outsz, "%s/%s.json", logs, plant_id);
-    return 1;
+bool save_get_logs_dir(char* out, int outsz) {
+    return ensure_logs_dir(out, outsz) != 0;
+}
+
+bool save_get_base_dir(char* out, int outsz) {
+    return get_base_dir(out, outsz) != 0;
 }
 
 // ---------- 시간 문자열 ----------
 static void now_ts(char* out, int outsz) {
-    time_t t = time(NULL);
     struct tm lt;
-#ifdef _WIN32
-    localtime_s(&lt, &t);
-#else
-    localtime_r(&t, &lt);
-#endif
+    gameclock_localtime(&lt);   // 배속 중에도 화면 시계와 같은 시각으로 기록
     strftime(out, outsz, "%Y-%m-%d %H:%M", &lt);
 }
 
-// ---------- codex.json: 해금 ----------
-bool save_is_plant_completed(const char* plant_id) {
+// ---------- 저장 서비스 ----------
+// 해금 목록과 아직 안 쓴 기록을 메모리에 들고 있고,
+// 실제 파일 쓰기는 I/O 스레드가 모아서 한다 (SAVE_FLUSH_INTERVAL_MS 마다 / save_flush() / 종료 시).
+// s_ioLock 은 저널/집계의 메모리 상태와 쓰는 중인 기록(s_inflight)을 지킨다.
+// I/O 스레드는 큐 → 저널 넘겨주기 같은 메모리 작업 동안만 잡고, fwrite/rename 하는 동안은 풀어 둔다
+// → 도감/통계 씬의 읽기가 디스크 쓰기를 기다리지 않음.
+// 락 순서: s_ioLock → s_qLock
+#define SAVE_FLUSH_INTERVAL_MS  2000
+#define SAVE_QUEUE_SOFT_MAX     64      // 이만큼 쌓이면 타이머 전에 깨움
+
+typedef struct PendingLog {
+    char plant_id[32];
+    JSON_Value* entry;
+} PendingLog;
+
+static bool        s_ready = false;
+static SDL_Thread* s_ioThread = NULL;
+static SDL_mutex*  s_qLock = NULL;      // 큐, 해금 목록, flush 번호
+static SDL_mutex*  s_ioLock = NULL;     // journal_*/rollup_* 메모리 상태, s_inflight
+static SDL_cond*   s_wakeCond = NULL;   // I/O 스레드 깨우기
+static SDL_cond*   s_doneCond = NULL;   // flush 완료 알림
+static bool        s_quit = false;
+
+static PendingLog* s_queue = NULL;
+static int         s_queueCount = 0, s_queueCap = 0;
+static PendingLog* s_inflight = NULL;   // 큐에서 꺼내 파일에 쓰는 중 (저널에 반영되면 entry = NULL)
+static int         s_inflightCount = 0;
+static bool        s_codexDirty = false;
+static Uint32      s_flushRequested = 0, s_flushDone = 0;
+static SDL_atomic_t s_rollupWanted;     // 질의가 집계 다시 만들기를 요청함 → I/O 스레드가 처리
+static SDL_atomic_t s_logGeneration;    // 기록이 추가될 때마다 +1 (읽는 쪽 캐시 무효화용)
+
+// 해금된 식물 id 목록 (저장 순서 유지용 배열 + 조회용 오픈 어드레싱 해시)
+static char (*s_unlocked)[32] = NULL;
+static int  s_unlockedCount = 0, s_unlockedCap = 0;
+static int* s_unlockedHash = NULL;      // 칸마다 (배열 인덱스 + 1), 0 = 빈 칸
+static int  s_unlockedHashCap = 0;      // 2의 거듭제곱
+
+static Uint32 hash_id(const char* s) {
+    Uint32 h = 2166136261u;             // FNV-1a
+    while (*s) { h ^= (Uint8)*s++; h *= 16777619u; }
+    return h;
+}
+
+static int unlocked_find_slot(const char* plant_id) {
+    Uint32 mask = (Uint32)s_unlockedHashCap - 1;
+    Uint32 i = hash_id(plant_id) & mask;
+    for (;;) {
+        int v = s_unlockedHash[i];
+        if (v == 0 || SDL_strcmp(s_unlocked[v - 1], plant_id) == 0) return (int)i;
+        i = (i + 1) & mask;             // 선형 탐사
+    }
+}
+
+static bool unlocked_rehash(int cap) {
+    int* h = SDL_calloc((size_t)cap, sizeof(int));
+    if (!h) return false;
+    SDL_free(s_unlockedHash);
+    s_unlockedHash = h;
+    s_unlockedHashCap = cap;
+    for (int i = 0; i < s_unlockedCount; ++i)
+        s_unlockedHash[unlocked_find_slot(s_unlocked[i])] = i + 1;
+    return true;
+}
+
+static bool unlocked_contains(const char* plant_id) {
+    if (s_unlockedHashCap == 0) return false;
+    return s_unlockedHash[unlocked_find_slot(plant_id)] != 0;
+}
+
+static bool unlocked_add(const char* plant_id) {
+    // 부하율 1/2 이하 유지
+    if ((s_unlockedCount + 1) * 2 > s_unlockedHashCap &&
+        !unlocked_rehash(s_unlockedHashCap ? s_unlockedHashCap * 2 : 64))
+        return false;
+
+    if (s_unlockedCount == s_unlockedCap) {
+        int cap = s_unlockedCap ? s_unlockedCap * 2 : 32;
+        char (*p)[32] = SDL_realloc(s_unlocked, sizeof(*s_unlocked) * cap);
+        if (!p) return false;
+        s_unlocked = p;
+        s_unlockedCap = cap;
+    }
+    SDL_strlcpy(s_unlocked[s_unlockedCount], plant_id, sizeof(s_unlocked[0]));
+    s_unlockedHash[unlocked_find_slot(s_unlocked[s_unlockedCount])] = s_unlockedCount + 1;
+    s_unlockedCount++;
+    return true;
+}
+
+static void load_codex_file(void) {
     char path[1024];
-    if (!get_codex_json_path(path, sizeof(path))) return false;
+    if (!get_codex_json_path(path, sizeof(path))) return;
 
     JSON_Value* root = json_parse_file(path);
-    if (!root) return false;
-    JSON_Object* obj = json_value_get_object(root);
-    JSON_Array* arr = json_object_get_array(obj, "unlocked");
-    if (!arr) { json_value_free(root); return false; }
-
-    size_t n = json_array_get_count(arr);
+    if (!root) return;
+    JSON_Array* arr = json_object_get_array(json_value_get_object(root), "unlocked");
+    size_t n = arr ? json_array_get_count(arr) : 0;
     for (size_t i = 0; i < n; ++i) {
         const char* s = json_array_get_string(arr, i);
-        if (s && SDL_strcmp(s, plant_id) == 0) {
-            json_value_free(root);
-            return true;
-        }
+        if (s && !unlocked_contains(s)) unlocked_add(s);
     }
     json_value_free(root);
-    return false;
 }
 
-bool save_mark_plant_completed(const char* plant_id) {
-    char path[1024];
-    if (!get_codex_json_path(path, sizeof(path))) return false;
+// 임시 파일에 쓰고 교체
+static void write_codex_file(char (*ids)[32], int n) {
+    char path[1024], tmp[1100];
+    if (!get_codex_json_path(path, sizeof(path))) return;
+    SDL_snprintf(tmp, sizeof(tmp), "%s.tmp", path);
 
-    JSON_Value* root = json_parse_file(path);
-    JSON_Object* obj = NULL;
-    JSON_Array* arr = NULL;
-
-    if (!root) {
-        root = json_value_init_object();
-        obj = json_value_get_object(root);
-        arr = json_value_init_array();
-        json_object_set_value(obj, "unlocked", arr);
-        arr = json_object_get_array(obj, "unlocked");
+    JSON_Value* root = json_value_init_object();
+    JSON_Object* obj = json_value_get_object(root);
+    JSON_Value* arrv = json_value_init_array();
+    JSON_Array* arr = json_value_get_array(arrv);
+    for (int i = 0; i < n; ++i) json_array_append_string(arr, ids[i]);
+    json_object_set_value(obj, "unlocked", arrv);
+
+    if (json_serialize_to_file_pretty(root, tmp) == JSONSuccess) {
+        if (!file_replace(tmp, path)) {
+            remove(tmp);
+            SDL_Log("[SAVE] codex.json rename failed");
+        }
     }
     else {
-        obj = json_value_get_object(root);
-        arr = json_object_get_array(obj, "unlocked");
-        if (!arr) {
-            JSON_Value* v = json_value_init_array();
-            json_object_set_value(obj, "unlocked", v);
-            arr = json_object_get_array(obj, "unlocked");
-        }
+        SDL_Log("[SAVE] codex.json write failed");
     }
+    json_value_free(root);
+}
 
-    // 이미 있으면 패스
-    size_t n = json_array_get_count(arr);
-    for (size_t i = 0; i < n; ++i) {
-        const char* s = json_array_get_string(arr, i);
-        if (s && SDL_strcmp(s, plant_id) == 0) {
-            json_serialize_to_file_pretty(root, path);
-            json_value_free(root);
-            return true;
+// 큐를 통째로 가져와서 식물별로 묶어 한 번씩 쓴다
+static void flush_once(void) {
+    SDL_LockMutex(s_ioLock);
+
+    // 큐 → 쓰는 중 목록. 저널에 반영될 때까지 읽는 쪽은 여기서 봄
+    SDL_LockMutex(s_qLock);
+    PendingLog* batch = s_queue;
+    int n = s_queueCount;
+    s_inflight = batch;
+    s_inflightCount = n;
+    s_queue = NULL;
+    s_queueCount = s_queueCap = 0;
+
+    char (*ids)[32] = NULL;
+    int idCount = 0;
+    if (s_codexDirty) {
+        s_codexDirty = false;
+        idCount = s_unlockedCount;
+        ids = SDL_malloc(sizeof(*ids) * (idCount > 0 ? idCount : 1));
+        if (ids && idCount > 0) SDL_memcpy(ids, s_unlocked, sizeof(*ids) * idCount);
+    }
+    SDL_UnlockMutex(s_qLock);
+
+    if (n > 0) {
+        const JSON_Value** group = SDL_malloc(sizeof(*group) * n);
+        for (int i = 0; i < n && group; ++i) {
+            if (!batch[i].entry) continue;
+            int g = 0;
+            for (int j = i; j < n; ++j) {
+                if (batch[j].entry && SDL_strcmp(batch[j].plant_id, batch[i].plant_id) == 0)
+                    group[g++] = batch[j].entry;
+            }
+            // 파일에 쓰는 동안만 s_ioLock 을 풀었다가 다시 잡고 돌아옴
+            journal_append_many(batch[i].plant_id, group, g, s_ioLock);
+
+            // 저널에 반영된 것은 쓰는 중 목록에서 뺌 (락 안이라 읽는 쪽이 두 번 보거나 놓치지 않음)
+            for (int j = n - 1; j >= i; --j) {
+                if (batch[j].entry && SDL_strcmp(batch[j].plant_id, batch[i].plant_id) == 0) {
+                    json_value_free(batch[j].entry);
+                    batch[j].entry = NULL;
+                }
+            }
         }
+        if (!group) SDL_Log("[SAVE] out of memory, %d logs dropped", n);
+        for (int i = 0; i < n; ++i) if (batch[i].entry) json_value_free(batch[i].entry);
+        SDL_free(group);
+    }
+    s_inflight = NULL;
+    s_inflightCount = 0;
+
+    // 질의가 요청한 집계 다시 만들기 (저널을 조금씩 읽는 사이 락을 풂)
+    if (SDL_AtomicSet(&s_rollupWanted, 0)) rollup_rebuild_pending(s_ioLock);
+
+    // .idx / .agg 도 쓰는 동안은 락을 풂
+    journal_save_indexes(s_ioLock);
+    rollup_save(s_ioLock);
+    SDL_UnlockMutex(s_ioLock);
+    SDL_free(batch);
+
+    // codex.json 은 저널 상태와 상관없음
+    if (ids) {
+        write_codex_file(ids, idCount);
+        SDL_free(ids);
     }
-    // 추가
-    json_array_append_string(arr, plant_id);
-    json_serialize_to_file_pretty(root, path);
-    json_value_free(root);
-    return true;
 }
 
-// ---------- logs/<id>.json: 기록 추가 ----------
-static bool append_log_obj(const char* plant_id, JSON_Object* log_obj) {
-    char path[1024];
-    if (!get_log_json_path(plant_id, path, sizeof(path))) return false;
+static int SDLCALL save_io_thread(void* u) {
+    (void)u;
+    SDL_LockMutex(s_qLock);
+    for (;;) {
+        bool wantFlush = s_flushRequested != s_flushDone;
+        if (!s_quit && !wantFlush && s_queueCount < SAVE_QUEUE_SOFT_MAX && !SDL_AtomicGet(&s_rollupWanted))
+            SDL_CondWaitTimeout(s_wakeCond, s_qLock, SAVE_FLUSH_INTERVAL_MS);
 
-    JSON_Value* root = json_parse_file(path);
-    JSON_Object* obj = NULL;
-    JSON_Array* history = NULL;
-
-    if (!root) {
-        root = json_value_init_object();
-        obj = json_value_get_object(root);
-        json_object_set_string(obj, "plant_id", plant_id);
-        JSON_Value* arrv = json_value_init_array();
-        json_object_set_value(obj, "history", arrv);
-        history = json_object_get_array(obj, "history");
+        Uint32 target = s_flushRequested;
+        bool work = s_queueCount > 0 || s_codexDirty || (!s_quit && SDL_AtomicGet(&s_rollupWanted));
+        SDL_UnlockMutex(s_qLock);
+
+        if (work) flush_once();
+
+        SDL_LockMutex(s_qLock);
+        s_flushDone = target;
+        SDL_CondBroadcast(s_doneCond);
+        if (s_quit && s_queueCount == 0 && !s_codexDirty) break;
     }
-    else {
-        obj = json_value_get_object(root);
-        history = json_object_get_array(obj, "history");
-        if (!history) {
-            JSON_Value* arrv = json_value_init_array();
-            json_object_set_value(obj, "history", arrv);
-            history = json_object_get_array(obj, "history");
-        }
+    SDL_UnlockMutex(s_qLock);
+    return 0;
+}
+
+bool save_init(void) {
+    if (s_ready) return true;
+
+    s_qLock = SDL_CreateMutex();
+    s_ioLock = SDL_CreateMutex();
+    s_wakeCond = SDL_CreateCond();
+    s_doneCond = SDL_CreateCond();
+    if (!s_qLock || !s_ioLock || !s_wakeCond || !s_doneCond) {
+        SDL_Log("[SAVE] init failed: %s", SDL_GetError());
+        return false;
     }
 
-    JSON_Value* entry = json_value_init_object();
-    JSON_Object* eobj = json_value_get_object(entry);
+    // 시작할 때 한 번만 읽어둠
+    load_codex_file();
 
-    // 공통 ts,event 복사
-    const char* ts = json_object_get_string(log_obj, "ts");
-    const char* evt = json_object_get_string(log_obj, "event");
-    if (ts)  json_object_set_string(eobj, "ts", ts);
-    if (evt) json_object_set_string(eobj, "event", evt);
+    s_quit = false;
+    s_ioThread = SDL_CreateThread(save_io_thread, "save_io", NULL);
+    if (!s_ioThread) SDL_Log("[SAVE] I/O thread failed, writing synchronously: %s", SDL_GetError());
 
-    // 나머지 필드 복사 (간단하게 필요한 키만 체크)
-    if (json_object_has_value_of_type(log_obj, "amount_ml", JSONNumber))
-        json_object_set_number(eobj, "amount_ml", json_object_get_number(log_obj, "amount_ml"));
+    s_ready = true;
+    return true;
+}
 
-    if (json_object_has_value_of_type(log_obj, "minutes", JSONNumber))
-        json_object_set_number(eobj, "minutes", json_object_get_number(log_obj, "minutes"));
+void save_flush(void) {
+    if (!s_ready) return;
 
-    if (json_object_has_value_of_type(log_obj, "ppfd", JSONNumber))
-        json_object_set_number(eobj, "ppfd", json_object_get_number(log_obj, "ppfd"));
+    if (!s_ioThread) {
+        flush_once();
+        return;
+    }
 
-    if (json_object_has_value_of_type(log_obj, "value", JSONString))
-        json_object_set_string(eobj, "value", json_object_get_string(log_obj, "value"));
+    SDL_LockMutex(s_qLock);
+    Uint32 ticket = ++s_flushRequested;
+    SDL_CondSignal(s_wakeCond);
+    while ((Sint32)(s_flushDone - ticket) < 0)
+        SDL_CondWait(s_doneCond, s_qLock);
+    SDL_UnlockMutex(s_qLock);
+}
 
-    if (json_object_has_value_of_type(log_obj, "open", JSONBoolean))
-        json_object_set_boolean(eobj, "open", json_object_get_boolean(log_obj, "open"));
+void save_shutdown(void) {
+    if (!s_ready) return;
+
+    save_flush();
+    if (s_ioThread) {
+        SDL_LockMutex(s_qLock);
+        s_quit = true;
+        SDL_CondSignal(s_wakeCond);
+        SDL_UnlockMutex(s_qLock);
+        SDL_WaitThread(s_ioThread, NULL);
+        s_ioThread = NULL;
+    }
+    SDL_AtomicSet(&s_rollupWanted, 0);     // 종료할 때는 집계를 다시 만들지 않음 (다음 실행에서 질의할 때)
+    flush_once();   // 혹시 남은 것
+
+    SDL_DestroyCond(s_wakeCond);
+    SDL_DestroyCond(s_doneCond);
+    SDL_DestroyMutex(s_ioLock);
+    SDL_DestroyMutex(s_qLock);
+    s_wakeCond = s_doneCond = NULL;
+    s_ioLock = s_qLock = NULL;
+
+    SDL_free(s_unlocked);
+    SDL_free(s_unlockedHash);
+    s_unlocked = NULL;
+    s_unlockedHash = NULL;
+    s_unlockedCount = s_unlockedCap = s_unlockedHashCap = 0;
+    journal_reset_cache();
+    rollup_reset_cache();
+    s_ready = false;
+}
 
-    json_array_append_value(history, entry);
-    json_serialize_to_file_pretty(root, path);
-    json_value_free(root);
+// ---------- codex.json: 해금 ----------
+bool save_is_plant_completed(const char* plant_id) {
+    if (!plant_id || !save_init()) return false;
+    SDL_LockMutex(s_qLock);
+    bool found = unlocked_contains(plant_id);
+    SDL_UnlockMutex(s_qLock);
+    return found;
+}
+
+bool save_mark_plant_completed(const char* plant_id) {
+    if (!plant_id || !save_init()) return false;
+    bool ok = true;
+    SDL_LockMutex(s_qLock);
+    if (!unlocked_contains(plant_id)) {
+        ok = unlocked_add(plant_id);
+        if (ok) s_codexDirty = true;
+    }
+    SDL_UnlockMutex(s_qLock);
+    if (!s_ioThread) save_flush();
+    return ok;
+}
+
+// ---------- logs/<id>.jsonl: 기록 추가 ----------
+// 메모리 큐에만 넣고 바로 리턴. 파일에는 I/O 스레드가 한 줄씩 붙임 (core/journal.c)
+static bool append_log_obj(const char* plant_id, JSON_Object* log_obj) {
+    if (!plant_id || !save_init()) return false;
+
+    JSON_Value* copy = json_value_deep_copy(json_object_get_wrapping_value(log_obj));
+    if (!copy) return false;
+
+    SDL_LockMutex(s_qLock);
+    if (s_queueCount == s_queueCap) {
+        int cap = s_queueCap ? s_queueCap * 2 : 32;
+        PendingLog* q = SDL_realloc(s_queue, sizeof(*q) * cap);
+        if (!q) {
+            SDL_UnlockMutex(s_qLock);
+            json_value_free(copy);
+            return false;
+        }
+        s_queue = q;
+        s_queueCap = cap;
+    }
+    SDL_strlcpy(s_queue[s_queueCount].plant_id, plant_id, sizeof(s_queue[0].plant_id));
+    s_queue[s_queueCount].entry = copy;
+    s_queueCount++;
+    if (s_queueCount >= SAVE_QUEUE_SOFT_MAX) SDL_CondSignal(s_wakeCond);
+    SDL_UnlockMutex(s_qLock);
+    SDL_AtomicAdd(&s_logGeneration, 1);
+
+    if (!s_ioThread) save_flush();
     return true;
 }
 
@@ -265,48 +493,162 @@ bool log_stage(const char* plant_id, const char* stage_name) { return add_log_st
 bool log_window(const char* plant_id, bool open) { return add_log_window(plant_id, open); }
 
 // (선택) Codex에 보여주기 위한 간단 변환
+typedef struct {
+    CodexLog* out;
+    int max;
+    int n;
+} CodexLogCtx;
+
+static bool codex_log_visit(const JSON_Object* e, void* user) {
+    CodexLogCtx* c = (CodexLogCtx*)user;
+    CodexLog* o = &c->out[c->n];
+    const char* ts = json_object_get_string(e, "ts");
+    const char* ev = json_object_get_string(e, "event");
+    SDL_strlcpy(o->ts, ts ? ts : "", sizeof(o->ts));
+
+    // 라인 만들기(간단 버전)
+    if (ev && SDL_strcmp(ev, "water") == 0) {
+        int ml = (int)json_object_get_number(e, "amount_ml");
+        SDL_snprintf(o->line, sizeof(o->line), "[%s] 물주기 %dml", o->ts, ml);
+    }
+    else if (ev && SDL_strcmp(ev, "sun") == 0) {
+        int m = (int)json_object_get_number(e, "minutes");
+        int p = (int)json_object_get_number(e, "ppfd");
+        SDL_snprintf(o->line, sizeof(o->line), "[%s] 햇빛 %d분 (PPFD %d)", o->ts, m, p);
+    }
+    else if (ev && SDL_strcmp(ev, "stage") == 0) {
+        const char* v = json_object_get_string(e, "value");
+        SDL_snprintf(o->line, sizeof(o->line), "[%s] 단계 전환: %s", o->ts, v ? v : "");
+    }
+    else if (ev && SDL_strcmp(ev, "window") == 0) {
+        int open = json_object_get_boolean(e, "open") == 1;
+        SDL_snprintf(o->line, sizeof(o->line), "[%s] 창문 %s", o->ts, open ? "열림" : "닫힘");
+    }
+    else {
+        SDL_snprintf(o->line, sizeof(o->line), "[%s] %s", o->ts, ev ? ev : "(unknown)");
+    }
+
+    c->n++;
+    return c->n < c->max;
+}
+
 int save_get_plant_logs(const char* plant_id, CodexLog* out, int max) {
-    if (!out || max <= 0) return 0;
-    char path[1024];
-    if (!get_log_json_path(plant_id, path, sizeof(path))) return 0;
+    if (!out || max <= 0 || !plant_id || !save_init()) return 0;
+    CodexLogCtx ctx = { out, max, 0 };
+
+    // 파일 + 쓰는 중 + 아직 큐에 있는 기록 (I/O 락을 잡고 있으면 셋 사이에 빠지는 게 없음)
+    SDL_LockMutex(s_ioLock);
+    journal_read(plant_id, codex_log_visit, &ctx);
+    for (int i = 0; i < s_inflightCount && ctx.n < ctx.max; ++i) {
+        if (s_inflight[i].entry && SDL_strcmp(s_inflight[i].plant_id, plant_id) == 0)
+            codex_log_visit(json_value_get_object(s_inflight[i].entry), &ctx);
+    }
+    SDL_LockMutex(s_qLock);
+    for (int i = 0; i < s_queueCount && ctx.n < ctx.max; ++i) {
+        if (SDL_strcmp(s_queue[i].plant_id, plant_id) == 0)
+            codex_log_visit(json_value_get_object(s_queue[i].entry), &ctx);
+    }
+    SDL_UnlockMutex(s_qLock);
+    SDL_UnlockMutex(s_ioLock);
+    return ctx.n;
+}
 
-    JSON_Value* root = json_parse_file(path);
-    if (!root) return 0;
-    JSON_Object* obj = json_value_get_object(root);
-    JSON_Array* history = json_object_get_array(obj, "history");
-    if (!history) { json_value_free(root); return 0; }
-
-    int n = (int)json_array_get_count(history);
-    if (n > max) n = max;
-
-    for (int i = 0; i < n; ++i) {
-        JSON_Object* e = json_array_get_object(history, i);
-        const char* ts = json_object_get_string(e, "ts");
-        const char* ev = json_object_get_string(e, "event");
-        SDL_strlcpy(out[i].ts, ts ? ts : "", sizeof(out[i].ts));
-
-        // 라인 만들기(간단 버전)
-        if (ev && SDL_strcmp(ev, "water") == 0) {
-            int ml = (int)json_object_get_number(e, "amount_ml");
-            SDL_snprintf(out[i].line, sizeof(out[i].line), "[%s] 물주기 %dml", out[i].ts, ml);
-        }
-        else if (ev && SDL_strcmp(ev, "sun") == 0) {
-            int m = (int)json_object_get_number(e, "minutes");
-            int p = (int)json_object_get_number(e, "ppfd");
-            SDL_snprintf(out[i].line, sizeof(out[i].line), "[%s] 햇빛 %d분 (PPFD %d)", out[i].ts, m, p);
-        }
-        else if (ev && SDL_strcmp(ev, "stage") == 0) {
-            const char* v = json_object_get_string(e, "value");
-            SDL_snprintf(out[i].line, sizeof(out[i].line), "[%s] 단계 전환: %s", out[i].ts, v ? v : "");
-        }
-        else if (ev && SDL_strcmp(ev, "window") == 0) {
-            int open = json_object_get_boolean(e, "open") == 1;
-            SDL_snprintf(out[i].line, sizeof(out[i].line), "[%s] 창문 %s", out[i].ts, open ? "열림" : "닫힘");
-        }
-        else {
-            SDL_snprintf(out[i].line, sizeof(out[i].line), "[%s] %s", out[i].ts, ev ? ev : "(unknown)");
+// 최신 것부터 거꾸로 (skip 개 건너뛰고) out 에 채움
+static int visit_pending_newest(const PendingLog* q, int count, const char* plant_id, int* skip, CodexLog* out, int n, int max) {
+    for (int i = count - 1; i >= 0 && n < max; --i) {
+        if (!q[i].entry || SDL_strcmp(q[i].plant_id, plant_id) != 0) continue;
+        if (*skip > 0) { (*skip)--; continue; }
+        CodexLogCtx one = { &out[n], 1, 0 };
+        codex_log_visit(json_value_get_object(q[i].entry), &one);
+        n++;
+    }
+    return n;
+}
+
+// 최신 기록부터 (skip 개 건너뛰고) 최대 max 개. 큐 → 쓰는 중 → 파일 끝쪽 순
+int save_get_recent_plant_logs(const char* plant_id, int skip, CodexLog* out, int max) {
+    if (!out || max <= 0 || skip < 0 || !plant_id || !save_init()) return 0;
+    int n = 0;
+
+    // I/O 스레드는 넘겨주기 동안만 이 락을 잡음 (파일 쓰는 동안은 안 기다림)
+    SDL_LockMutex(s_ioLock);
+
+    SDL_LockMutex(s_qLock);
+    n = visit_pending_newest(s_queue, s_queueCount, plant_id, &skip, out, n, max);
+    SDL_UnlockMutex(s_qLock);
+    n = visit_pending_newest(s_inflight, s_inflightCount, plant_id, &skip, out, n, max);
+
+    if (n < max) {
+        int last = journal_record_count(plant_id) - 1 - skip;
+        if (last >= 0) {
+            int first = last - (max - n) + 1;
+            if (first < 0) first = 0;
+            CodexLogCtx ctx = { out + n, last - first + 1, 0 };
+            journal_read_range(plant_id, first, last - first + 1, codex_log_visit, &ctx);
+
+            // 오래된 순으로 읽었으니 뒤집기
+            for (int a = n, b = n + ctx.n - 1; a < b; ++a, --b) {
+                CodexLog t = out[a]; out[a] = out[b]; out[b] = t;
+            }
+            n += ctx.n;
         }
     }
-    json_value_free(root);
+
+    SDL_UnlockMutex(s_ioLock);
+    return n;
+}
+
+int save_get_plant_log_count(const char* plant_id) {
+    if (!plant_id || !save_init()) return 0;
+    int n = 0;
+
+    SDL_LockMutex(s_ioLock);
+    SDL_LockMutex(s_qLock);
+    for (int i = 0; i < s_queueCount; ++i)
+        if (SDL_strcmp(s_queue[i].plant_id, plant_id) == 0) n++;
+    SDL_UnlockMutex(s_qLock);
+    for (int i = 0; i < s_inflightCount; ++i)
+        if (s_inflight[i].entry && SDL_strcmp(s_inflight[i].plant_id, plant_id) == 0) n++;
+    n += journal_record_count(plant_id);
+    SDL_UnlockMutex(s_ioLock);
+    return n;
+}
+
+Uint32 save_logs_generation(void) {
+    return (Uint32)SDL_AtomicGet(&s_logGeneration);
+}
+
+// 집계가 저널과 안 맞으면 질의는 있는 값만 돌려주고, 다시 만들기는 I/O 스레드에 넘김
+static void wake_rollup_rebuild(bool wanted) {
+    if (!wanted || SDL_AtomicGet(&s_rollupWanted)) return;
+    if (!s_ioThread) {
+        // 스레드가 없으면 (동기 저장) 여기서 바로
+        SDL_AtomicSet(&s_rollupWanted, 1);
+        flush_once();
+        return;
+    }
+    SDL_LockMutex(s_qLock);
+    SDL_AtomicSet(&s_rollupWanted, 1);
+    SDL_CondSignal(s_wakeCond);
+    SDL_UnlockMutex(s_qLock);
+}
+
+int save_get_rollup(const char* plant_id, RollupKind kind, int from, int to, RollupBucket* out, int max) {
+    if (!plant_id || !save_init()) return 0;
+    SDL_LockMutex(s_ioLock);
+    int n = rollup_query(plant_id, kind, from, to, out, max);
+    bool wanted = rollup_rebuild_wanted();
+    SDL_UnlockMutex(s_ioLock);
+    wake_rollup_rebuild(wanted);
     return n;
-}
\ No newline at end of file
+}
+
+bool save_get_rollup_total(const char* plant_id, RollupKind kind, int from, int to, RollupBucket* out) {
+    if (!plant_id || !save_init()) return false;
+    SDL_LockMutex(s_ioLock);
+    bool ok = rollup_total(plant_id, kind, from, to, out);
+    bool wanted = rollup_rebuild_wanted();
+    SDL_UnlockMutex(s_ioLock);
+    wake_rollup_rebuild(wanted);
+    return ok;
+}
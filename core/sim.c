@@ -0,0 +1,402 @@
+#include <math.h>
+#include "../include/sim.h"
+
+// scene_game.c 에 있던 게임 로직을 SDL 렌더링과 분리한 것.
+// 수치/순서는 기존 씬 코드와 동일하게 유지한다.
+
+void sim_default_params(SimParams* out)
+{
+    out->bug_chance_per_sec = 0.0005f;   // 추측
+    out->mold_chance_per_sec = 0.0005f;  // 추측
+    out->event_chance_per_sec = 0.0001f;
+    out->event_cooltime = 20.f;
+    out->nutrition_per_min = -2.0f;      // 추측
+}
+
+// xorshift64* : 스레드마다 독립적인 시드 가능 (rand()는 전역 상태)
+static Uint64 sim_next(GrowSim* sim)
+{
+    Uint64 x = sim->rng;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    sim->rng = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+float sim_rand01(GrowSim* sim)
+{
+    return (float)(sim_next(sim) >> 40) / (float)(1 << 24);
+}
+
+// 초당 확률 rate 로 일어나는 사건까지 남은 시간(sec)
+// 매 프레임 rand() 를 굴리는 대신 지수분포로 한 번만 뽑아두고 dt 만큼 깎는다.
+// (무기억성이라 분포는 동일하고, 프레임레이트/dt 와 무관해짐)
+static float sim_sample_wait(GrowSim* sim, float rate)
+{
+    if (rate <= 0.f) return 1e30f;
+    float u = 1.f - sim_rand01(sim);   // (0, 1]
+    return -logf(u) / rate;
+}
+
+void sim_reset_status(GrowSim* sim)
+{
+    sim->status.moisture = 60.f;
+    sim->status.temp = (float)sim->room_temperature; // 방 온도 따라감
+    sim->status.humidity = 60.f;
+    sim->status.light = 0.f;
+    sim->status.happiness = 70.f;
+    sim->status.nutrition = 70.f;
+}
+
+void sim_init(GrowSim* sim, const PlantInfo* plant, const SimParams* params, Uint64 seed)
+{
+    SDL_memset(sim, 0, sizeof(*sim));
+    sim->plant = plant;
+    if (params) sim->params = *params;
+    else sim_default_params(&sim->params);
+
+    sim->room_temperature = 20;
+    sim->room_humidity = 60.f;
+    sim->level = 1;
+    sim->exp = 0.f;
+    sim->base_tag = WEATHER_TAG_CLEAR;
+    sim->weather_tag = WEATHER_TAG_CLEAR;
+    sim->cooltime = sim->params.event_cooltime;
+
+    // 0 시드는 xorshift 에서 안 됨
+    sim->rng = seed ? seed : 0x9E3779B97F4A7C15ULL;
+    sim_next(sim);
+
+    sim->bug_wait = sim_sample_wait(sim, sim->params.bug_chance_per_sec);
+    sim->mold_wait = sim_sample_wait(sim, sim->params.mold_chance_per_sec);
+    sim->event_wait = sim_sample_wait(sim, sim->params.event_chance_per_sec);
+
+    sim_reset_status(sim);
+}
+
+void sim_set_weather(GrowSim* sim, WeatherTag real_tag)
+{
+    sim->base_tag = real_tag;
+    if (!sim->weather_event_active)
+        sim->weather_tag = real_tag;
+}
+
+void sim_schedule_weather(GrowSim* sim, WeatherTag tag, float in_sec)
+{
+    if (in_sec <= 0.f) {
+        sim_set_weather(sim, tag);
+        sim->next_tag = WEATHER_TAG_UNKNOWN;
+        return;
+    }
+    sim->next_tag = tag;
+    sim->next_tag_in = in_sec;
+}
+
+void sim_set_outdoor(GrowSim* sim, float temp, float humidity)
+{
+    sim->outdoor_known = true;
+    sim->outdoor_temp = temp;
+    sim->outdoor_humidity = humidity;
+}
+
+static void update_scheduled_weather(GrowSim* sim, float dt)
+{
+    if (sim->next_tag == WEATHER_TAG_UNKNOWN) return;
+    sim->next_tag_in -= dt;
+    if (sim->next_tag_in <= 0.f) {
+        sim_set_weather(sim, sim->next_tag);
+        sim->next_tag = WEATHER_TAG_UNKNOWN;
+    }
+}
+
+static void update_status(GrowSim* sim)
+{
+    if (!sim->plant) return;
+    float optM = sim->plant->moisture_opt;
+
+    sim->moisture_ok = (sim->status.moisture >= optM - 10.0f && sim->status.moisture <= optM + 10.0f);
+    sim->temp_ok = (sim->status.temp >= sim->plant->temp_min && sim->status.temp <= sim->plant->temp_max);
+    sim->humidity_ok = (sim->status.humidity >= sim->plant->humidity_min && sim->status.humidity <= sim->plant->humidity_max);
+    sim->nutrition_ok = (sim->status.nutrition >= 40.f); // 추측
+}
+
+static void update_moisture(GrowSim* sim, float dt)
+{
+    float basePerMin = 0.f;
+
+    switch (sim->weather_tag) {
+    case WEATHER_TAG_CLEAR:   basePerMin = 10.f; break;
+    case WEATHER_TAG_RAIN:    basePerMin = 5.f;  break;
+    case WEATHER_TAG_CLOUDY:  basePerMin = 8.f;  break;
+    case WEATHER_TAG_SNOW:    basePerMin = 6.f;  break; // ★ 눈: 추측값
+    default:                  basePerMin = 8.f;  break;
+    }
+
+    // 1분에 basePerMin 만큼 줄어든다고 가정 → 1초당 basePerMin/60
+    float perSec = basePerMin / 60.f;
+    sim->status.moisture -= perSec * dt;
+    if (sim->status.moisture < 0.f) sim->status.moisture = 0.f;
+}
+
+static void update_temperature(GrowSim* sim, float dt)
+{
+    float perMin = 0.f;
+
+    switch (sim->weather_tag) {
+    case WEATHER_TAG_CLEAR:  perMin = +0.5f; break;
+    case WEATHER_TAG_SNOW:   perMin = -0.5f; break;
+    case WEATHER_TAG_RAIN:
+    case WEATHER_TAG_CLOUDY: perMin = 0.0f; break;
+    default:                  perMin = 0.0f; break;
+    }
+
+    float perSec = perMin / 60.f;
+    sim->room_temperature += perSec * dt;
+
+    // 창문이 열려 있으면 바깥 온도 쪽으로 (분당 차이의 5%)
+    if (sim->window_open && sim->outdoor_known) {
+        sim->room_temp_drift += (sim->outdoor_temp - (float)sim->room_temperature) * (0.05f / 60.f) * dt;
+        int whole = (int)sim->room_temp_drift;
+        sim->room_temperature += whole;
+        sim->room_temp_drift -= (float)whole;
+    }
+    sim->status.temp = (float)sim->room_temperature;
+}
+
+static void update_humidity(GrowSim* sim, float dt)
+{
+    float perMin = 0.f;
+
+    if (sim->weather_tag == WEATHER_TAG_CLEAR) {
+        // 맑음 → 감소
+        perMin = -2.0f;
+    }
+    else if (sim->weather_tag == WEATHER_TAG_RAIN) {
+        // 비 → 창문 열면 많이 증가, 닫으면 조금 증가 (추측)
+        if (sim->window_open)
+            perMin = +3.0f;
+        else
+            perMin = +1.0f;
+    }
+    else {
+        // 구름/눈 → 거의 유지 (약간만 변화)
+        perMin = 0.0f;
+    }
+
+    float perSec = perMin / 60.f;
+    sim->room_humidity += perSec * dt;
+
+    // 창문이 열려 있으면 바깥 습도 쪽으로 (분당 차이의 5%)
+    if (sim->window_open && sim->outdoor_known)
+        sim->room_humidity += (sim->outdoor_humidity - sim->room_humidity) * (0.05f / 60.f) * dt;
+
+    if (sim->room_humidity < 0.f)   sim->room_humidity = 0.f;
+    if (sim->room_humidity > 100.f) sim->room_humidity = 100.f;
+
+    sim->status.humidity = sim->room_humidity;
+}
+
+static void update_random_events(GrowSim* sim, float dt)
+{
+    // 없을 때만 대기 시간이 줄어듦 (기존: 없을 때만 확률 체크)
+    if (!sim->has_bug) {
+        sim->bug_wait -= dt;
+        if (sim->bug_wait <= 0.f)
+            sim->has_bug = true;
+    }
+
+    if (!sim->has_mold) {
+        sim->mold_wait -= dt;
+        if (sim->mold_wait <= 0.f)
+            sim->has_mold = true;
+    }
+}
+
+static void update_happiness(GrowSim* sim, float dt)
+{
+    float deltaPerMin = 0.f;
+
+    if (sim->has_bug)  deltaPerMin -= 3.f; // 추측
+    if (sim->has_mold) deltaPerMin -= 4.f; // 추측
+
+    float perSec = deltaPerMin / 60.f;
+    sim->status.happiness += perSec * dt;
+
+    if (sim->status.happiness < 0.f)   sim->status.happiness = 0.f;
+    if (sim->status.happiness > 100.f) sim->status.happiness = 100.f;
+}
+
+static void update_nutrition(GrowSim* sim, float dt)
+{
+    float perSec = sim->params.nutrition_per_min / 60.f;
+
+    sim->status.nutrition += perSec * dt;
+    if (sim->status.nutrition < 0.f)   sim->status.nutrition = 0.f;
+    if (sim->status.nutrition > 100.f) sim->status.nutrition = 100.f;
+}
+
+static void start_weather_event(GrowSim* sim, WeatherTag eventTag, float duration)
+{
+    if (sim->weather_event_active) return;  // 이미 이벤트 중이면 무시
+
+    sim->weather_event_active = 1;
+    sim->weather_event_timer = duration;
+    sim->weather_tag = eventTag;            // 실제 날씨는 base_tag 에 남아 있음
+}
+
+static void update_weather_event(GrowSim* sim, float dt)
+{
+    if (sim->weather_event_active == 0) {
+        // 이벤트 없음 → 아주 낮은 확률로 발생 (추측)
+        sim->event_wait -= dt;
+        if (sim->event_wait <= 0.f) {
+            float w = sim_rand01(sim) * 10.f;
+            WeatherTag eventTag;
+
+            if (w < 2.f) eventTag = WEATHER_TAG_RAIN;
+            else if (w < 4.f) eventTag = WEATHER_TAG_CLOUDY;
+            else if (w < 6.f) eventTag = WEATHER_TAG_SNOW;
+            else              eventTag = WEATHER_TAG_CLEAR;
+
+            start_weather_event(sim, eventTag, 60.f);
+
+            // 1~2분 사이 지속 (추측)
+            float durMin = 1.f + sim_rand01(sim) * 1.f;
+            sim->weather_event_timer = durMin * 20.f;
+        }
+    }
+    else {
+        // 진행 중
+        sim->weather_event_timer -= dt;
+        if (sim->weather_event_timer <= 0.f) {
+            sim->weather_tag = sim->base_tag;  // ★ 원래 날씨 복원
+            sim->weather_event_active = 0;
+            sim->cooltime = sim->params.event_cooltime;
+            sim->event_wait = sim_sample_wait(sim, sim->params.event_chance_per_sec);
+        }
+    }
+}
+
+void sim_step(GrowSim* sim, float dt)
+{
+    update_scheduled_weather(sim, dt);  // 예보로 예약된 날씨 변화
+
+    // 랜덤 이벤트들
+    sim->cooltime -= dt;
+    if (sim->cooltime <= 0.f) {
+        update_weather_event(sim, dt);   // 랜덤 날씨 이벤트
+    }
+
+    update_random_events(sim, dt);       // 벌레, 곰팡이 생성
+
+    // 상태값 업데이트
+    update_moisture(sim, dt);
+    update_temperature(sim, dt);
+    update_humidity(sim, dt);
+    update_happiness(sim, dt);
+    update_nutrition(sim, dt);
+
+    update_status(sim);
+}
+
+float sim_exp_multiplier(const GrowSim* sim)
+{
+    // 현재 실제 날씨와 이벤트 날씨가 같으면 1.5배 (추측)
+    if (sim->weather_event_active != WEATHER_TAG_CLEAR &&
+        sim->weather_event_active == (int)sim->weather_tag) {
+        return 1.5f;
+    }
+    return 1.0f;
+}
+
+int sim_add_exp(GrowSim* sim, float baseExp)
+{
+    if (baseExp <= 0.f)
+        return 0;
+
+    int gained = 0;
+    sim->exp += baseExp * sim_exp_multiplier(sim);
+
+    while (sim->exp >= 100.f)
+    {
+        sim->exp -= 100.f;
+        sim->level++;
+        gained++;
+    }
+    return gained;
+}
+
+// ---------------- 플레이어 액션 ----------------
+int sim_action_water(GrowSim* sim)
+{
+    sim->exp += 1.f * sim_exp_multiplier(sim);
+    int gained = sim_add_exp(sim, EXP_WATER); //물 경험치 추가🐥
+
+    sim->status.moisture += 10.f;
+    if (sim->status.moisture > 100.f)
+        sim->status.moisture = 100.f;
+    return gained;
+}
+
+bool sim_action_kill_bug(GrowSim* sim)
+{
+    if (!sim->has_bug)
+        return false;
+
+    sim->has_bug = false;
+    sim->bug_wait = sim_sample_wait(sim, sim->params.bug_chance_per_sec);
+    sim->status.happiness += 10.f;
+    if (sim->status.happiness > 100.f)
+        sim->status.happiness = 100.f;
+
+    sim_add_exp(sim, EXP_KILL_BUG);
+    return true;
+}
+
+bool sim_action_remove_mold(GrowSim* sim)
+{
+    if (!sim->has_mold)
+        return false;
+
+    sim->has_mold = false;
+    sim->mold_wait = sim_sample_wait(sim, sim->params.mold_chance_per_sec);
+    sim->status.happiness += 10.f;
+    if (sim->status.happiness > 100.f)
+        sim->status.happiness = 100.f;
+
+    sim_add_exp(sim, EXP_REMOVE_MOLD);
+    return true;
+}
+
+int sim_action_temp_down(GrowSim* sim)
+{
+    sim->exp += 1.f * sim_exp_multiplier(sim);
+    int gained = sim_add_exp(sim, EXP_TEMP_DOWN);
+    sim->room_temperature--;
+    sim->status.temp = (float)sim->room_temperature;
+    return gained;
+}
+
+int sim_action_temp_up(GrowSim* sim)
+{
+    sim->exp += 1.f * sim_exp_multiplier(sim);
+    int gained = sim_add_exp(sim, EXP_TEMP_UP);
+    sim->room_temperature++;
+    sim->status.temp = (float)sim->room_temperature;
+    return gained;
+}
+
+int sim_action_fertilize(GrowSim* sim)
+{
+    sim->status.nutrition += 20.f; // 추측
+    if (sim->status.nutrition > 100.f) sim->status.nutrition = 100.f;
+
+    sim->exp += 1.f * sim_exp_multiplier(sim);
+    return sim_add_exp(sim, EXP_GIVE_FERT);
+}
+
+void sim_action_toggle_window(GrowSim* sim)
+{
+    sim->window_open = !sim->window_open;
+}
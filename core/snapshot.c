@@ -0,0 +1,218 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include "../include/snapshot.h"
+#include "../include/save.h"
+#include "../include/utils.h"
+#include <stdio.h>
+#include <string.h>
+
+#define SNAPSHOT_MAGIC "GRSS"
+
+typedef struct SnapshotHeader {
+    char   magic[4];
+    Uint32 version;
+    Uint32 size;        // 본문 크기
+    Uint32 crc;         // 본문 CRC32
+} SnapshotHeader;
+
+// 버전 1 본문. 필드를 바꾸면 SNAPSHOT_VERSION 을 올리고 예전 버전 읽기를 추가할 것
+typedef struct SnapshotV1 {
+    char   plant_id[32];
+    Sint64 saved_at;                // 저장한 게임 시각 (로그용)
+
+    float  moisture, temp, temp_min, temp_max;
+    float  humidity_min, humidity_max, humidity;
+    float  light, happiness, nutrition;
+
+    Sint32 room_temperature;
+    float  room_humidity;
+    Uint8  window_open, has_bug, has_mold, reserved;
+    float  bug_wait, mold_wait;
+
+    Sint32 level;
+    float  exp;
+
+    Sint32 base_tag, weather_tag;
+    Sint32 weather_event_active;
+    float  weather_event_timer, cooltime, event_wait;
+
+    Uint64 rng;
+} SnapshotV1;
+
+static SnapshotV1 s_pending;
+static bool s_hasPending = false;
+
+static bool get_snapshot_path(char* out, int outsz)
+{
+    char base[1024];
+    if (!save_get_base_dir(base, sizeof(base))) return false;
+    SDL_snprintf(out, outsz, "%ssnapshot.bin", base);
+    return true;
+}
+
+static Uint32 crc32(const void* data, size_t len)
+{
+    const Uint8* p = (const Uint8*)data;
+    Uint32 c = 0xFFFFFFFFu;
+    for (size_t i = 0; i < len; i++) {
+        c ^= p[i];
+        for (int k = 0; k < 8; k++) c = (c >> 1) ^ (0xEDB88320u & (0u - (c & 1u)));
+    }
+    return ~c;
+}
+
+static void snapshot_from_sim(SnapshotV1* s, const GrowSim* sim)
+{
+    SDL_memset(s, 0, sizeof(*s));
+    SDL_strlcpy(s->plant_id, plantdb_id(sim->plant), sizeof(s->plant_id));
+    s->saved_at = (Sint64)gameclock_time();
+
+    s->moisture = sim->status.moisture;
+    s->temp = sim->status.temp;
+    s->temp_min = sim->status.temp_min;
+    s->temp_max = sim->status.temp_max;
+    s->humidity_min = sim->status.humidity_min;
+    s->humidity_max = sim->status.humidity_max;
+    s->humidity = sim->status.humidity;
+    s->light = sim->status.light;
+    s->happiness = sim->status.happiness;
+    s->nutrition = sim->status.nutrition;
+
+    s->room_temperature = sim->room_temperature;
+    s->room_humidity = sim->room_humidity;
+    s->window_open = sim->window_open ? 1 : 0;
+    s->has_bug = sim->has_bug ? 1 : 0;
+    s->has_mold = sim->has_mold ? 1 : 0;
+    s->bug_wait = sim->bug_wait;
+    s->mold_wait = sim->mold_wait;
+
+    s->level = sim->level;
+    s->exp = sim->exp;
+
+    s->base_tag = (Sint32)sim->base_tag;
+    s->weather_tag = (Sint32)sim->weather_tag;
+    s->weather_event_active = sim->weather_event_active;
+    s->weather_event_timer = sim->weather_event_timer;
+    s->cooltime = sim->cooltime;
+    s->event_wait = sim->event_wait;
+
+    s->rng = sim->rng;
+}
+
+static void snapshot_to_sim(const SnapshotV1* s, GrowSim* sim)
+{
+    sim->status.moisture = s->moisture;
+    sim->status.temp = s->temp;
+    sim->status.temp_min = s->temp_min;
+    sim->status.temp_max = s->temp_max;
+    sim->status.humidity_min = s->humidity_min;
+    sim->status.humidity_max = s->humidity_max;
+    sim->status.humidity = s->humidity;
+    sim->status.light = s->light;
+    sim->status.happiness = s->happiness;
+    sim->status.nutrition = s->nutrition;
+
+    sim->room_temperature = s->room_temperature;
+    sim->room_humidity = s->room_humidity;
+    sim->window_open = s->window_open != 0;
+    sim->has_bug = s->has_bug != 0;
+    sim->has_mold = s->has_mold != 0;
+    sim->bug_wait = s->bug_wait;
+    sim->mold_wait = s->mold_wait;
+
+    sim->level = s->level;
+    sim->exp = s->exp;
+
+    sim->base_tag = (WeatherTag)s->base_tag;
+    sim->weather_tag = (WeatherTag)s->weather_tag;
+    sim->weather_event_active = s->weather_event_active;
+    sim->weather_event_timer = s->weather_event_timer;
+    sim->cooltime = s->cooltime;
+    sim->event_wait = s->event_wait;
+
+    if (s->rng) sim->rng = s->rng;
+}
+
+bool snapshot_save(const GrowSim* sim)
+{
+    char path[1024], tmp[1100];
+    if (!sim || !sim->plant || !get_snapshot_path(path, sizeof(path))) return false;
+    SDL_snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+
+    // 헤더 + 본문을 write 한 번으로
+    struct { SnapshotHeader h; SnapshotV1 body; } file;
+    SDL_memset(&file, 0, sizeof(file));
+    snapshot_from_sim(&file.body, sim);
+    SDL_memcpy(file.h.magic, SNAPSHOT_MAGIC, 4);
+    file.h.version = SNAPSHOT_VERSION;
+    file.h.size = (Uint32)sizeof(file.body);
+    file.h.crc = crc32(&file.body, sizeof(file.body));
+
+    FILE* fp = fopen(tmp, "wb");
+    if (!fp) return false;
+    bool ok = fwrite(&file, sizeof(file), 1, fp) == 1;
+    ok = (fclose(fp) == 0) && ok;
+
+    if (!ok || !file_replace(tmp, path)) {
+        remove(tmp);
+        SDL_Log("[SNAPSHOT] save failed: %s", path);
+        return false;
+    }
+    return true;
+}
+
+bool snapshot_load(void)
+{
+    char path[1024];
+    snapshot_discard();
+    if (!get_snapshot_path(path, sizeof(path))) return false;
+
+    FILE* fp = fopen(path, "rb");
+    if (!fp) return false;
+    struct { SnapshotHeader h; SnapshotV1 body; } file;
+    size_t got = fread(&file, 1, sizeof(file), fp);
+    fclose(fp);
+
+    if (got < sizeof(file.h) || SDL_memcmp(file.h.magic, SNAPSHOT_MAGIC, 4) != 0) {
+        SDL_Log("[SNAPSHOT] not a snapshot: %s", path);
+        return false;
+    }
+    if (file.h.version != SNAPSHOT_VERSION || file.h.size != sizeof(file.body) || got != sizeof(file)) {
+        SDL_Log("[SNAPSHOT] unsupported version %u (size %u), ignored", file.h.version, file.h.size);
+        return false;
+    }
+    if (crc32(&file.body, sizeof(file.body)) != file.h.crc) {
+        SDL_Log("[SNAPSHOT] checksum mismatch, ignored");
+        return false;
+    }
+
+    file.body.plant_id[sizeof(file.body.plant_id) - 1] = '\0';
+    s_pending = file.body;
+    s_hasPending = s_pending.plant_id[0] != '\0';
+    return s_hasPending;
+}
+
+const char* snapshot_pending_plant(void)
+{
+    return s_hasPending ? s_pending.plant_id : NULL;
+}
+
+bool snapshot_apply_pending(GrowSim* sim)
+{
+    if (!s_hasPending || !sim || !sim->plant) return false;
+    PlantId want = plantdb_lookup_id(s_pending.plant_id);
+    if (want == PLANT_ID_NONE || sim->plant->handle != want) {
+        snapshot_discard();     // 다른 식물로 시작 → 버림
+        return false;
+    }
+    snapshot_to_sim(&s_pending, sim);
+    SDL_Log("[SNAPSHOT] restored %s (level %d, saved at %lld)",
+        s_pending.plant_id, s_pending.level, (long long)s_pending.saved_at);
+    snapshot_discard();
+    return true;
+}
+
+void snapshot_discard(void)
+{
+    s_hasPending = false;
+    SDL_memset(&s_pending, 0, sizeof(s_pending));
+}
@@ -0,0 +1,387 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include "../include/stats_store.h"
+#include "../include/save.h"
+#include "../include/utils.h"
+#include <stdio.h>
+#include <string.h>
+
+#define STATS_MAGIC    "GRST"
+#define STATS_VERSION  1
+
+enum { COL_MIN = 0, COL_MAX, COL_AVG, COL_COUNT };
+
+// 해상도 한 단계 = 링 버퍼 1개 + 진행 중인 칸 누적값
+typedef struct StatsLevel {
+    int     step;           // 칸 길이(sec)
+    int     cap;
+    int     head;           // 다음에 쓸 위치
+    int     count;
+    Sint64* t;              // 칸 시작 시각
+    float*  col[STATS_CH_COUNT][COL_COUNT];
+
+    Sint64  cur_t;          // 진행 중인 칸 시작 시각 (-1 = 없음)
+    Sint32  acc_n;          // 진행 중인 칸에 들어간 샘플 수 (1초 단위)
+    double  acc_sum[STATS_CH_COUNT];
+    float   acc_min[STATS_CH_COUNT];
+    float   acc_max[STATS_CH_COUNT];
+} StatsLevel;
+
+// 파일: 헤더 + 단계마다 (StatsLevelHeader + t[count] + 열[count] x 채널 x 3), 오래된 칸부터
+typedef struct StatsFileHeader {
+    char   magic[4];
+    Uint32 version;
+    Sint32 channels;
+    Sint32 levels;
+    Sint64 last_t;
+} StatsFileHeader;
+
+typedef struct StatsLevelHeader {
+    Sint32 step;
+    Sint32 count;
+    Sint64 cur_t;
+    Sint32 acc_n;
+    Sint32 reserved;
+    double acc_sum[STATS_CH_COUNT];
+    float  acc_min[STATS_CH_COUNT];
+    float  acc_max[STATS_CH_COUNT];
+} StatsLevelHeader;
+
+static const int s_steps[STATS_RES_COUNT] = { 60, 3600, 86400 };
+static const int s_caps[STATS_RES_COUNT] = { STATS_MINUTE_CAP, STATS_HOUR_CAP, STATS_DAY_CAP };
+
+static StatsLevel s_levels[STATS_RES_COUNT];
+static void*  s_block = NULL;       // 모든 열을 한 번에 잡은 메모리
+static char   s_plant[32];
+static bool   s_open = false;
+static Sint64 s_lastT = -1;         // 저장소 기준 마지막 샘플 시각
+static Sint64 s_shift = 0;          // 게임 시각 → 저장소 시각 (시간이 뒤로 갔을 때만 커짐)
+static Uint32 s_generation = 0;
+
+static Sint64 floor_div(Sint64 a, Sint64 b)
+{
+    Sint64 q = a / b;
+    return (a % b != 0 && (a < 0) != (b < 0)) ? q - 1 : q;
+}
+
+static bool get_stats_path(const char* plant_id, char* out, int outsz)
+{
+    char logs[1024];
+    if (!plant_id || !save_get_logs_dir(logs, sizeof(logs))) return false;
+    SDL_snprintf(out, outsz, "%s/%s.stats", logs, plant_id);
+    return true;
+}
+
+// ---------- 메모리 ----------
+static bool levels_alloc(void)
+{
+    size_t total = 0;
+    for (int lv = 0; lv < STATS_RES_COUNT; lv++)
+        total += (size_t)s_caps[lv] * (sizeof(Sint64) + sizeof(float) * STATS_CH_COUNT * COL_COUNT);
+
+    s_block = SDL_malloc(total);
+    if (!s_block) return false;
+
+    Uint8* p = (Uint8*)s_block;
+    for (int lv = 0; lv < STATS_RES_COUNT; lv++) {
+        StatsLevel* L = &s_levels[lv];
+        SDL_memset(L, 0, sizeof(*L));
+        L->step = s_steps[lv];
+        L->cap = s_caps[lv];
+        L->cur_t = -1;
+        L->t = (Sint64*)p;
+        p += sizeof(Sint64) * L->cap;
+        for (int ch = 0; ch < STATS_CH_COUNT; ch++) {
+            for (int c = 0; c < COL_COUNT; c++) {
+                L->col[ch][c] = (float*)p;
+                p += sizeof(float) * L->cap;
+            }
+        }
+    }
+    return true;
+}
+
+static void levels_free(void)
+{
+    SDL_free(s_block);
+    s_block = NULL;
+    SDL_memset(s_levels, 0, sizeof(s_levels));
+}
+
+// 논리 인덱스(0 = 가장 오래된 칸) → 링 위치
+static int ring_pos(const StatsLevel* L, int k)
+{
+    int p = L->head - L->count + k;
+    return p < 0 ? p + L->cap : p;
+}
+
+// ---------- 누적/다운샘플 ----------
+static void level_feed(int lv, Sint64 t, const float* mn, const float* mx, const double* sum, Sint32 n);
+
+static void level_push(StatsLevel* L, Sint64 t, const float* mn, const float* mx, const float* avg)
+{
+    int p = L->head;
+    L->t[p] = t;
+    for (int ch = 0; ch < STATS_CH_COUNT; ch++) {
+        L->col[ch][COL_MIN][p] = mn[ch];
+        L->col[ch][COL_MAX][p] = mx[ch];
+        L->col[ch][COL_AVG][p] = avg[ch];
+    }
+    L->head = (L->head + 1) % L->cap;
+    if (L->count < L->cap) L->count++;
+}
+
+// 진행 중인 칸을 링에 넣고 다음 단계로 넘김
+static void level_close(int lv)
+{
+    StatsLevel* L = &s_levels[lv];
+    if (L->cur_t < 0 || L->acc_n <= 0) { L->cur_t = -1; return; }
+
+    float avg[STATS_CH_COUNT];
+    for (int ch = 0; ch < STATS_CH_COUNT; ch++) avg[ch] = (float)(L->acc_sum[ch] / L->acc_n);
+    level_push(L, L->cur_t, L->acc_min, L->acc_max, avg);
+
+    Sint64 t = L->cur_t;
+    L->cur_t = -1;
+    if (lv + 1 < STATS_RES_COUNT) level_feed(lv + 1, t, L->acc_min, L->acc_max, L->acc_sum, L->acc_n);
+}
+
+static void level_feed(int lv, Sint64 t, const float* mn, const float* mx, const double* sum, Sint32 n)
+{
+    StatsLevel* L = &s_levels[lv];
+    Sint64 bucket = floor_div(t, L->step) * L->step;
+
+    if (L->cur_t >= 0 && bucket != L->cur_t) level_close(lv);
+    if (L->cur_t < 0) {
+        L->cur_t = bucket;
+        L->acc_n = 0;
+    }
+
+    for (int ch = 0; ch < STATS_CH_COUNT; ch++) {
+        if (L->acc_n == 0 || mn[ch] < L->acc_min[ch]) L->acc_min[ch] = mn[ch];
+        if (L->acc_n == 0 || mx[ch] > L->acc_max[ch]) L->acc_max[ch] = mx[ch];
+        L->acc_sum[ch] = (L->acc_n == 0 ? 0.0 : L->acc_sum[ch]) + sum[ch];
+    }
+    L->acc_n += n;
+}
+
+// ---------- 파일 ----------
+static bool write_level(FILE* fp, const StatsLevel* L)
+{
+    StatsLevelHeader h;
+    SDL_memset(&h, 0, sizeof(h));
+    h.step = L->step;
+    h.count = L->count;
+    h.cur_t = L->cur_t;
+    h.acc_n = L->acc_n;
+    SDL_memcpy(h.acc_sum, L->acc_sum, sizeof(h.acc_sum));
+    SDL_memcpy(h.acc_min, L->acc_min, sizeof(h.acc_min));
+    SDL_memcpy(h.acc_max, L->acc_max, sizeof(h.acc_max));
+    if (fwrite(&h, sizeof(h), 1, fp) != 1) return false;
+
+    // 링이 한 바퀴 돌았으면 두 조각으로 나눠서 오래된 것부터
+    int first = ring_pos(L, 0);
+    int n1 = SDL_min(L->count, L->cap - first);
+    int n2 = L->count - n1;
+    if (fwrite(L->t + first, sizeof(Sint64), (size_t)n1, fp) != (size_t)n1) return false;
+    if (fwrite(L->t, sizeof(Sint64), (size_t)n2, fp) != (size_t)n2) return false;
+    for (int ch = 0; ch < STATS_CH_COUNT; ch++) {
+        for (int c = 0; c < COL_COUNT; c++) {
+            if (fwrite(L->col[ch][c] + first, sizeof(float), (size_t)n1, fp) != (size_t)n1) return false;
+            if (fwrite(L->col[ch][c], sizeof(float), (size_t)n2, fp) != (size_t)n2) return false;
+        }
+    }
+    return true;
+}
+
+static bool read_level(FILE* fp, StatsLevel* L)
+{
+    StatsLevelHeader h;
+    if (fread(&h, sizeof(h), 1, fp) != 1 || h.step != L->step || h.count < 0) return false;
+
+    // 저장된 칸이 cap 보다 많으면 (cap 을 줄인 경우) 최신 것만
+    int skip = h.count > L->cap ? h.count - L->cap : 0;
+    int n = h.count - skip;
+    long colBytes = (long)sizeof(float) * skip;
+
+    if (fseek(fp, (long)sizeof(Sint64) * skip, SEEK_CUR) != 0) return false;
+    if (fread(L->t, sizeof(Sint64), (size_t)n, fp) != (size_t)n) return false;
+    for (int ch = 0; ch < STATS_CH_COUNT; ch++) {
+        for (int c = 0; c < COL_COUNT; c++) {
+            if (fseek(fp, colBytes, SEEK_CUR) != 0) return false;
+            if (fread(L->col[ch][c], sizeof(float), (size_t)n, fp) != (size_t)n) return false;
+        }
+    }
+    L->count = n;
+    L->head = n % L->cap;
+    L->cur_t = h.cur_t;
+    L->acc_n = h.acc_n;
+    SDL_memcpy(L->acc_sum, h.acc_sum, sizeof(h.acc_sum));
+    SDL_memcpy(L->acc_min, h.acc_min, sizeof(h.acc_min));
+    SDL_memcpy(L->acc_max, h.acc_max, sizeof(h.acc_max));
+    return true;
+}
+
+static bool load_file(const char* plant_id)
+{
+    char path[1024];
+    StatsFileHeader h;
+    if (!get_stats_path(plant_id, path, sizeof(path))) return false;
+
+    FILE* fp = fopen(path, "rb");
+    if (!fp) return false;
+    bool ok = fread(&h, sizeof(h), 1, fp) == 1 &&
+        SDL_memcmp(h.magic, STATS_MAGIC, 4) == 0 &&
+        h.version == STATS_VERSION &&
+        h.channels == STATS_CH_COUNT &&
+        h.levels == STATS_RES_COUNT;
+    for (int lv = 0; ok && lv < STATS_RES_COUNT; lv++) ok = read_level(fp, &s_levels[lv]);
+    fclose(fp);
+
+    if (ok) s_lastT = h.last_t;
+    return ok;
+}
+
+bool stats_store_save(void)
+{
+    char path[1024], tmp[1100];
+    if (!s_open || !get_stats_path(s_plant, path, sizeof(path))) return false;
+    SDL_snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+
+    FILE* fp = fopen(tmp, "wb");
+    if (!fp) return false;
+
+    StatsFileHeader h;
+    SDL_memset(&h, 0, sizeof(h));
+    SDL_memcpy(h.magic, STATS_MAGIC, 4);
+    h.version = STATS_VERSION;
+    h.channels = STATS_CH_COUNT;
+    h.levels = STATS_RES_COUNT;
+    h.last_t = s_lastT;
+    bool ok = fwrite(&h, sizeof(h), 1, fp) == 1;
+    for (int lv = 0; ok && lv < STATS_RES_COUNT; lv++) ok = write_level(fp, &s_levels[lv]);
+    ok = (fclose(fp) == 0) && ok;
+
+    if (!ok || !file_replace(tmp, path)) {
+        remove(tmp);
+        SDL_Log("[STATS] save failed: %s", path);
+        return false;
+    }
+    return true;
+}
+
+// ---------- 공개 API ----------
+bool stats_store_open(const char* plant_id)
+{
+    if (!plant_id || !plant_id[0]) return false;
+    if (s_open && SDL_strcmp(s_plant, plant_id) == 0) return true;
+
+    stats_store_close();
+    if (!levels_alloc()) {
+        SDL_Log("[STATS] out of memory");
+        return false;
+    }
+    SDL_strlcpy(s_plant, plant_id, sizeof(s_plant));
+    s_lastT = -1;
+    s_shift = 0;
+    if (!load_file(plant_id)) {
+        // 없거나 깨진 파일 → 빈 저장소
+        levels_free();
+        levels_alloc();
+        s_lastT = -1;
+    }
+    s_open = true;
+    s_generation++;
+    SDL_Log("[STATS] open %s (minutes=%d hours=%d days=%d)", plant_id,
+        s_levels[STATS_RES_MINUTE].count, s_levels[STATS_RES_HOUR].count, s_levels[STATS_RES_DAY].count);
+    return true;
+}
+
+void stats_store_close(void)
+{
+    if (!s_open) return;
+    stats_store_save();
+    levels_free();
+    s_plant[0] = '\0';
+    s_open = false;
+    s_lastT = -1;
+    s_shift = 0;
+    s_generation++;
+}
+
+const char* stats_store_plant(void)
+{
+    return s_open ? s_plant : NULL;
+}
+
+void stats_store_sample(Sint64 t, const float values[STATS_CH_COUNT])
+{
+    if (!s_open || !values) return;
+
+    // 게임을 다시 켜면 게임 시계가 저장된 마지막 샘플보다 이전일 수 있음 → 이어 붙임
+    t += s_shift;
+    if (s_lastT >= 0 && t < s_lastT) {
+        s_shift += s_lastT - t;
+        t = s_lastT;
+    }
+    s_lastT = t;
+
+    double sum[STATS_CH_COUNT];
+    for (int ch = 0; ch < STATS_CH_COUNT; ch++) sum[ch] = values[ch];
+    level_feed(STATS_RES_MINUTE, t, values, values, sum, 1);
+    s_generation++;
+}
+
+int stats_store_step(StatsResolution res)
+{
+    return (res >= 0 && res < STATS_RES_COUNT) ? s_steps[res] : 0;
+}
+
+Sint64 stats_store_latest(void)
+{
+    return s_open ? s_lastT : -1;
+}
+
+Uint32 stats_store_generation(void)
+{
+    return s_generation;
+}
+
+int stats_store_query(StatsResolution res, StatsChannel ch, Sint64 from, Sint64 to,
+                      Sint64* t, float* mn, float* mx, float* avg, int max)
+{
+    if (!s_open || res < 0 || res >= STATS_RES_COUNT || ch < 0 || ch >= STATS_CH_COUNT || max <= 0 || from > to)
+        return 0;
+    const StatsLevel* L = &s_levels[res];
+
+    // 시간 순서라 이분 탐색으로 시작 칸을 찾음
+    int lo = 0, hi = L->count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (L->t[ring_pos(L, mid)] < from) lo = mid + 1;
+        else hi = mid;
+    }
+
+    const float* cmn = L->col[ch][COL_MIN];
+    const float* cmx = L->col[ch][COL_MAX];
+    const float* cav = L->col[ch][COL_AVG];
+    int n = 0;
+    for (int k = lo; k < L->count && n < max; k++) {
+        int p = ring_pos(L, k);
+        if (L->t[p] > to) break;
+        if (t) t[n] = L->t[p];
+        if (mn) mn[n] = cmn[p];
+        if (mx) mx[n] = cmx[p];
+        if (avg) avg[n] = cav[p];
+        n++;
+    }
+
+    // 진행 중인 칸
+    if (n < max && L->cur_t >= from && L->cur_t <= to && L->acc_n > 0) {
+        if (t) t[n] = L->cur_t;
+        if (mn) mn[n] = L->acc_min[ch];
+        if (mx) mx[n] = L->acc_max[ch];
+        if (avg) avg[n] = (float)(L->acc_sum[ch] / L->acc_n);
+        n++;
+    }
+    return n;
+}
@@ -0,0 +1,57 @@
+#ifndef ATLAS_H
+#define ATLAS_H
+#include <stdbool.h>
+#include "common.h"
+
+// 여러 장짜리 아틀라스
+// 애니메이션 시트(9600x270, 5280x2970 ...)가 렌더러의 최대 텍스처 크기(SDL_RendererInfo.max_texture_width)를
+// 넘으면 로드할 때 프레임 단위로 잘라 한도 안의 페이지 여러 장에 다시 채워 넣는다.
+// 프레임은 항상 한 페이지 안에 통째로 들어가므로 atlas_frame 으로 (페이지, 사각형)을 받아 RenderCopy 한 번.
+// 한도 안이면 원본 배치 그대로 한 장 (복사 없음).
+// 효과 시트처럼 대부분 투명한 시트는 atlas_layout_build_trimmed 로 프레임마다 불투명 영역만 남기고
+// 같은 프레임은 한 번만 담는다. 그릴 때는 atlas_draw_frame 이 잘린 위치(오프셋)를 되살림.
+
+#define ATLAS_MAX_PAGES  8
+#define ATLAS_MAX_FRAMES 128
+
+// 프레임 → (페이지, 페이지 안 사각형). 렌더러 한도와 프레임 사각형만으로 정해짐 (같은 배치의 시트끼리 공유 가능)
+typedef struct AtlasLayout {
+    int      frame_count;
+    int      page_count;
+    bool     identity;                  // 원본 좌표 그대로 한 장
+    bool     trimmed;                   // 투명 테두리를 잘라 냄 (atlas_draw_frame 으로 그릴 것)
+    int      page_w[ATLAS_MAX_PAGES], page_h[ATLAS_MAX_PAGES];
+    Uint8    page[ATLAS_MAX_FRAMES];
+    SDL_Rect src[ATLAS_MAX_FRAMES];     // 원본 시트 좌표
+    SDL_Rect dst[ATLAS_MAX_FRAMES];     // 페이지 좌표
+    SDL_Rect trim[ATLAS_MAX_FRAMES];    // 프레임 안에서 남긴 영역 (w == 0 이면 전부 투명)
+    Sint16   same_as[ATLAS_MAX_FRAMES]; // 픽셀이 같은 앞 프레임 (-1 이면 자기 것)
+} AtlasLayout;
+
+typedef struct AtlasPages {
+    const AtlasLayout* layout;          // 빌려 씀 (페이지보다 오래 살아야 함)
+    int          count;
+    SDL_Texture* tex[ATLAS_MAX_PAGES];
+} AtlasPages;
+
+// 렌더러가 만들 수 있는 최대 텍스처 크기 (모르면 0)
+void atlas_max_texture_size(SDL_Renderer* r, int* max_w, int* max_h);
+// 프레임 배치 계산. max_w/max_h 가 0 이면 한도 없음. 한 프레임이 한도보다 크거나 페이지가 모자라면 false
+bool atlas_layout_build(const SDL_Rect* frames, int n, int max_w, int max_h, AtlasLayout* out);
+// 위와 같지만 sheet 픽셀을 보고 투명 테두리를 자르고 같은 프레임을 합침 (항상 다시 채움)
+bool atlas_layout_build_trimmed(SDL_Surface* sheet, const SDL_Rect* frames, int n, int max_w, int max_h, AtlasLayout* out);
+// 파일 읽기 + 잘라 낸 배치 + 업로드 한 번에 (메인 스레드). 시트 밖 프레임은 빈 프레임
+bool atlas_load_trimmed(SDL_Renderer* r, const char* path, const SDL_Rect* frames, int n, AtlasLayout* layout, AtlasPages* out);
+
+// 한 페이지 표면 만들기 (CPU 복사만 → 작업 스레드에서도 사용). identity 면 sheet 를 그대로 돌려줌 (*owned = false)
+SDL_Surface* atlas_pack_page(SDL_Surface* sheet, const AtlasLayout* l, int page, bool* owned);
+// sheet → 페이지 텍스처들 (메인 스레드). 실패한 페이지가 있으면 전부 정리하고 false
+bool atlas_upload(SDL_Renderer* r, SDL_Surface* sheet, const AtlasLayout* l, AtlasPages* out);
+void atlas_free(AtlasPages* a);
+
+// i 번 프레임이 들어 있는 페이지 텍스처와 그 안의 사각형. 없으면 NULL
+SDL_Texture* atlas_frame(const AtlasPages* a, int i, SDL_Rect* src);
+// i 번 프레임 전체가 dst 에 맞게 그림. 잘린 레이아웃이면 남은 영역만 그 자리에 (블렌딩 면적이 줄어듦)
+void atlas_draw_frame(SDL_Renderer* r, const AtlasPages* a, int i, const SDL_Rect* dst);
+
+#endif
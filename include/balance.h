@@ -0,0 +1,9 @@
+#ifndef BALANCE_H
+#define BALANCE_H
+
+// 헤드리스 밸런스 시뮬레이터 (GROWING.exe --balance ...)
+// core/sim.c 로 식물 일생을 N번 돌려서 레벨업 시간/행복도/방치 이벤트 분포를 출력
+// 사용법은 balance_main 의 --help 참고
+int balance_main(int argc, char** argv);
+
+#endif
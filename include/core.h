@@ -3,17 +3,19 @@
 #include "common.h"
 
 // 이후 plant/sim/stats/save 등을 여기에서 한 번에 include 예정
-#endif
 
 // plant_db
+// 식물 id 를 인터닝한 정수 핸들. 같은 id 는 프로세스 안에서 항상 같은 값 (0 = 없음)
+typedef int PlantId;
+#define PLANT_ID_NONE 0
+
+// 카탈로그 한 줄. 스캔/시뮬레이션이 읽는 숫자만 들고 있고 (약 50바이트),
+// id 와 글자는 plantdb_id/plantdb_name/plantdb_latin/plantdb_icon 으로 꺼냄
 typedef struct {
-    char id[32];
-    char name_kr[64];
-    char latin[64];
+    PlantId handle;       // plantdb_intern(id)
     int  light_level;     // 0(약)~2(강)
     int  water_days;      // 권장 급수 주기(일)
     int  min_temp, max_temp;
-    char icon_path[128];  // 아이콘(선택)
 
     float moisture_opt;
     float temp_min;
@@ -21,6 +23,8 @@ typedef struct {
 
     float humidity_min;
     float humidity_max;
+
+    Uint32 name_off, latin_off, icon_off;   // 문자열 풀 오프셋 (0 = 빈 문자열)
 } PlantInfo;
 
 typedef struct PlantStatus {
@@ -37,10 +41,24 @@ typedef struct PlantStatus {
     float nutrition;   // 영양 (0~100)
 } PlantStatus;
 
+// 카탈로그는 시작할 때 한 번 읽음. 같은 파일을 다시 부르면 바뀌지 않은 한 JSON 작업 없이 개수만 돌려줌.
+// 다시 읽어도 인덱스와 const PlantInfo* 는 그대로 유효 (있던 id 는 제자리 갱신, 새 id 는 뒤에 추가)
 int       plantdb_load(const char* json_path);  // returns count or -1
+int       plantdb_reload_if_changed(void);      // 매 프레임 호출 가능 (1초마다 mtime 확인), 다시 읽었으면 1
+Uint32    plantdb_generation(void);             // 내용이 바뀔 때마다 +1
 void      plantdb_free(void);
 int       plantdb_count(void);
-int plantdb_find_index_by_id(const char* id);
+int plantdb_find_index_by_id(const char* id);  // O(1) 해시 조회, 없으면 -1
 const PlantInfo* plantdb_get(int idx);
+// id 인터닝: 다른 모듈은 문자열 대신 핸들로 식물을 비교
+PlantId     plantdb_intern(const char* id);     // 없으면 새로 등록
+PlantId     plantdb_lookup_id(const char* id);  // 등록 안 됐으면 PLANT_ID_NONE
+const char* plantdb_id_str(PlantId h);
+int         plantdb_find_index(PlantId h);      // 현재 DB 인덱스, 없으면 -1
+// 글자 필드 (NULL 이면 ""). 돌려준 포인터는 plantdb_free 전까지 유효 (id 는 바로 쓰거나 복사)
+const char* plantdb_id(const PlantInfo* p);
+const char* plantdb_name(const PlantInfo* p);
+const char* plantdb_latin(const PlantInfo* p);
+const char* plantdb_icon(const PlantInfo* p);
 
-extern PlantStatus s_status;
\ No newline at end of file
+#endif
@@ -0,0 +1,67 @@
+#ifndef JOURNAL_H
+#define JOURNAL_H
+#include <stdbool.h>
+#include <SDL2/SDL.h>
+#include <parson.h>
+
+// 식물별 이벤트 저널 (logs/<id>.jsonl)
+// 스레드 안전하지 않음: save.c 의 I/O 락을 잡은 상태에서만 호출.
+// 파일에 쓰는 함수(journal_append_many, journal_save_indexes)는 그 락을 받아서 write 하는 동안만 풀어 둔다
+// → 도감/통계 씬의 읽기가 디스크 쓰기를 기다리지 않음. 읽기는 반영이 끝난 크기까지만 본다.
+// 1줄 = JSON 객체 1개 (JSON Lines). 추가는 파일 끝에 한 줄 write 만 한다.
+//
+//   {"journal":"growing","version":1,"plant_id":"monstera"}      ← 헤더 (첫 줄)
+//   {"ts":"2025-01-01 12:00","event":"water","amount_ml":120}    ← 기록
+//   #checkpoint {"checkpoint":256,"water":200,"sun":0,"stage":1,"window":55,"last_stage":"Lv2"}
+//
+// 체크포인트는 JOURNAL_CHECKPOINT_EVERY 개 기록마다 자동으로 들어가며,
+// 파일을 다시 열 때 끝부분에서 JOURNAL_CHECKPOINT_TAG 로 시작하는 마지막 줄을 찾아 누적값을 복원한다.
+// (키 순서 같은 직렬화 방식에 기대지 않도록 줄 머리를 저널이 직접 붙임. 기록 줄은 항상 '{' 로 시작)
+// 버전 1 파일의 태그 없는 {"checkpoint":...} 줄도 읽을 때는 건너뜀 (이런 파일은 처음 열 때 전체를 한 번 훑음).
+// 예전 logs/<id>.json (history 배열) 은 처음 열 때 자동으로 옮기고 .json.migrated 로 남겨둠.
+
+#define JOURNAL_VERSION           2
+#define JOURNAL_CHECKPOINT_TAG    "#checkpoint "
+#define JOURNAL_CHECKPOINT_EVERY  256
+
+typedef enum {
+    JOURNAL_EV_WATER = 0,
+    JOURNAL_EV_SUN,
+    JOURNAL_EV_STAGE,
+    JOURNAL_EV_WINDOW,
+    JOURNAL_EV_OTHER,
+    JOURNAL_EV_COUNT
+} JournalEventType;
+
+// 누적 요약 (체크포인트 내용과 같음)
+typedef struct JournalSummary {
+    int  records;                    // 기록 수 (헤더/체크포인트 제외)
+    int  counts[JOURNAL_EV_COUNT];
+    char last_stage[32];
+} JournalSummary;
+
+// 같은 식물의 기록 여러 개를 한 번에 (write 1회). entry: "ts","event" 및 부가 필드를 가진 객체.
+// io_lock 을 잡은 채로 부르고, 파일에 쓰는 동안만 풀었다가 다시 잡고 돌아온다 (NULL 이면 풀지 않음)
+bool journal_append_many(const char* plant_id, const JSON_Value* const* entries, int n, SDL_mutex* io_lock);
+// 메모리에서 바뀐 오프셋 인덱스를 logs/<id>.idx 에 반영 (I/O 스레드, 락 약속은 위와 같음)
+void journal_save_indexes(SDL_mutex* io_lock);
+
+// 기록을 처음부터 순서대로 방문. fn 이 false 를 리턴하면 중단. 반환: 방문한 기록 수
+typedef bool (*JournalVisitFn)(const JSON_Object* entry, void* user);
+int  journal_read(const char* plant_id, JournalVisitFn fn, void* user);
+
+// 기록 first 번째(0 = 가장 오래된 것)부터 count 개를 순서대로 방문.
+// logs/<id>.idx 오프셋 인덱스로 바로 seek (인덱스가 없거나 안 맞으면 메모리에서 한 번 다시 만듦)
+int  journal_read_range(const char* plant_id, int first, int count, JournalVisitFn fn, void* user);
+int  journal_record_count(const char* plant_id);
+
+// 저널을 열어(필요하면 마이그레이션) 누적 요약을 얻음
+bool journal_get_summary(const char* plant_id, JournalSummary* out);
+
+JournalEventType journal_event_type(const char* event);
+bool journal_get_path(const char* plant_id, char* out, int outsz);
+
+// 캐시된 저널 상태 비우기 (게임 종료/세이브 삭제 시)
+void journal_reset_cache(void);
+
+#endif
@@ -0,0 +1,61 @@
+#ifndef PLANT_BLOB_H
+#define PLANT_BLOB_H
+#include <stdbool.h>
+#include "common.h"
+
+// 미리 컴파일한 식물 카탈로그 (plants.json → plants.bin)
+// JSON 이 원본. 바이너리에는 만들 때의 JSON 크기/수정 시각/내용 해시를 적어 두고,
+// 다르면 plantdb_load 가 JSON 을 다시 컴파일해 덮어쓴다 (오프라인: GROWING --compile-catalog).
+//
+// 파일 = PlantBlobHeader + PlantBlobRecord[count] + id 해시 표 + 문자열 표
+// 한 번의 read 로 버퍼에 올리고 그대로 씀 (문자열 표는 복사 없이 plantdb 문자열 풀이 됨).
+// 모든 오프셋은 파일 처음 기준이 아니라 각 표 처음 기준.
+
+#define PLANTBLOB_MAGIC   "GRPC"
+#define PLANTBLOB_VERSION 1
+#define PLANTBLOB_STRINGS_MAX (1u << 24)    // 문자열 표 최대 크기 (plantdb 풀 오프셋 24비트)
+
+typedef struct PlantBlobHeader {
+    char   magic[4];
+    Uint32 version;
+    Uint32 count;           // 레코드 수 (id 중복 제거 후)
+    Uint32 hash_cap;        // id 해시 칸 수 (2의 거듭제곱, 칸마다 레코드 번호 + 1, 0 = 빈 칸)
+    Uint32 records_off, hash_off, strings_off, strings_size;
+    Uint32 total_size;
+    Uint32 crc;             // 헤더 뒤 전체 CRC32
+    Sint64 src_mtime, src_size;
+    Uint32 src_hash;        // plants.json 내용 FNV-1a
+    Uint32 reserved;
+} PlantBlobHeader;
+
+typedef struct PlantBlobRecord {
+    Uint32 id, name_kr, latin, icon;    // 문자열 표 오프셋 (0 = 빈 문자열)
+    Sint32 light_level, water_days, min_temp, max_temp;
+    float  moisture_opt, temp_min, temp_max;
+    float  humidity_min, humidity_max;
+} PlantBlobRecord;
+
+Uint32 plantblob_hash(const void* data, size_t len);   // FNV-1a
+bool   plantblob_stat(const char* path, Sint64* mtime, Sint64* size);
+char*  plantblob_read_text(const char* path, Uint32* hash);   // 파일 전체 + FNV-1a (SDL_free)
+
+// JSON 문자열 → 바이너리 버퍼 (SDL_free). 실패하면 NULL
+Uint8* plantblob_compile(const char* json_text, Uint32 src_hash, Sint64 src_mtime, Sint64 src_size,
+    Uint32* out_size);
+
+// 파일 전체를 한 번에 읽고 검사. 없거나 깨졌으면 NULL (버퍼는 SDL_free)
+Uint8* plantblob_read(const char* path, Uint32* out_size);
+bool   plantblob_write(const char* path, const Uint8* blob, Uint32 size);
+bool   plantblob_check(const Uint8* blob, Uint32 size);
+
+const PlantBlobRecord* plantblob_records(const Uint8* blob);
+const char* plantblob_str(const Uint8* blob, Uint32 off);
+int    plantblob_find(const Uint8* blob, const char* id);  // 레코드 번호, 없으면 -1
+
+// "assets/plants.json" → "assets/plants.bin"
+void   plantblob_path_for(const char* json_path, char* out, int outsz);
+
+// 오프라인 컴파일 도구 (GROWING.exe --compile-catalog [plants.json] [plants.bin])
+int    plantblob_main(int argc, char** argv);
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef PLANT_SEARCH_H
+#define PLANT_SEARCH_H
+#include "common.h"
+
+// 식물 검색 색인 (한글 이름 / 초성 / 학명 / id)
+// 글자는 모두 자모 단위로 풀어서 비교 → 조합 중인 글자("몬ㅅ")도 그대로 찾아짐.
+// 자음만 입력하면 초성 검색 ("ㅁㅅㅌㄹ" → 몬스테라).
+//
+// 색인 = 자모 2-gram → 식물 목록 + 모든 키를 정렬한 접두 배열 (한 글자 질의용).
+// 질의가 앞 질의를 늘린 것이면 앞 결과만 다시 거르고, 지우면 쌓아 둔 결과로 돌아감.
+// 카탈로그 세대(plantdb_generation)가 바뀌면 다음 질의 때 다시 만든다.
+
+#define PLANT_SEARCH_QUERY_MAX 64   // 자모 단위 질의 길이
+
+// 상위 max 개의 plantdb 인덱스 (점수 순). 빈 질의면 0
+int  plant_search_query(const char* utf8, int* out, int max);    // max 는 최대 256
+int  plant_search_match_count(void);    // 마지막 질의에 걸린 전체 개수
+void plant_search_prepare(void);        // 색인이 없거나 카탈로그가 바뀌었으면 지금 만듦 (씬 진입 때)
+void plant_search_rebuild(void);
+void plant_search_free(void);
+
+#endif
@@ -0,0 +1,67 @@
+#ifndef ROLLUP_H
+#define ROLLUP_H
+#include <stdbool.h>
+#include <SDL2/SDL.h>
+#include <parson.h>
+#include "journal.h"
+
+// 식물별 일/주 단위 누적 집계 (logs/<id>.agg)
+// 스레드 안전하지 않음: journal 과 마찬가지로 save.c 의 I/O 락을 잡은 상태에서만 호출
+//
+// journal_append_many 가 기록을 붙일 때마다 메모리에서 해당 일/주 칸만 갱신하고,
+// I/O 스레드가 rollup_save 로 바뀐 칸만 파일에 덮어쓴다 (파일에 쓰는 동안은 락을 풀어 둠).
+// → "최근 7일 물 준 양" 같은 질의가 기록 수가 아니라 일 수에 비례.
+// 파일이 없거나 저널 기록 수와 안 맞으면 질의는 다시 만들기를 요청만 하고 지금 값(비었거나 일부)을 돌려주며,
+// I/O 스레드가 rollup_rebuild_pending 으로 저널을 조금씩 읽어 다시 만든다 (프레임 스레드에서는 저널 전체를 읽지 않음).
+// 수동 재생성: GROWING.exe --rebuild-rollups [plant_id ...]
+
+#define ROLLUP_VERSION 1
+
+typedef enum {
+    ROLLUP_DAY = 0,     // key = 1970-01-01 부터 일 수 (게임 시계 기준 현지 날짜)
+    ROLLUP_WEEK = 1     // key = 월요일 시작 주 번호
+} RollupKind;
+
+typedef struct RollupStat {
+    Sint32 count;
+    Sint32 sum;
+    Sint32 min, max;    // count == 0 이면 의미 없음
+} RollupStat;
+
+typedef struct RollupBucket {
+    Sint32 key;
+    Sint32 kind;                        // RollupKind
+    Sint32 events[JOURNAL_EV_COUNT];    // 이벤트 종류별 횟수
+    RollupStat water_ml;                // water.amount_ml
+    RollupStat sun_min;                 // sun.minutes
+    RollupStat sun_ppfd;                // sun.ppfd
+    Sint32 window_open_min;             // 창문이 열려 있던 분 (닫힐 때 날짜별로 나눠 더함)
+} RollupBucket;
+
+// 저널에 방금 붙인 기록들을 반영 (메모리만). journal_records = 붙인 뒤의 저널 기록 수
+bool rollup_append(const char* plant_id, const JSON_Value* const* entries, int n, int journal_records);
+// 바뀐 칸을 logs/<id>.agg 에 씀. io_lock 을 잡은 채로 부르면 쓰는 동안만 풀었다가 다시 잡음 (NULL 이면 안 풂)
+bool rollup_save(SDL_mutex* io_lock);
+// 질의가 다시 만들기를 요청한 식물이 있는지 (save.c 가 I/O 스레드를 깨울 때)
+bool rollup_rebuild_wanted(void);
+// 요청된 식물을 저널에서 다시 만듦 (I/O 스레드). io_lock 을 잡은 채로 부르면 저널을 조금씩 읽는 사이사이 풂
+void rollup_rebuild_pending(SDL_mutex* io_lock);
+
+// [from, to] 범위(key 기준, 양끝 포함)의 칸을 key 순서로 최대 max 개. 기록 없는 날은 빠짐
+int  rollup_query(const char* plant_id, RollupKind kind, int from, int to, RollupBucket* out, int max);
+// 같은 범위를 하나로 합친 값 (out->key = from)
+bool rollup_total(const char* plant_id, RollupKind kind, int from, int to, RollupBucket* out);
+
+// 저널을 처음부터 읽어 logs/<id>.agg 를 다시 만든다
+bool rollup_rebuild(const char* plant_id);
+
+// "YYYY-MM-DD HH:MM" → 일 번호 (실패 시 false). minute_of_day 는 NULL 가능
+bool rollup_day_from_ts(const char* ts, int* day, int* minute_of_day);
+int  rollup_week_of_day(int day);
+
+void rollup_reset_cache(void);
+
+// 재생성 도구 (GROWING.exe --rebuild-rollups ...)
+int  rollup_main(int argc, char** argv);
+
+#endif
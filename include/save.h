@@ -1,5 +1,12 @@
 #pragma once
 #include <stdbool.h>
+#include <SDL2/SDL.h>
+#include "rollup.h"
+
+// 저장 서비스: 해금 목록/새 기록은 메모리에서 처리하고 파일 쓰기는 I/O 스레드가 모아서 함
+bool save_init(void);        // 시작 시 1회 (안 불러도 첫 사용 때 초기화됨)
+void save_flush(void);       // 지금까지 요청된 쓰기가 파일에 반영될 때까지 대기
+void save_shutdown(void);    // flush 후 I/O 스레드 종료
 
 // 도감 해금
 bool save_is_plant_completed(const char* plant_id);     // 도감 씬에서 사용
@@ -19,3 +26,20 @@ typedef struct {
 
 // 도감에서 로그 읽어오기 (이미 구현했다면 그대로 사용)
 int save_get_plant_logs(const char* plant_id, CodexLog* out, int max);
+// 최신 기록부터 skip 개 건너뛰고 최대 max 개 (최신순). 페이지 단위 읽기용
+int save_get_recent_plant_logs(const char* plant_id, int skip, CodexLog* out, int max);
+// 전체 기록 수 (아직 파일에 안 쓴 것 포함). 스크롤 리스트 길이용
+int save_get_plant_log_count(const char* plant_id);
+// 기록이 추가될 때마다 바뀜. 읽은 결과를 캐시할 때 비교용
+Uint32 save_logs_generation(void);
+
+// 일/주 집계 (core/rollup.c). kind = ROLLUP_DAY/ROLLUP_WEEK, [from, to] 는 일/주 번호
+// 아직 I/O 스레드 큐에 있는 기록은 파일에 쓰인 뒤 반영됨
+// .agg 가 없거나 저널과 안 맞으면 I/O 스레드가 다시 만드는 동안은 비었거나 일부만 돌려줌 (기다리지 않음)
+int  save_get_rollup(const char* plant_id, RollupKind kind, int from, int to, RollupBucket* out, int max);
+bool save_get_rollup_total(const char* plant_id, RollupKind kind, int from, int to, RollupBucket* out);
+
+// <PrefPath>/logs 폴더 경로 (없으면 만듦). core/journal.c 에서 사용
+bool save_get_logs_dir(char* out, int outsz);
+// <PrefPath> (끝에 경로 구분자 포함)
+bool save_get_base_dir(char* out, int outsz);
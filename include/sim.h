@@ -0,0 +1,93 @@
+#ifndef SIM_H
+#define SIM_H
+#include <SDL2/SDL.h>
+#include <stdbool.h>
+#include "core.h"
+#include "weather.h"
+
+// 액션별 경험치 기본값 🐥
+#define EXP_WATER 1.0f
+#define EXP_KILL_BUG 10.0f
+#define EXP_REMOVE_MOLD 12.0f
+#define EXP_GIVE_FERT 5.0f
+#define EXP_TEMP_DOWN 3.0f
+#define EXP_TEMP_UP 3.0f
+
+// 밸런스 조정용 수치 (기본값 = 실제 게임 값)
+typedef struct SimParams {
+    float bug_chance_per_sec;      // 벌레 발생 확률(초당)
+    float mold_chance_per_sec;     // 곰팡이 발생 확률(초당)
+    float event_chance_per_sec;    // 랜덤 날씨 이벤트 확률(초당)
+    float event_cooltime;          // 이벤트 종료 후 쿨타임(sec)
+    float nutrition_per_min;       // 영양 감소(분당)
+} SimParams;
+
+// SDL/렌더링 없이 돌아가는 식물 상태 한 벌
+// scene_game.c 와 밸런스 시뮬레이터(utils/balance.c)가 같이 사용
+typedef struct GrowSim {
+    const PlantInfo* plant;
+    SimParams params;
+
+    PlantStatus status;
+    int   room_temperature;
+    float room_humidity;
+    bool  window_open;
+    bool  has_bug;
+    bool  has_mold;
+    float bug_wait;          // 다음 벌레 발생까지 남은 시간(sec)
+    float mold_wait;         // 다음 곰팡이 발생까지 남은 시간(sec)
+
+    int   level;
+    float exp;
+
+    // 날씨: base_tag = 실제 날씨, weather_tag = 이벤트 반영된 현재 날씨
+    WeatherTag base_tag;
+    WeatherTag weather_tag;
+    int   weather_event_active;
+    float weather_event_timer;
+    float cooltime;
+    float event_wait;        // 다음 날씨 이벤트까지 남은 시간(sec)
+    WeatherTag next_tag;     // 예보로 예약된 실제 날씨 (UNKNOWN = 예약 없음)
+    float next_tag_in;       // 예약까지 남은 시간(sec)
+
+    // 바깥 날씨 (예보 보간값). outdoor_known 이 false 면 방에 영향 없음 (밸런스 시뮬레이터)
+    bool  outdoor_known;
+    float outdoor_temp;
+    float outdoor_humidity;
+    float room_temp_drift;   // room_temperature 가 정수라 1도가 될 때까지 모아 둠
+
+    // update_status() 결과
+    bool moisture_ok;
+    bool temp_ok;
+    bool humidity_ok;
+    bool nutrition_ok;
+
+    Uint64 rng;
+} GrowSim;
+
+void  sim_default_params(SimParams* out);
+void  sim_init(GrowSim* sim, const PlantInfo* plant, const SimParams* params, Uint64 seed);
+void  sim_reset_status(GrowSim* sim);           // 씬 진입 시 상태값만 초기화
+void  sim_set_weather(GrowSim* sim, WeatherTag real_tag);
+// in_sec 초(게임 시간) 뒤에 실제 날씨를 tag 로 (sim_step 안에서 정확한 시점에 바뀜). 다시 부르면 덮어씀
+void  sim_schedule_weather(GrowSim* sim, WeatherTag tag, float in_sec);
+// 바깥 온도/습도. 창문이 열려 있으면 방이 천천히 따라감
+void  sim_set_outdoor(GrowSim* sim, float temp, float humidity);
+
+// dt(sec)만큼 진행. 이벤트/상태 변화 포함
+void  sim_step(GrowSim* sim, float dt);
+
+float sim_rand01(GrowSim* sim);
+float sim_exp_multiplier(const GrowSim* sim);
+int   sim_add_exp(GrowSim* sim, float base_exp); // 반환: 오른 레벨 수
+
+// 플레이어 액션 (버튼 콜백과 동일한 효과)
+int   sim_action_water(GrowSim* sim);
+bool  sim_action_kill_bug(GrowSim* sim);         // 벌레가 없으면 false
+bool  sim_action_remove_mold(GrowSim* sim);      // 곰팡이가 없으면 false
+int   sim_action_temp_down(GrowSim* sim);
+int   sim_action_temp_up(GrowSim* sim);
+int   sim_action_fertilize(GrowSim* sim);
+void  sim_action_toggle_window(GrowSim* sim);
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+#include <stdbool.h>
+#include "sim.h"
+
+// 게임 진행 상태 스냅샷 (<PrefPath>/snapshot.bin)
+// 게임 화면이 주기적으로/나갈 때 GrowSim 상태를 통째로 저장하고, 메인 메뉴 "이어하기"에서
+// 한 번 읽어 두었다가 게임 화면 init 에서 그대로 덮어쓴다 (기본값으로 다시 만들지 않음).
+//
+// 파일 = SnapshotHeader(매직, 버전, 크기, CRC32) + 버전별 고정 크기 본문.
+// 쓰기는 snapshot.bin.tmp 에 쓰고 rename → 도중에 꺼져도 이전 스냅샷이 남음.
+// 버전/크기/CRC 가 안 맞으면 무시하고 기본값으로 시작.
+
+#define SNAPSHOT_VERSION 1
+
+bool snapshot_save(const GrowSim* sim);
+
+// 이어하기: 파일을 읽어 대기 상태로 둠. 실패하면 false
+bool snapshot_load(void);
+const char* snapshot_pending_plant(void);   // 대기 중인 스냅샷의 식물 id (없으면 NULL)
+// 대기 중인 스냅샷이 sim->plant 와 같은 식물이면 적용하고 비움
+bool snapshot_apply_pending(GrowSim* sim);
+void snapshot_discard(void);
+
+#endif
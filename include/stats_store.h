@@ -0,0 +1,52 @@
+#ifndef STATS_STORE_H
+#define STATS_STORE_H
+#include <stdbool.h>
+#include <SDL2/SDL.h>
+
+// 통계 화면용 시계열 저장소 (core/stats_store.c)
+// sim 상태값을 게임 시간 1초 단위로 받아서 분/시/일 단위 칸으로 줄여 링 버퍼에 쌓는다.
+// 칸 = (시각, 채널별 최소/최대/평균). 열(column) 단위 배열이라 차트가 한 채널만 훑어도 됨.
+//
+//   분 칸 STATS_MINUTE_CAP 개 (48시간) → 다 찬 분 칸이 시 칸으로, 시 칸이 일 칸으로 합쳐짐
+//   시 칸 STATS_HOUR_CAP   개 (120일)
+//   일 칸 STATS_DAY_CAP    개 (10년)
+// 전체 약 0.5MB. 열린 식물 1개만 메모리에 두고 logs/<id>.stats 로 저장/복원.
+// 메인 스레드 전용.
+
+#define STATS_MINUTE_CAP  (60 * 48)
+#define STATS_HOUR_CAP    (24 * 120)
+#define STATS_DAY_CAP     (365 * 10)
+
+typedef enum {
+    STATS_CH_MOISTURE = 0,
+    STATS_CH_TEMP,
+    STATS_CH_HUMIDITY,
+    STATS_CH_HAPPINESS,
+    STATS_CH_COUNT
+} StatsChannel;
+
+typedef enum {
+    STATS_RES_MINUTE = 0,
+    STATS_RES_HOUR,
+    STATS_RES_DAY,
+    STATS_RES_COUNT
+} StatsResolution;
+
+bool   stats_store_open(const char* plant_id);  // 다른 식물이 열려 있으면 저장하고 바꿈
+void   stats_store_close(void);                 // 저장 후 비움
+bool   stats_store_save(void);
+const char* stats_store_plant(void);            // 열린 식물 id (없으면 NULL)
+
+// t = 게임 시각(초). 시간이 뒤로 가면(게임 재시작 등) 이어지도록 내부에서 밀어서 씀
+void   stats_store_sample(Sint64 t, const float values[STATS_CH_COUNT]);
+
+int    stats_store_step(StatsResolution res);   // 칸 길이(sec)
+Sint64 stats_store_latest(void);                // 마지막 샘플 시각 (저장소 기준), 없으면 -1
+Uint32 stats_store_generation(void);            // 샘플이 들어올 때마다 바뀜 (차트 캐시 비교용)
+
+// [from, to] 범위 칸을 시간 순서로 최대 max 개. 진행 중인 칸도 마지막에 포함.
+// mn/mx/avg 는 NULL 가능. 반환: 채운 개수
+int    stats_store_query(StatsResolution res, StatsChannel ch, Sint64 from, Sint64 to,
+                         Sint64* t, float* mn, float* mx, float* avg, int max);
+
+#endif
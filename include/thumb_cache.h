@@ -0,0 +1,32 @@
+#ifndef THUMB_CACHE_H
+#define THUMB_CACHE_H
+#include <stdbool.h>
+#include "common.h"
+#include "atlas.h"
+
+// 썸네일 스트리밍 캐시
+// 요청한 이미지를 작업 스레드가 IMG_Load 로 풀고, 메인 스레드가 thumb_cache_pump 에서
+// 텍스처로 올린다 (SDL 렌더러는 메인 스레드 전용). 준비 전에는 thumb_cache_get 이 NULL.
+// 상주 개수는 capacity 로 고정, 꽉 차면 가장 오래 안 쓴 것부터 버림 (LRU).
+
+#define THUMB_CACHE_DEFAULT_CAP 48
+
+enum { THUMB_PRIO_VISIBLE = 0, THUMB_PRIO_PREFETCH = 1 };
+
+bool thumb_cache_init(int capacity);
+void thumb_cache_shutdown(void);            // 작업 스레드 종료 + 텍스처 정리
+
+// 디코드 요청 (이미 있으면 우선순위만 올리고 사용 시각 갱신)
+void thumb_cache_request(const char* path, int priority);
+// 큰 시트용: layout 대로 작업 스레드에서 페이지를 나눠 둠 (layout 은 캐시보다 오래 살아야 함. 같은 경로면 처음 layout 유지)
+void thumb_cache_request_atlas(const char* path, int priority, const AtlasLayout* layout);
+// 준비된 텍스처 (없으면 NULL). 찾으면 사용 시각 갱신
+SDL_Texture* thumb_cache_get(const char* path);
+// 준비된 페이지들 (없으면 NULL). 다음 요청/정리 전까지 유효
+const AtlasPages* thumb_cache_get_atlas(const char* path);
+// 읽기/업로드에 실패했는지 (파일 없음 등). get 이 NULL 일 때 "읽는 중"과 구분하는 용도
+bool thumb_cache_failed(const char* path);
+// 끝난 디코드를 텍스처로 올림 (프레임마다, 한 번에 max_uploads 개까지)
+void thumb_cache_pump(SDL_Renderer* ren, int max_uploads);
+
+#endif
@@ -45,4 +45,77 @@ void ui_button_set_sfx(UIButton *b, Mix_Chunk *clickSfx, Mix_Chunk *hoverSfx);
 void ui_button_handle(UIButton *b, const SDL_Event *e);
 void ui_button_render(SDL_Renderer *ren, TTF_Font *font, const UIButton *b, SDL_Texture *bg);
 
+// 가상화 스크롤 리스트 (ui_list.c)
+// 전체 행 수만 알고, 텍스트는 보이는 근처 UI_LIST_WINDOW 행만 fetch 로 가져옴
+#define UI_LIST_TEXT_MAX  160
+#define UI_LIST_WINDOW    128
+#define UI_LIST_MAX_SLOTS 64
+#define UI_LIST_BAR_W     8
+
+// first 번째부터 count 행을 out 에 채우고 실제로 채운 행 수를 리턴
+typedef int (*UIListFetchFn)(void *userdata, int first, int count, char (*out)[UI_LIST_TEXT_MAX]);
+
+typedef struct
+{
+    int index;        // 이 텍스처에 그려진 행 (-1 = 비어있음)
+    SDL_Texture *tex; // 고정 크기 스트리밍 텍스처 (행마다 재사용)
+} UIListSlot;
+
+typedef struct
+{
+    SDL_Rect r;
+    int row_h;
+    int count;           // 전체 행 수
+    float scroll;        // 픽셀 단위
+    float scroll_target;
+    SDL_Color color;
+
+    UIListFetchFn fetch;
+    void *userdata;
+
+    char (*window)[UI_LIST_TEXT_MAX]; // fetch 결과 창
+    int window_first;
+    int window_count;
+
+    UIListSlot slots[UI_LIST_MAX_SLOTS];
+    int slot_count;
+    int slot_tex_w;
+
+    int dragging;
+    int drag_offset;
+} UIList;
+
+void ui_list_init(UIList *l, SDL_Rect r, int row_h, UIListFetchFn fetch, void *userdata);
+void ui_list_set_rect(UIList *l, SDL_Rect r);
+void ui_list_set_count(UIList *l, int count); // 내용이 바뀌었을 때도 호출 (창/텍스처 무효화)
+void ui_list_invalidate(UIList *l);
+void ui_list_scroll_to(UIList *l, int index);
+void ui_list_handle(UIList *l, const SDL_Event *e);
+void ui_list_update(UIList *l, float dt);
+void ui_list_render(SDL_Renderer *ren, TTF_Font *font, UIList *l);
+void ui_list_destroy(UIList *l);
+
+// 시계열 차트 (ui_chart.c). 띠(최소~최대) + 평균 선을 RenderGeometry 1번으로 그림
+typedef struct
+{
+    SDL_Rect r;
+    float vmin, vmax;    // 세로축
+    Sint64 t0, t1;       // 가로축 (초)
+    Sint64 gap;          // 이보다 벌어진 두 점은 잇지 않음 (0 = 항상 이음)
+    float thickness;     // 평균 선 두께(px)
+    SDL_Color line;
+    SDL_Color band;
+
+    SDL_Vertex *verts;
+    int *indices;
+    int vcount, icount;
+    int vcap, icap;
+} UIChart;
+
+void ui_chart_init(UIChart *c, SDL_Rect r, float vmin, float vmax);
+// mn/mx 가 NULL 이면 띠 없이 선만. r/t0/t1 을 바꾼 뒤에도 다시 호출
+void ui_chart_build(UIChart *c, const Sint64 *t, const float *avg, const float *mn, const float *mx, int n);
+void ui_chart_render(SDL_Renderer *ren, const UIChart *c);
+void ui_chart_destroy(UIChart *c);
+
 #endif
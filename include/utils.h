@@ -1,5 +1,33 @@
 #ifndef UTILS_H
 #define UTILS_H
+#include <stdbool.h>
+#include <time.h>
 #include "common.h"
 Uint32 timer_now_ms(void);
+
+// ---------------- 게임 시계 ----------------
+// 시뮬레이션/시간대/이벤트 주기는 전부 이 시계를 기준으로 한다.
+// 시작 시 실제 시각에서 출발해서 배속(1x ~ 10000x)만큼 빨리 흐름.
+// 애니메이션/페이드 같은 연출은 그대로 실제 dt 를 사용.
+#define GAMECLOCK_SCALE_MIN 1.0f
+#define GAMECLOCK_SCALE_MAX 10000.0f
+
+void   gameclock_init(void);
+void   gameclock_tick(float real_dt);      // 메인 루프에서 프레임마다 한 번
+float  gameclock_dt(void);                 // 이번 프레임에 흐른 게임 시간(sec)
+Uint64 gameclock_ms(void);                 // 시작 후 흐른 게임 시간(ms), SDL_GetTicks 대용
+time_t gameclock_time(void);               // time(NULL) 대용
+void   gameclock_localtime(struct tm* out);
+int    gameclock_sec_of_day(void);         // 0 ~ 86399
+
+void   gameclock_set_scale(float scale);   // 범위 밖이면 잘라냄
+float  gameclock_scale(void);
+void   gameclock_set_paused(bool paused);
+bool   gameclock_paused(void);
+void   gameclock_step(float game_sec);     // 일시정지 중 다음 tick 에 game_sec 만큼만 진행
+
+// ---------------- 파일 ----------------
+// 다 쓴 임시 파일 tmp 로 path 를 교체 (있으면 덮어씀). 중간에 꺼져도 path 는 예전 것이나 새 것 중 하나.
+// 실패하면 tmp 는 그대로 남으니 호출한 쪽에서 지울 것
+bool   file_replace(const char* tmp, const char* path);
 #endif
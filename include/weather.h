@@ -38,13 +38,44 @@ typedef struct WeatherInfo {
 
 } WeatherInfo;
 
+#define WEATHER_FILE_DIR  "assets"
+#define WEATHER_FILE_NAME "weather_state.txt"
+#define WEATHER_FILE_PATH WEATHER_FILE_DIR "/" WEATHER_FILE_NAME
+
 // 외부에서 사용할 함수
 int weather_load(struct WeatherInfo* out);
+// 읽은 값이 쓸 만한지 (TAG 가 있고 온도/습도가 말이 되는 범위). 쓰는 도중 읽은 파일 걸러내기용
+int weather_is_valid(const struct WeatherInfo* w);
 
 // 일출/일몰 문자열을 파싱해서 sunrise_sec / sunset_sec 채우는 함수
 void weather_compute_sun_secs(struct WeatherInfo* w);
 
-// 현재 시각 + 일출/일몰 정보를 바탕으로 시간대 구하기
+// 현재 시각(게임 시계) + 일출/일몰 정보를 바탕으로 시간대 구하기
 TimeOfDay weather_get_time_of_day(const struct WeatherInfo* w);
+// 하루 중 cur_sec(0~86399) 시점의 시간대
+TimeOfDay weather_get_time_of_day_at(const struct WeatherInfo* w, int cur_sec);
+
+// 시간대 시계: 일출/일몰로 구간 경계를 한 번만 계산해 두고, 프레임마다는 다음 전환 시각과 정수 비교 한 번.
+// 시각은 게임 시계(gameclock_ms) 기준이라 배속/일시정지를 그대로 따름.
+typedef void (*DayClockCallback)(TimeOfDay from, TimeOfDay to, void* ud);
+
+typedef struct DayClock {
+    int       edges[4];         // 일출 구간 시작/끝, 일몰 구간 시작/끝 (하루 중 초)
+    int       sunrise_sec, sunset_sec;
+    long long day_start_ms;     // 오늘 0시의 gameclock_ms (시작 전이면 음수)
+    long long next_ms;          // 다음 전환 시각 (gameclock_ms)
+    TimeOfDay tod;
+    DayClockCallback on_change;
+    void*     ud;
+} DayClock;
+
+void      dayclock_init(DayClock* dc, const struct WeatherInfo* w, DayClockCallback cb, void* ud);    // 콜백 없이 현재 시간대로 맞춤
+void      dayclock_set_sun(DayClock* dc, const struct WeatherInfo* w);    // 일출/일몰 갱신. 시간대가 바뀌면 콜백
+int       dayclock_tick(DayClock* dc);          // 프레임마다. 지난 전환 수 (전환마다 순서대로 콜백)
+TimeOfDay dayclock_current(const DayClock* dc);
+// 다음 전환 뒤 시간대와 남은 시간(ms, 게임 시간). 미리 준비할 때 사용
+void      dayclock_peek_next(const DayClock* dc, TimeOfDay* next, long long* in_ms);
+// 해 위상: 일출 0 → 일몰 0.5 → 다음 일출 1 (연속). 조명은 sinf(2*pi*phase) > 0 이 낮
+float     dayclock_sun_phase(const DayClock* dc);
 
 #endif
@@ -0,0 +1,20 @@
+#ifndef WEATHER_FX_H
+#define WEATHER_FX_H
+#include <stdbool.h>
+#include "common.h"
+#include "weather.h"
+
+// 날씨 파티클 (비 / 눈 / 구름 / 햇빛 먼지)
+// 입자는 종류 구분 없이 한 풀에 SoA(x[], y[], vx[], ...)로 두고 위치 적분은 4개씩 SIMD.
+// 그릴 때는 하늘 흐림 + 모든 입자를 정점으로 만들어 SDL_RenderGeometry 한 번 (텍스처 없음).
+// 밀도는 weather_fx_set 의 세기에 비례하고, 날씨가 바뀌면 새 입자만 안 생길 뿐 떠 있는 입자는 끝까지 감 → 끊김 없음.
+
+#define WEATHER_FX_MAX 2048     // 4의 배수 (SIMD 묶음)
+
+void weather_fx_init(void);     // 씬 진입 때. 입자 비움
+// 지금 날씨. intensity 0~1 (0 이면 해당 날씨 입자 없음). night 면 햇빛 먼지 대신 없음
+void weather_fx_set(WeatherTag tag, float intensity, bool night);
+void weather_fx_update(float dt, int w, int h);
+void weather_fx_render(SDL_Renderer* r);
+
+#endif
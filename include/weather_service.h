@@ -0,0 +1,35 @@
+#ifndef WEATHER_SERVICE_H
+#define WEATHER_SERVICE_H
+#include <stdbool.h>
+#include "common.h"
+#include "weather.h"
+
+// 날씨 서비스
+// 작업 스레드가 주기마다 공급자(기본: assets/weather_update.py)를 돌리고, weather_state.txt 가
+// 바뀌었을 때만 다시 읽는다 (Linux 는 inotify, 그 밖에는 mtime/크기 확인).
+// 검사를 통과하고 내용이 달라진 WeatherInfo 만 원자적 포인터 교환으로 넘김 → 프레임 쪽은 절대 기다리지 않음.
+// 로컬 스크립트/테스트에서 파일을 고쳐 쓰면 바로 반영된다.
+// 예보 파일(weather_forecast.txt)도 같은 방식으로 따라가서 weather_timeline 에 합친다 → 받아 오기는 하루 몇 번이면 됨.
+// 넘겨받은 WeatherInfo 는 읽기 전용 (다음 weather_service_poll 까지 유효).
+
+#define WEATHER_SERVICE_DEFAULT_INTERVAL_MS (6 * 60 * 60 * 1000)   // 실제 시간 6시간 (사이는 예보로 보간, 외부 API라 배속 무시)
+#define WEATHER_MAX_LISTENERS 8
+
+// 날씨 파일을 새로 쓰는 공급자 (작업 스레드에서 호출)
+typedef bool (*WeatherProvider)(void* ud);
+bool weather_provider_script(void* ud);     // python assets/weather_update.py
+
+// provider 가 NULL 이면 외부 호출 없이 파일 바뀜만 따라감 (오프라인/로컬 테스트용)
+bool weather_service_start(WeatherProvider provider, void* ud, Uint32 interval_ms);
+void weather_service_stop(void);
+
+// 메인 스레드, 프레임마다: 새 결과가 왔으면 교체(예보는 타임라인에 합침)하고 구독자에게 알린 뒤 true
+bool weather_service_poll(void);
+const WeatherInfo* weather_service_current(void);   // 아직 한 번도 못 읽었으면 NULL
+
+// 바뀜 알림 (weather_service_poll 안, 메인 스레드에서 호출). before 는 첫 결과면 NULL
+typedef void (*WeatherListener)(const WeatherInfo* now, const WeatherInfo* before, void* ud);
+int  weather_service_subscribe(WeatherListener fn, void* ud);   // 핸들 (1~), 꽉 차면 0
+void weather_service_unsubscribe(int handle);
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef WEATHER_TIMELINE_H
+#define WEATHER_TIMELINE_H
+#include <stdbool.h>
+#include "common.h"
+#include "weather.h"
+
+// 예보 타임라인
+// 예보 파일(assets/weather_forecast.txt, 한 줄에 "유닉스시각 태그 온도 습도")을 읽어 시각 순 링 버퍼에 쌓는다.
+// 새 예보가 오면 겹치는 뒤쪽은 새 값으로 바꾸고, 가득 차면 가장 오래된 것부터 버림.
+// 질의는 메인 스레드 전용. 시각이 앞으로만 가는 보통 경우에는 커서 덕분에 O(1).
+
+#define WEATHER_FORECAST_PATH WEATHER_FILE_DIR "/weather_forecast.txt"
+#define WEATHER_FORECAST_NAME "weather_forecast.txt"
+#define WEATHER_TIMELINE_CAP 64     // 3시간 간격 5일치(40) + 지난 구간
+#define WEATHER_FORECAST_STEP_SEC (3 * 3600)  // 샘플 간격을 모를 때(샘플 1개) 마지막 샘플이 유효한 길이
+
+typedef struct WeatherSample {
+    Sint64     ts;          // 유닉스 시각 (게임 시계 gameclock_time 과 같은 기준)
+    WeatherTag tag;
+    float      temp;
+    float      humidity;
+} WeatherSample;
+
+typedef struct WeatherForecast {
+    int count;
+    WeatherSample samples[WEATHER_TIMELINE_CAP];
+} WeatherForecast;
+
+// 예보 파일 → 시각 순 샘플 (작업 스레드에서도 사용). 형식이 틀린 줄은 건너뜀. 읽을 게 없으면 false
+bool weather_forecast_load(const char* path, WeatherForecast* out);
+
+void weather_timeline_clear(void);
+void weather_timeline_merge(const WeatherForecast* fc);   // fc 첫 시각부터 뒤는 새 예보로 교체
+int  weather_timeline_count(void);
+
+// ts 시점 값: 온도/습도는 앞뒤 샘플 사이 선형 보간, 태그는 그 구간 시작 샘플 것.
+// 마지막 샘플 뒤로는 샘플 간격 한 번까지만 마지막 값. 첫 샘플 전이나 그보다 뒤(예보가 낡음), 비었으면 false
+bool weather_timeline_at(Sint64 ts, WeatherSample* out);
+// ts 뒤로 처음 태그가 바뀌는 시각과 바뀔 태그. 없으면 false
+bool weather_timeline_next_change(Sint64 ts, WeatherTag* tag, Sint64* when);
+
+#endif
@@ -1,22 +1,53 @@
 #include "game.h"
 #include "scene_manager.h"
 #include "include/common.h"
+#include "include/core.h"
 #include "include/loading.h"
 #include "include/settings.h"
+#include "include/balance.h"
+#include "include/rollup.h"
+#include "include/plant_blob.h"
+#include "include/plant_search.h"
+#include "include/utils.h"
+#include "include/save.h"
+#include "include/stats_store.h"
+#include "include/weather_service.h"
 
 // 씬 “팩토리” 프로토타입
 Scene *scene_mainmenu_object(void);
 Scene *scene_gameplay_object(void);
 Scene *scene_settings_object(void);
 Scene *scene_codex_object(void);
-// Scene* scene_stats_object(void);
+Scene *scene_stats_object(void);
 Scene *scene_credits_object(void);
 Scene *scene_selectplant_object(void);
 Scene *scene_plantinfo_object(void);
-int main(void)
+int main(int argc, char* argv[])
 {
+    // 밸런스 시뮬레이터: 창 없이 돌리고 바로 종료
+    if (argc > 1 && SDL_strcmp(argv[1], "--balance") == 0)
+        return balance_main(argc, argv);
+    // 일/주 집계 재생성: 저널에서 logs/<id>.agg 를 다시 만듦
+    if (argc > 1 && SDL_strcmp(argv[1], "--rebuild-rollups") == 0)
+        return rollup_main(argc, argv);
+    // 식물 카탈로그 미리 컴파일: plants.json → plants.bin
+    if (argc > 1 && SDL_strcmp(argv[1], "--compile-catalog") == 0)
+        return plantblob_main(argc, argv);
+
     if (!game_init())
         return 1;
+    save_init();
+
+    // 식물 카탈로그는 여기서 한 번만 읽음 (이후 파일이 바뀌면 루프에서 다시 읽음)
+    if (plantdb_load(ASSETS_DIR "plants.json") <= 0)
+        SDL_Log("WARNING: plants.json empty or fail");
+
+    // 게임 시계: --timescale N 으로 시작 배속 지정 (QA/시연용)
+    gameclock_init();
+    for (int i = 1; i + 1 < argc; i++) {
+        if (SDL_strcmp(argv[i], "--timescale") == 0)
+            gameclock_set_scale((float)SDL_atof(argv[i + 1]));
+    }
     if (!settings_load())
     {
         SDL_Log("Settings load failed, using defaults.");
@@ -24,8 +55,13 @@ int main(void)
 
 
     settings_apply_audio();
-    system("python assets/weather_update.py");
-    SDL_Log("날씨 업데이트 1회 완료");
+    // 날씨: 작업 스레드가 받아 옴 (첫 프레임을 기다리게 하지 않음). --weather-offline 이면 파일만 읽음
+    WeatherProvider weatherProvider = weather_provider_script;
+    for (int i = 1; i < argc; i++) {
+        if (SDL_strcmp(argv[i], "--weather-offline") == 0)
+            weatherProvider = NULL;
+    }
+    weather_service_start(weatherProvider, NULL, WEATHER_SERVICE_DEFAULT_INTERVAL_MS);
     // 창 모드 적용 예시 (원하면)
     // if (G_Settings.video.fullscreen) SDL_SetWindowFullscreen(G_Window, SDL_WINDOW_FULLSCREEN_DESKTOP);
     // SDL_SetWindowSize(G_Window, G_Settings.video.width, G_Settings.video.height);
@@ -36,7 +72,7 @@ int main(void)
     scene_register(SCENE_SETTINGS, scene_settings_object());
     scene_register(SCENE_PLANTINFO, scene_plantinfo_object());
     scene_register(SCENE_CODEX, scene_codex_object());
-    // scene_register(SCENE_STATS,    scene_stats_object())
+    scene_register(SCENE_STATS, scene_stats_object());
     scene_register(SCENE_SELECT_PLANT, scene_selectplant_object());
     scene_register(SCENE_CREDITS, scene_credits_object());
 
@@ -56,6 +92,9 @@ int main(void)
 
         while (SDL_PollEvent(&e))
             scene_handle(&e);
+        gameclock_tick(dt);
+        plantdb_reload_if_changed();
+        weather_service_poll();
         scene_update(dt);
 
         SDL_SetRenderDrawColor(G_Renderer, 16, 20, 28, 255);
@@ -70,6 +109,10 @@ int main(void)
     }
 
     scene_cleanup();
+    plant_search_free();
+    weather_service_stop();
+    stats_store_close();
+    save_shutdown();   // 남은 기록 파일에 쓰고 I/O 스레드 종료
     game_shutdown();
     return 0;
 }
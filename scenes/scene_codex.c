@@ -4,6 +4,8 @@
 #include "../include/core.h"
 #include "../include/save.h"
 #include "../include/ui.h"
+#include "../include/thumb_cache.h"
+#include "../include/utils.h"      // gameclock_localtime
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_ttf.h>
@@ -20,8 +22,7 @@ int save_get_plant_logs(const char *plant_id, CodexLog *out, int max);
 // --- 내부 ----
 typedef struct
 {
-    int unlocked;
-    SDL_Texture *thumb; // 해금 썸네일
+    int unlocked; // 썸네일은 thumb_cache 가 보이는 페이지 근처만 들고 있음
 } CodexEntry;
 
 static CodexEntry *s_entries = NULL;
@@ -44,13 +45,70 @@ static SDL_Rect s_detailBoard = {0};
 static int s_visibleRows = 1;
 static int s_itemsPerPage = 0;
 static int s_page = 0;
+static int s_thumbCap = 0;    // 썸네일 캐시 크기 (보이는 페이지 + 앞뒤 미리 읽기)
 
 static int s_selected = -1;
+
+// 선택한 식물 기록 리스트 (선택이 바뀌거나 새 기록이 생길 때만 길이/내용 갱신)
+// 텍스트는 리스트가 보이는 근처 UI_LIST_WINDOW 행만 fetch 로 가져감
+static UIList s_logList;
+static CodexLog s_logFetch[UI_LIST_WINDOW];
+static int s_logSel = -1;
+static Uint32 s_logGen = 0;
 static TTF_Font *s_font = NULL;
 static TTF_Font *s_titleFont = NULL;
 
+// 선택한 식물의 최근 7일 요약 (logs/<id>.agg 일/주 집계).
+// 집계는 I/O 스레드가 기록을 파일에 쓴 뒤 반영되므로 기록이 바뀔 때 + 1초마다 다시 읽음
+#define CODEX_RECENT_DAYS 7
+static RollupBucket s_weekTotal;
+static int s_dayWater[CODEX_RECENT_DAYS];   // [0] = 6일 전 ... [6] = 오늘
+static int s_rollupSel = -1;
+static Uint32 s_rollupGen = 0;
+static Uint32 s_rollupAt = 0;
+
 static void clamp_page(void);
 
+static void refresh_rollup(const char *plant_id)
+{
+    char ts[32];
+    struct tm lt;
+    int today;
+    SDL_memset(&s_weekTotal, 0, sizeof(s_weekTotal));
+    SDL_memset(s_dayWater, 0, sizeof(s_dayWater));
+
+    gameclock_localtime(&lt);
+    strftime(ts, sizeof(ts), "%Y-%m-%d", &lt);
+    if (!rollup_day_from_ts(ts, &today, NULL))
+        return;
+
+    int first = today - (CODEX_RECENT_DAYS - 1);
+    RollupBucket days[CODEX_RECENT_DAYS];
+    int n = save_get_rollup(plant_id, ROLLUP_DAY, first, today, days, CODEX_RECENT_DAYS);
+    for (int i = 0; i < n; i++)
+        s_dayWater[days[i].key - first] = days[i].water_ml.sum;
+
+    int week = rollup_week_of_day(today);
+    save_get_rollup_total(plant_id, ROLLUP_WEEK, week, week, &s_weekTotal);
+}
+
+// UIList fetch: first 번째(0 = 최신)부터 count 개
+static int fetch_logs(void *userdata, int first, int count, char (*out)[UI_LIST_TEXT_MAX])
+{
+    (void)userdata;
+    if (s_logSel < 0)
+        return 0;
+    const PlantInfo *p = plantdb_get(s_logSel);
+    if (!p)
+        return 0;
+    if (count > UI_LIST_WINDOW)
+        count = UI_LIST_WINDOW;
+    int n = save_get_recent_plant_logs(plantdb_id(p), first, s_logFetch, count);
+    for (int i = 0; i < n; ++i)
+        SDL_strlcpy(out[i], s_logFetch[i].line, UI_LIST_TEXT_MAX);
+    return n;
+}
+
 // 그리드 레이아웃
 enum
 {
@@ -62,6 +120,39 @@ static int grid_origin_x = 56;
 static int grid_origin_y = 130;
 
 // 유틸리티
+static void thumb_path(int idx, char *out, int outsz)
+{
+    SDL_snprintf(out, outsz, ASSETS_IMAGES_DIR "codex/%s_thumb.png", plantdb_id(plantdb_get(idx)));
+}
+
+// 페이지 하나의 해금된 썸네일 요청
+static void request_page(int page, int priority, int limit)
+{
+    if (page < 0 || s_itemsPerPage <= 0)
+        return;
+    int start = page * s_itemsPerPage;
+    for (int i = start; i < start + s_itemsPerPage && i < s_count && limit > 0; ++i)
+    {
+        if (!s_entries[i].unlocked)
+            continue;
+        char path[512];
+        thumb_path(i, path, sizeof(path));
+        thumb_cache_request(path, priority);
+        --limit;
+    }
+}
+
+// 보이는 페이지 먼저, 그다음 앞뒤 페이지 (캐시를 넘지 않게 나눠서)
+static void request_thumbs(void)
+{
+    if (!s_entries)
+        return;
+    request_page(s_page, THUMB_PRIO_VISIBLE, s_itemsPerPage);
+    int spare = (s_thumbCap - s_itemsPerPage) / 2;
+    request_page(s_page + 1, THUMB_PRIO_PREFETCH, spare);
+    request_page(s_page - 1, THUMB_PRIO_PREFETCH, spare);
+}
+
 static SDL_Texture *load_tex(const char *path)
 {
     SDL_Texture *t = IMG_LoadTexture(G_Renderer, path);
@@ -84,6 +175,40 @@ static void draw_text(SDL_Renderer *r, TTF_Font *f, int x, int y, const char *s,
     SDL_DestroyTexture(tx);
 }
 
+// "이번 주 ..." 한 줄 + 최근 7일 물 준 양 막대. 쓴 높이를 돌려줌
+static int render_rollup(SDL_Renderer *r, int x, int y, int w, SDL_Color textColor)
+{
+    char line[160];
+    SDL_snprintf(line, sizeof(line), "이번 주: 물 %d회 %dml / 햇빛 %d분 / 창문 %d분",
+                 s_weekTotal.water_ml.count, s_weekTotal.water_ml.sum,
+                 s_weekTotal.sun_min.sum, s_weekTotal.window_open_min);
+    draw_text(r, s_font, x, y, line, textColor);
+    y += 30;
+
+    const int barMaxH = 28;
+    int maxWater = 1;
+    for (int i = 0; i < CODEX_RECENT_DAYS; i++)
+        if (s_dayWater[i] > maxWater)
+            maxWater = s_dayWater[i];
+
+    int slot = w / CODEX_RECENT_DAYS;
+    SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_BLEND);
+    for (int i = 0; i < CODEX_RECENT_DAYS; i++)
+    {
+        int bh = s_dayWater[i] > 0 ? SDL_max(2, s_dayWater[i] * barMaxH / maxWater) : 0;
+        SDL_Rect base = {x + i * slot + 2, y + barMaxH, slot - 4, 2};
+        SDL_SetRenderDrawColor(r, 141, 101, 66, 120);
+        SDL_RenderFillRect(r, &base);
+        if (bh > 0)
+        {
+            SDL_Rect bar = {x + i * slot + 4, y + barMaxH - bh, slot - 8, bh};
+            SDL_SetRenderDrawColor(r, i == CODEX_RECENT_DAYS - 1 ? 90 : 120, 160, 210, 230);  // 오늘은 진하게
+            SDL_RenderFillRect(r, &bar);
+        }
+    }
+    return 30 + barMaxH + 12;
+}
+
 static void on_back(void *ud)
 {
     (void)ud;
@@ -97,6 +222,7 @@ static void change_page(int delta)
     clamp_page();
     if (s_page != previous)
     {
+        request_thumbs();
         int start = s_page * s_itemsPerPage;
         int end = start + s_itemsPerPage;
         if (s_selected < start || s_selected >= end)
@@ -185,6 +311,7 @@ static void layout(int win_w, int win_h)
     s_btnPrevPage.r = (SDL_Rect){s_btnNextPage.r.x - navGap - navSize, navY, navSize, navSize};
 
     clamp_page();
+    request_thumbs();
 }
 
 // 초기화
@@ -264,29 +391,26 @@ static void init(void *arg)
     // 공용잠금 텍스처
     s_locked = load_tex(ASSETS_IMAGES_DIR "codex/locked_collection.png");
 
-    // 각 식물별 썸네일 로드
+    // 해금 여부만 (썸네일은 페이지를 볼 때 작업 스레드가 읽음)
     for (int i = 0; i < s_count; i++)
     {
         const PlantInfo *p = plantdb_get(i);
         if (!p)
             continue;
-        s_entries[i].unlocked = save_is_plant_completed(p->id) ? 1 : 0;
-
-        if (s_entries[i].unlocked)
-        {
-            char path[512];
-            SDL_snprintf(path, sizeof(path), ASSETS_IMAGES_DIR "codex/%s_thumb.png", p->id);
-            s_entries[i].thumb = load_tex(path);
-        }
-        else
-        {
-            s_entries[i].thumb = NULL;
-        }
+        s_entries[i].unlocked = save_is_plant_completed(plantdb_id(p)) ? 1 : 0;
     }
 
+    // 세 페이지가 들어가는 크기 (창을 키워 한 페이지가 커지면 기본값보다 크게)
+    s_thumbCap = SDL_max(THUMB_CACHE_DEFAULT_CAP, s_itemsPerPage * 3);
+    thumb_cache_init(s_thumbCap);
+
     s_page = 0;
     s_selected = -1;
+    s_logSel = -1;
+    s_rollupSel = -1;
+    ui_list_init(&s_logList, (SDL_Rect){0, 0, 0, 0}, 24, fetch_logs, NULL);
     clamp_page();
+    request_thumbs();
 }
 
 // 이벤트 처리
@@ -314,8 +438,22 @@ static void handle(SDL_Event *e)
         return;
     }
 
+    // 기록 리스트는 해금된 식물을 보고 있을 때만 입력을 받음
+    int logActive = s_selected >= 0 && s_selected == s_logSel && s_entries[s_selected].unlocked;
+    if (logActive)
+    {
+        ui_list_handle(&s_logList, e);
+        if (s_logList.dragging)
+            return;
+    }
+
     if (e->type == SDL_MOUSEWHEEL)
     {
+        // 기록 리스트 위에서는 리스트 스크롤
+        int mx, my;
+        SDL_GetMouseState(&mx, &my);
+        if (logActive && s_logList.count > 0 && ui_point_in_rect(mx, my, &s_logList.r))
+            return;
         if (e->wheel.y > 0)
             change_page(-1);
         else if (e->wheel.y < 0)
@@ -349,7 +487,8 @@ static void handle(SDL_Event *e)
 }
 static void update(float dt)
 {
-    (void)dt;
+    ui_list_update(&s_logList, dt);
+    thumb_cache_pump(G_Renderer, 4);
 }
 
 static void render(SDL_Renderer *r)
@@ -443,7 +582,24 @@ static void render(SDL_Renderer *r)
 
             if (idx < s_count)
             {
-                SDL_Texture *tex = s_entries[idx].unlocked ? s_entries[idx].thumb : s_locked;
+                SDL_Texture *tex = s_locked;
+                if (s_entries[idx].unlocked)
+                {
+                    char path[512];
+                    thumb_path(idx, path, sizeof(path));
+                    tex = thumb_cache_get(path);
+                    // 썸네일이 없어 실패한 것은 예전처럼 아무것도 안 그림
+                    if (!tex && !thumb_cache_failed(path))
+                    {
+                        // 읽는 중: 깜빡이는 자리 표시
+                        Uint8 a = (Uint8)(60 + 40 * SDL_sin(SDL_GetTicks() * 0.006));
+                        SDL_Rect ph = {cell.x + 14, cell.y + 14, CELL - 28, CELL - 28};
+                        SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_BLEND);
+                        SDL_SetRenderDrawColor(r, 115, 78, 52, a);
+                        SDL_RenderFillRect(r, &ph);
+                        SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_NONE);
+                    }
+                }
                 if (tex)
                 {
                     int tw, th;
@@ -463,7 +619,7 @@ static void render(SDL_Renderer *r)
                     if (p)
                     {
                         SDL_Color c = {245, 245, 240, 255};
-                        draw_text(r, s_font, cell.x, cell.y + CELL + 6, p->name_kr, c);
+                        draw_text(r, s_font, cell.x, cell.y + CELL + 6, plantdb_name(p), c);
                     }
                 }
 
@@ -500,7 +656,7 @@ static void render(SDL_Renderer *r)
 
         if (s_titleFont)
         {
-            SDL_Surface *nameSurf = TTF_RenderUTF8_Blended(s_titleFont, p->name_kr, nameColor);
+            SDL_Surface *nameSurf = TTF_RenderUTF8_Blended(s_titleFont, plantdb_name(p), nameColor);
             if (nameSurf)
             {
                 SDL_Texture *nameTex = SDL_CreateTextureFromSurface(r, nameSurf);
@@ -515,14 +671,14 @@ static void render(SDL_Renderer *r)
         }
 
         char latinLine[128];
-        SDL_snprintf(latinLine, sizeof(latinLine), "학명: %s", p->latin);
+        SDL_snprintf(latinLine, sizeof(latinLine), "학명: %s", plantdb_latin(p));
         draw_text(r, s_font, textX, cursorY, latinLine, subtle);
         cursorY += 36;
 
         if (s_entries[s_selected].unlocked)
         {
             char path[512];
-            SDL_snprintf(path, sizeof(path), ASSETS_IMAGES_DIR "codex/%s_ful.png", p->id);
+            SDL_snprintf(path, sizeof(path), ASSETS_IMAGES_DIR "codex/%s_ful.png", plantdb_id(p));
             SDL_Texture *full = load_tex(path);
             if (full)
             {
@@ -573,15 +729,32 @@ static void render(SDL_Renderer *r)
 
         if (s_entries[s_selected].unlocked)
         {
-            CodexLog logs[64];
-            int n = save_get_plant_logs(p->id, logs, 64);
-            draw_text(r, s_font, textX, cursorY, "기록", bodyColor);
-            cursorY += 30;
-            for (int i = 0; i < n && cursorY < detailInner.y + detailInner.h - 24; ++i)
+            Uint32 gen = save_logs_generation();
+            if (s_logSel != s_selected || s_logGen != gen)
+            {
+                if (s_logSel != s_selected)
+                    ui_list_scroll_to(&s_logList, 0);
+                s_logSel = s_selected;
+                s_logGen = gen;
+                ui_list_set_count(&s_logList, save_get_plant_log_count(plantdb_id(p)));
+            }
+            if (s_rollupSel != s_selected || s_rollupGen != gen || SDL_GetTicks() - s_rollupAt > 1000)
             {
-                draw_text(r, s_font, textX, cursorY, logs[i].line, subtle);
-                cursorY += 24;
+                s_rollupSel = s_selected;
+                s_rollupGen = gen;
+                s_rollupAt = SDL_GetTicks();
+                refresh_rollup(plantdb_id(p));
             }
+            cursorY += render_rollup(r, textX, cursorY, detailInner.x + detailInner.w - 12 - textX, bodyColor);
+
+            draw_text(r, s_font, textX, cursorY, "기록", bodyColor);
+            cursorY += 30;
+            int listBottom = detailInner.y + detailInner.h - 12;
+            SDL_Rect listRect = {textX, cursorY, detailInner.x + detailInner.w - 12 - textX, listBottom - cursorY};
+            if (listRect.h < 0)
+                listRect.h = 0;
+            ui_list_set_rect(&s_logList, listRect);
+            ui_list_render(r, s_font, &s_logList);
         }
     }
     }
@@ -594,13 +767,9 @@ static void render(SDL_Renderer *r)
 
 static void cleanup(void)
 {
+    thumb_cache_shutdown();
     if (s_entries)
     {
-    for (int i = 0; i < s_count; i++)
-    {
-        if (s_entries[i].thumb)
-            SDL_DestroyTexture(s_entries[i].thumb);
-    }
     SDL_free(s_entries);
     s_entries = NULL;
     }
@@ -648,8 +817,11 @@ static void cleanup(void)
         s_titleFont = NULL;
     }
 
+    ui_list_destroy(&s_logList);
     s_page = 0;
     s_selected = -1;
+    s_logSel = -1;
+    s_rollupSel = -1;
 }
 
 // 씬 객체
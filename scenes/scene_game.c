@@ -8,7 +8,16 @@
 #include "../include/settings.h"   // settings_apply_audio
 #include "../include/gameplay.h"
 #include "../include/weather.h"
+#include "../include/weather_service.h"
+#include "../include/weather_timeline.h"
 #include "../include/anim_util.h"
+#include "../include/sim.h"
+#include "../include/utils.h"      // gameclock_*
+#include "../include/stats_store.h" // 통계 화면 시계열
+#include "../include/snapshot.h"    // 이어하기용 상태 저장
+#include "../include/thumb_cache.h"  // 배경 변형 미리 디코드
+#include "../include/weather_fx.h"   // 비/눈/구름 파티클
+#include "../include/atlas.h"        // 큰 시트 페이지 나누기
 
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_image.h>
@@ -29,8 +38,6 @@ extern void load_background_animation(void);
 extern void settings_apply_audio(void);
 
 static int  lamp_panel = 0;
-static int  s_room_temperature = 20;
-static bool window_open = false;
 static bool back_panel = false;
 static int  exit_pressed = 0;
 
@@ -38,7 +45,8 @@ static int s_step = 0;  // 0부터 차례로 증가
 
 // -----------------------------
 static const PlantInfo* s_plant = NULL;
-static PlantStatus s_status;
+static GrowSim s_sim;             // 식물 상태/경험치 (core/sim.c)
+static bool    s_simReady = false;
 
 static UIButton s_btnBack;
 static UIButton s_btnWater;
@@ -54,7 +62,6 @@ static UIButton s_btnlpdown;
 static UIButton s_btnexit;
 
 static int  s_waterCount = 0;
-static bool s_windowOpen = false;
 static int  s_light_level = 0;
 
 static SDL_Texture* s_bgTexture = NULL;   // fallback 배경(옵션)
@@ -72,285 +79,31 @@ static SDL_Texture* s_lamp_levelup = NULL;
 static SDL_Texture* s_lamp_leveldown = NULL;
 static SDL_Texture* s_exit = NULL;
 
-///// 식물 경험치
-static int   s_plantLevel = 3;
-static float s_plantExp = 0.f;
-
 ////////////////////////////////////////// 식물 텍스쳐 (예시)
 static SDL_Texture* s_monstera = NULL;
 
 /////////////////////////////////////// 날씨!
 static WeatherInfo g_weather;
-static Uint32 g_last_weather_check = 0;
-static const Uint32 WEATHER_INTERVAL_MS = 60 * 1000 * 5; // 5분
-
-static SDL_Texture* s_weatherClouds = NULL;
-static SDL_Texture* s_weatherRain = NULL;
-static SDL_Texture* s_weatherSnow = NULL;
+static int g_weatherSub = 0;      // 날씨 서비스 구독 핸들 (바뀔 때만 on_weather_changed 호출)
+static WeatherTag g_schedTag = WEATHER_TAG_UNKNOWN;   // sim 에 마지막으로 예약한 예보 날씨 변화
+static Sint64 g_schedWhen = 0;
 
 // 시간대(낮/밤/일출몰) 캐시
 static TimeOfDay g_timeOfDay = TIMEOFDAY_DAY;
-static Uint32   g_last_tod_check = 0;
-static const Uint32 TOD_INTERVAL_MS = 10 * 1000; // 10초마다 갱신
-
-static int s_eventtype = 0;
-
-static bool s_weather_event_over = false;
-
-////////////////////////////////////////////////// 게임 로직
-float optM;
-bool moisture_ok;
-bool temp_ok;
-static float s_room_humidity = 60.f; // 0~100
-bool humidity_ok;
-static bool s_hasBug = false;
-static bool s_hasMold = false;
-bool nutrition_ok ; 
-
-static int   s_activeWeatherEvent = 0;
-static float s_weatherEventTimer = 0.f;
-
-float cooltime = 20.f;
-
-static WeatherTag s_originalWeatherTag = WEATHER_TAG_CLEAR;
-
-// 액션별 경험치 기본값 🐥
-
-#define EXP_WATER 1.0f
-#define EXP_KILL_BUG 10.0f
-#define EXP_REMOVE_MOLD 12.0f
-#define EXP_GIVE_FERT 5.0f
-#define EXP_TEMP_DOWN 3.0f
-#define EXP_TEMP_UP 3.0f
-
-// 어떤 업데이트 함수 안에서
-void update_status(void)
-{
-    optM = s_plant->moisture_opt;
-
-    moisture_ok = (s_status.moisture >= optM - 10.0f && s_status.moisture <= optM + 10.0f);
-    temp_ok = (s_status.temp >= s_plant->temp_min && s_status.temp <= s_plant->temp_max);
-    humidity_ok = (s_status.humidity >= s_plant->humidity_min && s_status.humidity <= s_plant->humidity_max);
-    nutrition_ok = (s_status.nutrition >= 40.f); // 추측
-}
-
-//////////////////////////////////////////////////////////////////////////////////// 게임 로직 함수
-static void update_moisture(float dt)
-{
-    float basePerMin = 0.f;
-
-    switch (g_weather.tag) {
-    case WEATHER_TAG_CLEAR:   basePerMin = 10.f; break;
-    case WEATHER_TAG_RAIN:    basePerMin = 5.f;  break;
-    case WEATHER_TAG_CLOUDY:  basePerMin = 8.f;  break;
-    case WEATHER_TAG_SNOW:    basePerMin = 6.f;  break; // ★ 눈: 추측값
-    default:                  basePerMin = 8.f;  break;
-    }
-
-    // 1분에 basePerMin 만큼 줄어든다고 가정 → 1초당 basePerMin/60
-    float perSec = basePerMin / 60.f;
-    s_status.moisture -= perSec * dt;
-    update_status();
-    if (s_status.moisture < 0.f) s_status.moisture = 0.f;
-}
-
-static void update_temperature(float dt)
-{
-    float perMin = 0.f;
-
-    switch (g_weather.tag) {
-    case WEATHER_TAG_CLEAR:  perMin = +0.5f; break;
-    case WEATHER_TAG_SNOW:   perMin = -0.5f; break;
-    case WEATHER_TAG_RAIN:
-    case WEATHER_TAG_CLOUDY: perMin = 0.0f; break;
-    default:                  perMin = 0.0f; break;
-    }
-
-    float perSec = perMin / 60.f;
-    s_room_temperature += perSec * dt;
-    s_status.temp = (float)s_room_temperature;
-
-    update_status();
-}
-
-static void update_humidity(float dt)
-{
-    float perMin = 0.f;
-
-    if (g_weather.tag == WEATHER_TAG_CLEAR) {
-        // 맑음 → 감소
-        perMin = -2.0f;
-    }
-    else if (g_weather.tag == WEATHER_TAG_RAIN) {
-        // 비 → 창문 열면 많이 증가, 닫으면 조금 증가 (추측)
-        if (window_open)
-            perMin = +3.0f;
-        else
-            perMin = +1.0f;
-    }
-    else {
-        // 구름/눈 → 거의 유지 (약간만 변화)
-        perMin = 0.0f;
-    }
-
-    float perSec = perMin / 60.f;
-    s_room_humidity += perSec * dt;
-
-    if (s_room_humidity < 0.f)   s_room_humidity = 0.f;
-    if (s_room_humidity > 100.f) s_room_humidity = 100.f;
-
-    s_status.humidity = s_room_humidity;
-
-    update_status();
-}
-
-static void update_random_events(float dt)
-{
-    // dt기반으로도 만들 수 있지만, 간단하게 매 프레임 작은 확률
-    float bugChancePerSec = 0.0005f; // 추측 //0.0005f
-    float moldChancePerSec = 0.0005f; // 추측
-
-    float bugProbThisFrame = bugChancePerSec * dt;
-    float moldProbThisFrame = moldChancePerSec * dt;
-
-    if (!s_hasBug) {
-        float r = (float)rand() / (float)RAND_MAX;
-        if (r < bugProbThisFrame) {
-            s_hasBug = true;
-            SDL_Log("[EVENT] Bug appeared!");
-            
-        }
-    }
-
-    if (!s_hasMold) {
-        float r = (float)rand() / (float)RAND_MAX;
-        if (r < moldProbThisFrame) {
-            s_hasMold = true;
-            SDL_Log("[EVENT] Mold appeared!");
-        }
-    }
-
-    update_status();
-}
-
-static void update_happiness(float dt)
-{
-    float deltaPerMin = 0.f;
-
-    if (s_hasBug)  deltaPerMin -= 3.f; // 추측
-    if (s_hasMold) deltaPerMin -= 4.f; // 추측
-
-    float perSec = deltaPerMin / 60.f;
-    s_status.happiness += perSec * dt;
-
-    if (s_status.happiness < 0.f)   s_status.happiness = 0.f;
-    if (s_status.happiness > 100.f) s_status.happiness = 100.f;
-
-    update_status();
-}
-
-static void update_nutrition(float dt)
-{
-    float perMin = -2.0f;           // 추측
-    float perSec = perMin / 60.f;
-
-    s_status.nutrition += perSec * dt;
-    if (s_status.nutrition < 0.f)   s_status.nutrition = 0.f;
-    if (s_status.nutrition > 100.f) s_status.nutrition = 100.f;
-
-    update_status();
-}
-
-void start_weather_event(WeatherTag eventTag, float duration)
-{
-    if (s_activeWeatherEvent) return;  // 이미 이벤트 중이면 무시
-
-    s_activeWeatherEvent = 1;
-    s_weatherEventTimer = duration;
+static DayClock  g_dayClock;     // 다음 전환 시각만 비교, 전환 때 on_tod_changed
 
-    SDL_Log("[WEATHER EVENT] BEFORE START: g_weather.tag=%d", (int)g_weather.tag);
+// 배속 시 한 프레임에 sim_step 을 여러 번 나눠 돌림
+static const float SIM_MAX_SUBSTEP = 1.0f;       // 한 번에 최대 1초(게임 시간)
+static const int   SIM_MAX_SUBSTEPS = 1024;      // 프레임당 상한 (넘으면 substep 을 키움)
 
-    // ★ 여기서 '그 시점의 실제 날씨'를 저장
-    s_originalWeatherTag = g_weather.tag;
-
-    // 그리고 이벤트용 날씨로 바꿈
-    g_weather.tag = eventTag;
-
-    SDL_Log("[WEATHER EVENT] start: base=%d event=%d", (int)s_originalWeatherTag, (int)eventTag);
-}
-
-static void update_weather_event(float dt )
-{
-    
-   
-    if (s_activeWeatherEvent == 0 ) {
-        // 이벤트 없음 → 아주 낮은 확률로 발생 (추측)
-        float chancePerSec = 0.0001f; // 0.0001f
-        float p = chancePerSec * dt;
-        float r = (float)rand() / (float)RAND_MAX;
-
-        int weather = rand() % 10;
-        
-        //printf("%d < %d %d \n",r,p, weather);
-        if (r < p) {
-            // 현재 실제 날씨랑 랜덤 event 날씨를 하나 선택 (추측)
-            //s_activeWeatherEvent = g_weather.tag; // 일단 동일로
-            int w = rand() % 10;
-            WeatherTag eventTag;
-
-            if (w < 2) eventTag = WEATHER_TAG_RAIN; // 3
-            else if (w < 4) eventTag = WEATHER_TAG_CLOUDY; // 2
-            else if (w < 6) eventTag = WEATHER_TAG_SNOW; // 4
-            else            eventTag = WEATHER_TAG_CLEAR; // 1
-
-            start_weather_event(eventTag, 60.f);
-
-            // 1~2분 사이 지속 (추측)
-            float durMin = 1.f + ((float)rand() / RAND_MAX) * 1.f;
-            s_weatherEventTimer = durMin * 20.f; //durMin * 60.f; 
-            
-        }
-    }
-    else {
-        // 진행 중
-        s_weatherEventTimer -= dt;
-        if (s_weatherEventTimer <= 0.f) {
-            SDL_Log("[WEATHER EVENT] end, restore=%d", (int)s_originalWeatherTag);
-            g_weather.tag = s_originalWeatherTag;  // ★ 원래 날씨 복원
-            s_activeWeatherEvent = 0;
-            cooltime = 20.f;
-        }
-    }
-
-    update_status();
-
-}
-
-static float get_exp_multiplier(void)
-{
-    // 현재 실제 날씨와 이벤트 날씨가 같으면 1.5배 (추측)
-    if (s_activeWeatherEvent != WEATHER_TAG_CLEAR &&
-        s_activeWeatherEvent == g_weather.tag) {
-        return 1.5f;
-    }
-    return 1.0f;
-}
-
-static void add_exp(float baseExp)
-{
-    if (baseExp <= 0.f)
-        return;
+// 상태 스냅샷 주기 (실제 시간). 씬을 나갈 때도 저장
+static const Uint32 SNAPSHOT_INTERVAL_MS = 30 * 1000;
+static Uint32 s_lastSnapshot = 0;
 
-    float mul = get_exp_multiplier();
-    s_plantExp += baseExp * mul;
+// 통계 샘플은 게임 시각 1초 경계마다 한 번 (같은 초 안의 substep 은 건너뜀)
+static Sint64 s_lastStatSec = -1;
 
-    while (s_plantExp >= 100.f)
-    {
-        s_plantExp -= 100.f;
-        s_plantLevel++;
-        SDL_Log("[GAME] plant level up! level = %d", s_plantLevel);
-    }
-}
+static int s_eventtype = 0;
 
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 static SDL_Texture* s_pot = NULL;
@@ -358,60 +111,102 @@ static SDL_Texture* s_pot = NULL;
 
 
 //////////////////////////////////// 시간대 배경
-static SDL_Texture* s_bgDay = NULL;
-static SDL_Texture* s_bgNight = NULL;
-static SDL_Texture* s_bgSunrise = NULL;  // 일출/일몰 공용
-static bool background_change = false;
-
-static int   g_tod_fade_active = 0;      // 0: 없음, 1: 진행 중
-static float g_tod_fade_t = 0.0f;   // 진행 시간(sec)
-static const float TOD_FADE_TIME = 2.0f;   // 총 페이드 시간
+// 시간대별 배경. 모두 sunset.json 과 같은 프레임 배치의 가로 아틀라스. 날씨는 배경 위 파티클(weather_fx)로 그림.
+// 작업 스레드가 미리 풀어 두고(thumb_cache), 바뀔 때는 상주한 두 장을 알파로 겹쳐서 넘어감 → 전환 때 디스크 I/O 없음
+typedef enum { BG_SUNNY = 0, BG_NIGHT, BG_SUNSET, BG_VARIANT_COUNT } BgVariant;
+static const char* const BG_VARIANT_PATHS[BG_VARIANT_COUNT] = {
+    ASSETS_IMAGES_DIR "sunny.png", ASSETS_IMAGES_DIR "night.png", ASSETS_IMAGES_DIR "sunset.png",
+};
+static BgVariant s_bgCur = BG_SUNSET;    // 보여 주는 배경 (init 에서 지금 시간대 것으로. 준비 전엔 sunset 아틀라스로 대신 그림)
+static BgVariant s_bgNext = BG_SUNSET;   // 넘어갈 배경. 준비되면 s_bgBlend 가 0 → 1
+static float     s_bgBlend = 0.0f;
+static const float BG_CROSSFADE_TIME = 2.0f;
+static const long long BG_PRELOAD_LEAD_MS = 5 * 1000;   // 전환 5초(실제 시간) 전부터 미리 디코드 (배속과 무관)
 
-static TimeOfDay g_tod_before = TIMEOFDAY_DAY;  // 전환 전 시간대
-static TimeOfDay g_tod_after = TIMEOFDAY_DAY;  // 전환 후 시간대
+// 시간대 색은 해 높이(sinf(2*pi*위상))로 연속으로 섞음: 지평선 = 노을색, 위로 낮 색, 아래로 밤 색
+static const float TINT_DAY_ELEV = 0.3f;     // 이 높이부터 완전히 낮 색
+static const float TINT_NIGHT_ELEV = 0.2f;   // 지평선 아래 이만큼부터 완전히 밤 색
 
 // -----------------------------
 // 인게임 BGM (랜덤 재생)
 // -----------------------------
 
-void update_weather_if_needed(void)
+// 날씨 서비스 알림 (weather_state.txt 가 바뀌어 새 값이 왔을 때만, 메인 스레드)
+static void on_weather_changed(const WeatherInfo* now, const WeatherInfo* before, void* ud)
 {
-    Uint32 now = SDL_GetTicks();
+    (void)before;
+    (void)ud;
+    g_weather = *now;
+    sim_set_weather(&s_sim, g_weather.tag);     // 상태 변화 속도
+    dayclock_set_sun(&g_dayClock, &g_weather);  // 일출/일몰로 시간대가 달라지면 바로 on_tod_changed
 
-    if (now - g_last_weather_check >= WEATHER_INTERVAL_MS) {
-        g_last_weather_check = now;
+    printf("[날씨 갱신]\n");
+    printf("TAG=%d  TEMP=%.2f  HUM=%d\n", g_weather.tag, g_weather.temp, g_weather.humidity);
+    printf("SUNRISE=%s  SUNSET=%s\n", g_weather.sunrise, g_weather.sunset);
+}
 
-        system("python assets/weather_update.py");
+// 시간대 전환 (DayClock 이 경계 시각에 정확히 한 번 호출). 색은 해 위상으로 따로 이어지므로 값만 바꿈
+static void on_tod_changed(TimeOfDay from, TimeOfDay to, void* ud)
+{
+    (void)from;
+    (void)ud;
+    g_timeOfDay = to;
+}
 
-        if (weather_load(&g_weather)) {
-            weather_compute_sun_secs(&g_weather);
-        }
+// 예보 타임라인: 바깥 온도/습도는 매 프레임 보간해서 넘기고, 다음 날씨 변화는 sim 에 미리 예약
+static void apply_forecast(void)
+{
+    Sint64 now = (Sint64)gameclock_time();
+    WeatherSample cur;
+    if (!weather_timeline_at(now, &cur)) {
+        // 예보가 없거나 지금 시각을 덮지 못함 → 낡은 값 대신 바깥 영향 끔
+        s_sim.outdoor_known = false;
+        return;
+    }
+    sim_set_outdoor(&s_sim, cur.temp, cur.humidity);
 
-        printf("[날씨 갱신]\n");
-        printf("TAG=%d  TEMP=%.2f  HUM=%d\n", g_weather.tag, g_weather.temp, g_weather.humidity);
-        printf("SUNRISE=%s  SUNSET=%s\n", g_weather.sunrise, g_weather.sunset);
+    WeatherTag tag;
+    Sint64 when;
+    if (weather_timeline_next_change(now, &tag, &when) && (tag != g_schedTag || when != g_schedWhen)) {
+        g_schedTag = tag;
+        g_schedWhen = when;
+        sim_schedule_weather(&s_sim, tag, (float)(when - now));
     }
 }
 
-static void render_time_tint(SDL_Renderer* r, TimeOfDay tod, int w, int h)
+static void tod_tint_color(TimeOfDay tod, Uint8* R, Uint8* G, Uint8* B, Uint8* A)
 {
-    Uint8 R = 0, G = 0, B = 0, A = 0;
-
     switch (tod) {
     case TIMEOFDAY_DAY:
-        R = 255; G = 245; B = 220; A = 20;
+        *R = 255; *G = 245; *B = 220; *A = 20;
         break;
     case TIMEOFDAY_SUNRISE:
     case TIMEOFDAY_SUNSET:
-        R = 255; G = 170; B = 120; A = 70;
+        *R = 255; *G = 170; *B = 120; *A = 70;
         break;
     case TIMEOFDAY_NIGHT:
-        R = 10;  G = 20;  B = 40;  A = 120;
+        *R = 10;  *G = 20;  *B = 40;  *A = 120;
         break;
     default:
-        A = 0;
+        *R = *G = *B = *A = 0;
         break;
     }
+}
+
+// 시간대 색 덮기. 해 위상(dayclock_sun_phase)에서 바로 계산하므로 전환 때 끊김이 없음
+static void render_time_tint(SDL_Renderer* r, float sunPhase, int w, int h)
+{
+    float elev = SDL_sinf(2.0f * 3.1415927f * sunPhase);
+    float t = elev >= 0.0f ? elev / TINT_DAY_ELEV : -elev / TINT_NIGHT_ELEV;
+    Uint8 r0, g0, b0, a0, r1, g1, b1, a1;
+    tod_tint_color(TIMEOFDAY_SUNSET, &r0, &g0, &b0, &a0);
+    tod_tint_color(elev >= 0.0f ? TIMEOFDAY_DAY : TIMEOFDAY_NIGHT, &r1, &g1, &b1, &a1);
+    if (t < 0.0f) t = 0.0f;
+    if (t > 1.0f) t = 1.0f;
+    Uint8 R = (Uint8)(r0 + (r1 - r0) * t);
+    Uint8 G = (Uint8)(g0 + (g1 - g0) * t);
+    Uint8 B = (Uint8)(b0 + (b1 - b0) * t);
+    Uint8 A = (Uint8)(a0 + (a1 - a0) * t);
 
     if (A == 0) return;
 
@@ -460,14 +255,14 @@ int gameplay_loading_job(void* u, float* out_p)
 
 // 시간 문자열
 static void get_current_time_string(char* out, size_t size) {
-    time_t now = time(NULL);
-    struct tm* t = localtime(&now);
-    strftime(out, size, "%H:%M:%S", t);
+    struct tm t;
+    gameclock_localtime(&t);
+    strftime(out, size, "%H:%M:%S", &t);
 }
 static void get_current_day_string(char* out, size_t size) {
-    time_t now = time(NULL);
-    struct tm* t = localtime(&now);
-    strftime(out, size, "%Y-%m-%d", t);
+    struct tm t;
+    gameclock_localtime(&t);
+    strftime(out, size, "%Y-%m-%d", &t);
 }
 
 // -----------------------------
@@ -490,18 +285,80 @@ static int s_lastBgm = -1;
 typedef struct {
     SDL_Rect rect;
     int      duration_ms;
-    SDL_Texture* texture; // fallback 시 사용
 } AnimFrame;
 
-static SDL_Texture* s_bgAtlas = NULL;
+// 배경 시트는 9600px 폭이라 렌더러 한도를 넘으면 s_bgLayout 대로 여러 페이지로 나눠 올림 (시간대 변형 모두 같은 배치)
+static AtlasLayout  s_bgLayout;
+static AtlasPages   s_bgAtlas;      // sunset (처음 화면, 변형이 준비될 때까지 대신 그림)
 static SDL_Texture* s_room = NULL;
 static SDL_Texture* s_room_open = NULL;
-static AnimFrame    s_bgFrames[128];
+static AnimFrame    s_bgFrames[ATLAS_MAX_FRAMES];
 static int          s_bgFrameCount = 0;
 static int          s_bgFrameIndex = 0;
 static float        s_bgFrameElapsedMs = 0.f;
 static bool         s_bgFramesUseAtlas = false;
 
+static BgVariant pick_background(TimeOfDay tod)
+{
+    if (tod == TIMEOFDAY_SUNRISE || tod == TIMEOFDAY_SUNSET) return BG_SUNSET;
+    return tod == TIMEOFDAY_DAY ? BG_SUNNY : BG_NIGHT;
+}
+
+// 상주 중인 배경 페이지 (아직 디코드 중이면 NULL). sunset 은 load_background_animation 이 들고 있음
+static const AtlasPages* background_texture(BgVariant v)
+{
+    if (v == BG_SUNSET && s_bgAtlas.count > 0) return &s_bgAtlas;
+    return thumb_cache_get_atlas(BG_VARIANT_PATHS[v]);
+}
+
+static void request_background(BgVariant v, int prio)
+{
+    if (v == BG_SUNSET && s_bgAtlas.count > 0) return;
+    thumb_cache_request_atlas(BG_VARIANT_PATHS[v], prio, &s_bgLayout);
+}
+
+static void update_background(float dt)
+{
+    thumb_cache_pump(G_Renderer, 1);   // 디코드 끝난 것 업로드 (프레임당 1장)
+
+    BgVariant want = pick_background(dayclock_current(&g_dayClock));
+
+    // 곧 바뀔 배경 미리 (DayClock 의 다음 시간대 전환)
+    TimeOfDay nextTod;
+    long long inMs;
+    dayclock_peek_next(&g_dayClock, &nextTod, &inMs);
+    long long inWallMs = (long long)((double)inMs / gameclock_scale());   // 게임 시간 → 실제 시간
+    if (inWallMs <= BG_PRELOAD_LEAD_MS)
+        request_background(pick_background(nextTod), THUMB_PRIO_PREFETCH);
+
+    request_background(s_bgCur, THUMB_PRIO_VISIBLE);
+    if (s_bgNext == s_bgCur && want != s_bgCur) {
+        s_bgNext = want;
+        s_bgBlend = 0.0f;
+    }
+    if (s_bgNext == s_bgCur) return;
+
+    // 새 배경이 올라올 때까지는 지금 배경 그대로 (검은 화면/멈춤 없음)
+    request_background(s_bgNext, THUMB_PRIO_VISIBLE);
+    if (!background_texture(s_bgNext)) return;
+    s_bgBlend += dt / BG_CROSSFADE_TIME;
+    if (s_bgBlend >= 1.0f) {
+        s_bgCur = s_bgNext;
+        s_bgBlend = 0.0f;
+    }
+}
+
+// 파티클 세기: 랜덤 날씨 이벤트면 최대, 아니면 바깥 습도에 따라
+static float weather_intensity(void)
+{
+    if (s_sim.weather_event_active) return 1.0f;
+    if (!s_sim.outdoor_known) return 0.6f;
+    float k = 0.3f + 0.7f * s_sim.outdoor_humidity / 100.0f;
+    if (k < 0.3f) k = 0.3f;
+    if (k > 1.0f) k = 1.0f;
+    return k;
+}
+
 ///////////////////////////////////////////////////////
 // 이벤트 애니메이션
 ///////////////////////////////////////////////////////
@@ -543,10 +400,16 @@ typedef struct
     float frameDuration;
 } SprayAnim;
 
-static SDL_Texture* s_texBugIdle = NULL;
-static SDL_Texture* s_texMoldIdle = NULL;
-static SDL_Texture* s_texBugSpray = NULL;
-static SDL_Texture* s_texMoldSpray = NULL;
+// 효과 시트는 프레임 대부분이 투명이라 로드할 때 불투명 영역만 남기고 같은 프레임은 합침 (atlas_load_trimmed)
+typedef struct {
+    AtlasLayout layout;
+    AtlasPages  pages;
+} EffectSheet;
+
+static EffectSheet s_bugIdle;
+static EffectSheet s_moldIdle;
+static EffectSheet s_bugSpray;
+static EffectSheet s_moldSpray;
 
 static IdleAnim s_bugIdleAnim = { 0 };
 static IdleAnim s_moldIdleAnim = { 0 };
@@ -559,9 +422,18 @@ typedef struct {
     int      duration_ms;
 } EventFrame;
 
-static SDL_Texture* s_eventAtlas = NULL;
-static EventFrame   s_eventFrames[32];
-static int          s_eventFrameCount = 0;
+#define EVENT_MAX_FRAMES 32
+#define EVENT_TYPE_COUNT 6      // event_play 의 type 1~6
+
+// 이벤트 시트 (json 프레임 + 잘라 둔 아틀라스). init 에서 종류별로 한 번만 만들어 둠
+typedef struct {
+    EffectSheet sheet;
+    EventFrame  frames[EVENT_MAX_FRAMES];
+    int         frameCount;
+} EventSheet;
+
+static EventSheet        s_eventSheets[EVENT_TYPE_COUNT];
+static const EventSheet* s_eventCur = NULL;   // 재생 중인 시트 (없으면 NULL)
 static int          s_eventFrameIndex = 0;
 static float        s_eventFrameElapsedMs = 0.f;
 
@@ -611,14 +483,13 @@ static void draw_text2(SDL_Renderer* r, SDL_Color color, int x, int y, int size_
     SDL_FreeSurface(surf);
 }
 
-static void destroy_frame_textures(void)
+static void free_background_animation(void)
 {
-    for (int i = 0; i < (int)SDL_arraysize(s_bgFrames); ++i) {
-        if (s_bgFrames[i].texture) {
-            SDL_DestroyTexture(s_bgFrames[i].texture);
-            s_bgFrames[i].texture = NULL;
-        }
-    }
+    atlas_free(&s_bgAtlas);
+    s_bgFrameCount = 0;
+    s_bgFrameIndex = 0;
+    s_bgFrameElapsedMs = 0.f;
+    s_bgFramesUseAtlas = false;
 }
 
 static void gameplay_ensure_bgm_loaded(void)
@@ -666,70 +537,47 @@ static void SDLCALL gameplay_on_music_finished(void)
 // -----------------------------
 // 이벤트 애니 helper
 // -----------------------------
-static void destroy_event_frames(void)
+// 가로 한 줄로 frames 칸이 놓인 시트
+static void load_effect_strip(EffectSheet* e, const char* path, int frameW, int frameH, int frames)
+{
+    SDL_Rect rects[ATLAS_MAX_FRAMES];
+    if (frames > ATLAS_MAX_FRAMES) frames = ATLAS_MAX_FRAMES;
+    for (int i = 0; i < frames; i++) rects[i] = (SDL_Rect){ i * frameW, 0, frameW, frameH };
+    atlas_free(&e->pages);
+    if (!atlas_load_trimmed(G_Renderer, path, rects, frames, &e->layout, &e->pages))
+        SDL_Log("GAMEPLAY: load %s fail", path);
+}
+
+static const struct { const char* png; const char* json; } kEventSheets[EVENT_TYPE_COUNT] = {
+    { ASSETS_IMAGES_DIR "event_water.png",    ASSETS_DIR "data/event_water.json" },
+    { ASSETS_IMAGES_DIR "event_bugs.png",     ASSETS_DIR "data/event_bugs.json" },
+    { ASSETS_IMAGES_DIR "event_gompang.png",  ASSETS_DIR "data/event_gompang.json" },
+    { ASSETS_IMAGES_DIR "event_tempUp.png",   ASSETS_DIR "data/event_tempUp.json" },
+    { ASSETS_IMAGES_DIR "event_tempDown.png", ASSETS_DIR "data/event_tempDown.json" },
+    { ASSETS_IMAGES_DIR "event_food.png",     ASSETS_DIR "data/event_food.json" },
+};
+
+static void free_event_sheets(void)
 {
-    if (s_eventAtlas) {
-        SDL_DestroyTexture(s_eventAtlas);
-        s_eventAtlas = NULL;
+    for (int i = 0; i < EVENT_TYPE_COUNT; ++i) {
+        atlas_free(&s_eventSheets[i].sheet.pages);
+        s_eventSheets[i].frameCount = 0;
     }
-    s_eventFrameCount = 0;
+    s_eventCur = NULL;
+    s_eventPlaying = 0;
     s_eventFrameIndex = 0;
     s_eventFrameElapsedMs = 0.f;
 }
 
-static void load_event_animation(void)
+static void load_event_sheet(EventSheet* ev, const char* pngPath, const char* jsonPath)
 {
-    destroy_event_frames();
-
-    const char* pngPath = NULL;
-    const char* jsonPath = NULL;
-
-    switch (s_eventtype) {
-    case 1:
-        pngPath = ASSETS_IMAGES_DIR "event_water.png";
-        jsonPath = ASSETS_DIR       "data/event_water.json";
-        break;
-    case 2:
-        pngPath = ASSETS_IMAGES_DIR "event_bugs.png";
-        jsonPath = ASSETS_DIR       "data/event_bugs.json";
-        break;
-    case 3:
-        pngPath = ASSETS_IMAGES_DIR "event_gompang.png";
-        jsonPath = ASSETS_DIR       "data/event_gompang.json";
-        break;
-    case 4:
-        pngPath = ASSETS_IMAGES_DIR "event_tempUp.png";
-        jsonPath = ASSETS_DIR       "data/event_tempUp.json";
-        break;
-    case 5:
-        pngPath = ASSETS_IMAGES_DIR "event_tempDown.png";
-        jsonPath = ASSETS_DIR       "data/event_tempDown.json";
-        break;
-    case 6:
-        pngPath = ASSETS_IMAGES_DIR "event_food.png";
-        jsonPath = ASSETS_DIR       "data/event_food.json";
-        break;
-    default:
-        SDL_Log("[event] unknown type %d", s_eventtype);
-        return;
-    }
-
-    s_eventAtlas = IMG_LoadTexture(G_Renderer, pngPath);
-    if (!s_eventAtlas) {
-        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
-            "[event] IMG_LoadTexture fail %s : %s",
-            pngPath, IMG_GetError());
-        return;
-    }
-
-    int atlasW = 0, atlasH = 0;
-    SDL_QueryTexture(s_eventAtlas, NULL, NULL, &atlasW, &atlasH);
+    atlas_free(&ev->sheet.pages);
+    ev->frameCount = 0;
 
     JSON_Value* root = json_parse_file(jsonPath);
     if (!root) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION,
             "[event] json parse fail %s", jsonPath);
-        destroy_event_frames();
         return;
     }
 
@@ -737,12 +585,11 @@ static void load_event_animation(void)
     JSON_Object* framesObj = json_object_get_object(robj, "frames");
     if (!framesObj) {
         json_value_free(root);
-        destroy_event_frames();
         return;
     }
 
     size_t count = json_object_get_count(framesObj);
-    for (size_t i = 0; i < count && s_eventFrameCount < (int)SDL_arraysize(s_eventFrames); ++i) {
+    for (size_t i = 0; i < count && ev->frameCount < EVENT_MAX_FRAMES; ++i) {
         const char* key = json_object_get_name(framesObj, i);
         JSON_Object* fobj = json_object_get_object(framesObj, key);
         if (!fobj) continue;
@@ -758,19 +605,39 @@ static void load_event_animation(void)
         fr.duration_ms = (int)json_object_get_number(fobj, "duration");
         if (fr.duration_ms <= 0) fr.duration_ms = 100;
 
-        s_eventFrames[s_eventFrameCount++] = fr;
+        ev->frames[ev->frameCount++] = fr;
     }
 
     json_value_free(root);
 
-    SDL_Log("[event] loaded %d frames (atlas=%p, size=%dx%d)",
-        s_eventFrameCount, (void*)s_eventAtlas, atlasW, atlasH);
+    // 전체 화면(1920x1080)으로 늘려 그리는 시트라 투명 테두리를 잘라 두면 블렌딩 면적이 크게 줄어듦
+    SDL_Rect rects[EVENT_MAX_FRAMES];
+    for (int i = 0; i < ev->frameCount; ++i) rects[i] = ev->frames[i].rect;
+    if (ev->frameCount <= 0 ||
+        !atlas_load_trimmed(G_Renderer, pngPath, rects, ev->frameCount, &ev->sheet.layout, &ev->sheet.pages)) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[event] atlas load fail %s", pngPath);
+        atlas_free(&ev->sheet.pages);
+        ev->frameCount = 0;
+        return;
+    }
+
+    SDL_Log("[event] loaded %s: %d frames (%d page(s))", pngPath, ev->frameCount, ev->sheet.pages.count);
+}
+
+// 클릭 때 디코드/자르기/업로드가 없도록 씬 진입 때 전부 준비
+static void load_event_sheets(void)
+{
+    for (int i = 0; i < EVENT_TYPE_COUNT; ++i) {
+        if (s_eventSheets[i].sheet.pages.count <= 0)
+            load_event_sheet(&s_eventSheets[i], kEventSheets[i].png, kEventSheets[i].json);
+    }
 }
 
 static void event_anim_start(void)
 {
-    if (s_eventFrameCount <= 0 || !s_eventAtlas) {
+    if (!s_eventCur || s_eventCur->frameCount <= 0 || s_eventCur->sheet.pages.count <= 0) {
         SDL_Log("[event] cannot start: no frames or atlas");
+        s_eventPlaying = 0;
         return;
     }
 
@@ -796,21 +663,21 @@ static void event_anim_start(void)
 static void event_anim_update(float dt)
 {
     if (!s_eventPlaying) return;
-    if (s_eventFrameCount <= 0) return;
+    if (!s_eventCur || s_eventCur->frameCount <= 0) return;
 
     s_eventFrameElapsedMs += dt * 1000.f;
 
-    int duration = s_eventFrames[s_eventFrameIndex].duration_ms;
+    int duration = s_eventCur->frames[s_eventFrameIndex].duration_ms;
     if (duration <= 0) duration = 100;
 
     while (s_eventFrameElapsedMs >= duration) {
         s_eventFrameElapsedMs -= duration;
         s_eventFrameIndex++;
 
-        if (s_eventFrameIndex >= s_eventFrameCount) {
+        if (s_eventFrameIndex >= s_eventCur->frameCount) {
             if (s_eventOneShot) {
                 s_eventPlaying = 0;
-                s_eventFrameIndex = s_eventFrameCount - 1;
+                s_eventFrameIndex = s_eventCur->frameCount - 1;
                 break;
             }
             else {
@@ -818,7 +685,7 @@ static void event_anim_update(float dt)
             }
         }
 
-        duration = s_eventFrames[s_eventFrameIndex].duration_ms;
+        duration = s_eventCur->frames[s_eventFrameIndex].duration_ms;
         if (duration <= 0) duration = 100;
     }
 }
@@ -826,20 +693,22 @@ static void event_anim_update(float dt)
 static void event_anim_render(SDL_Renderer* r)
 {
     if (!s_eventPlaying) return;
-    if (!s_eventAtlas)   return;
-    if (s_eventFrameCount <= 0) return;
+    if (!s_eventCur || s_eventCur->frameCount <= 0) return;
 
-    EventFrame* fr = &s_eventFrames[s_eventFrameIndex];
-    SDL_Rect src = fr->rect;
-
-    SDL_RenderCopy(r, s_eventAtlas, &src, &s_eventDstRect);
+    atlas_draw_frame(r, &s_eventCur->sheet.pages, s_eventFrameIndex, &s_eventDstRect);
 }
 
-// 타입 지정 + 로드 + 시작 한 번에
+// 타입 지정 + 시작 한 번에 (시트는 init 에서 미리 만들어 둠)
 static void event_play(int type)
 {
     s_eventtype = type;
-    load_event_animation();
+    if (type < 1 || type > EVENT_TYPE_COUNT) {
+        SDL_Log("[event] unknown type %d", type);
+        s_eventCur = NULL;
+        s_eventPlaying = 0;
+        return;
+    }
+    s_eventCur = &s_eventSheets[type - 1];
     event_anim_start();
 }
 
@@ -880,45 +749,43 @@ static void update_spray_anims(float dt)
     update_spray_anim(&s_moldSprayAnim, dt);
 }
 
-static void render_idle_with_frames(SDL_Renderer* r, SDL_Texture* tex, const IdleAnim* a,
+static void render_idle_with_frames(SDL_Renderer* r, const EffectSheet* sheet, const IdleAnim* a,
     int frameW, int frameH, int totalFrames, int x, int y)
 {
-    if (!tex)
+    if (sheet->pages.count <= 0)
         return;
     int frameCount = (totalFrames > 0) ? totalFrames : 1;
     int frameIdx = (a && frameCount > 1) ? a->currentFrame % frameCount : 0;
-    SDL_Rect src = { frameIdx * frameW, 0, frameW, frameH };
     SDL_Rect dst = { x, y, frameW, frameH };
-    SDL_RenderCopy(r, tex, &src, &dst);
+    atlas_draw_frame(r, &sheet->pages, frameIdx, &dst);
 }
 
-static void render_spray(SDL_Renderer* r, SDL_Texture* tex, const SprayAnim* a,
+static void render_spray(SDL_Renderer* r, const EffectSheet* sheet, const SprayAnim* a,
     int frameW, int frameH, int totalFrames, int x, int y)
 {
-    if (!tex || !a || !a->active)
+    if (sheet->pages.count <= 0 || !a || !a->active)
         return;
     int frameCount = (totalFrames > 0) ? totalFrames : 1;
     int frameIdx = (a->currentFrame < frameCount) ? a->currentFrame : frameCount - 1;
-    SDL_Rect src = { frameIdx * frameW, 0, frameW, frameH };
     SDL_Rect dst = { x, y, frameW, frameH };
-    SDL_RenderCopy(r, tex, &src, &dst);
+    atlas_draw_frame(r, &sheet->pages, frameIdx, &dst);
 }
 
 static void render_bug_mold(SDL_Renderer* r, int screenW, int screenH)
 {
     // 화분 기준 대략적인 위치 (조정해야함.. 싹싹🙏)
     int baseY = screenH - 500;
-    if (s_hasBug)
+    if (s_sim.has_bug)
     {
         int x = screenW / 2 - 300;
-        render_idle_with_frames(r, s_texBugIdle, &s_bugIdleAnim,
+        render_idle_with_frames(r, &s_bugIdle, &s_bugIdleAnim,
             BUG_IDLE_FRAME_W, BUG_IDLE_FRAME_H, BUG_IDLE_FRAMES,
             x, baseY);
     }
-    if (s_hasMold)
+    if (s_sim.has_mold)
     {
         int x = screenW / 2 - 200;
-        render_idle_with_frames(r, s_texMoldIdle, &s_moldIdleAnim,
+        render_idle_with_frames(r, &s_moldIdle, &s_moldIdleAnim,
             MOLD_IDLE_FRAME_W, MOLD_IDLE_FRAME_H, MOLD_IDLE_FRAMES,
             x, baseY);
     }
@@ -927,10 +794,10 @@ static void render_bug_mold(SDL_Renderer* r, int screenW, int screenH)
 static void render_spray_anims(SDL_Renderer* r, int screenW, int screenH)
 {
     int baseY = screenH - 500;
-    render_spray(r, s_texBugSpray, &s_bugSprayAnim,
+    render_spray(r, &s_bugSpray, &s_bugSprayAnim,
         BUG_SPRAY_FRAME_W, BUG_SPRAY_FRAME_H, BUG_SPRAY_FRAMES,
         screenW / 2 - 300, baseY);
-    render_spray(r, s_texMoldSpray, &s_moldSprayAnim,
+    render_spray(r, &s_moldSpray, &s_moldSprayAnim,
         MOLD_SPRAY_FRAME_W, MOLD_SPRAY_FRAME_H, MOLD_SPRAY_FRAMES,
         screenW / 2 - 200, baseY);
 }
@@ -954,41 +821,34 @@ static void on_exit(void* ud)
     back_panel = false;
 }
 
+static void log_level_up(int gained)
+{
+    if (gained > 0)
+        SDL_Log("[GAME] plant level up! level = %d", s_sim.level);
+}
+
 static void on_water(void* ud)
 {
     (void)ud;
     s_waterCount++;
-    if (s_plant) log_water(s_plant->id, 120);
+    if (s_plant) log_water(plantdb_id(s_plant), 120);
 
     event_play(1);      // 물 이벤트
-    
 
-    float mul = get_exp_multiplier();
-    s_plantExp += 1.f * mul;
-    
-    add_exp(EXP_WATER); //물 경험치 추가🐥
-
-    s_status.moisture += 10.f;
-
-    if (s_status.moisture > 100.f)
-        s_status.moisture = 100.f;
-
-    
+    log_level_up(sim_action_water(&s_sim)); //물 경험치 추가🐥
 }
 
 static void on_window(void* ud)
 {
     (void)ud;
-    s_windowOpen = !s_windowOpen;
+    sim_action_toggle_window(&s_sim);
 
     ui_button_init(&s_btnWindow, s_btnWindow.r, "");
     ui_button_set_callback(&s_btnWindow, on_window, NULL);
     ui_button_set_sfx(&s_btnWindow, G_SFX_Click, NULL);
 
-    window_open = !window_open;
-
-    SDL_Log(s_windowOpen ? "[GAME] window open." : "[GAME] window close.");
-    if (s_plant) log_window(s_plant->id, s_windowOpen);
+    SDL_Log(s_sim.window_open ? "[GAME] window open." : "[GAME] window close.");
+    if (s_plant) log_window(plantdb_id(s_plant), s_sim.window_open);
 }
 
 static void on_nobug(void* ud)
@@ -997,27 +857,19 @@ static void on_nobug(void* ud)
     ui_button_set_sfx(&s_btnnobug, G_SFX_Click, NULL);
     event_play(2);
 
-    if (!s_hasBug)
+    // 실제 상태 변화 + 경험치 (킬 성공시에만)
+    int level = s_sim.level;
+    if (!sim_action_kill_bug(&s_sim))
     {
         SDL_Log("[EVENT] no bug to kill");
         return;
     }
+    log_level_up(s_sim.level - level);
 
-    // 2) 분무기/이펙트 애니메이션 시작 (스프레이 전용)
-    
+    // 분무기/이펙트 애니메이션 시작 (스프레이 전용, 시각 효과는 계속 재생)
     s_bugSprayAnim.active = true;
     s_bugSprayAnim.timer = 0.f;
     s_bugSprayAnim.currentFrame = 0;
-    
-
-    // 3) 실제 상태 변화 (즉시 제거, 시각 효과는 계속 재생)
-    s_hasBug = false;
-    s_status.happiness += 10.f;
-    if (s_status.happiness > 100.f)
-        s_status.happiness = 100.f;
-
-    // 4) 경험치 + 레벨업 (킬 성공시에만)
-    add_exp(EXP_KILL_BUG);
 
     SDL_Log("[EVENT] kill bug");
 }
@@ -1028,27 +880,19 @@ static void on_nogom(void* ud)
     ui_button_set_sfx(&s_btnnogom, G_SFX_Click, NULL);
     event_play(3);
 
-    if (!s_hasMold)
+    // 곰팡이 제거 + 행복도 + 경험치
+    int level = s_sim.level;
+    if (!sim_action_remove_mold(&s_sim))
     {
         SDL_Log("[EVENT] no mold to remove");
         return;
     }
+    log_level_up(s_sim.level - level);
 
-    // 2) 분무기/이펙트 애니 시작 (스프레이 전용)
-    
+    // 분무기/이펙트 애니 시작 (스프레이 전용)
     s_moldSprayAnim.active = true;
     s_moldSprayAnim.timer = 0.f;
     s_moldSprayAnim.currentFrame = 0;
-    
-
-    // 3) 곰팡이 제거 + 행복도 (즉시 플래그 내림, 애니는 계속 재생)
-    s_hasMold = false;
-    s_status.happiness += 10.f;
-    if (s_status.happiness > 100.f)
-        s_status.happiness = 100.f;
-
-    // 4) 경험치 + 레벨업
-    add_exp(EXP_REMOVE_MOLD);
 
     SDL_Log("[EVENT] remove mold");
 }
@@ -1059,13 +903,8 @@ static void on_ifhot(void* ud)
     ui_button_set_sfx(&s_btnifhot, G_SFX_Click, NULL);
     event_play(5);
 
-    float mul = get_exp_multiplier();
-    s_plantExp += 1.f * mul;
-
-    add_exp(EXP_TEMP_DOWN);
+    log_level_up(sim_action_temp_down(&s_sim));
     SDL_Log("temperature down");
-    s_room_temperature--;
-    s_status.temp = (float)s_room_temperature;
 }
 
 static void on_ifcold(void* ud)
@@ -1074,13 +913,8 @@ static void on_ifcold(void* ud)
     ui_button_set_sfx(&s_btnifcold, G_SFX_Click, NULL);
     event_play(4);
 
-    float mul = get_exp_multiplier();
-    s_plantExp += 1.f * mul;
-
-    add_exp(EXP_TEMP_UP);
+    log_level_up(sim_action_temp_up(&s_sim));
     SDL_Log("temperature up");
-    s_room_temperature++;
-    s_status.temp = (float)s_room_temperature;
 }
 
 static void on_biryo(void* ud)
@@ -1089,13 +923,7 @@ static void on_biryo(void* ud)
     ui_button_set_sfx(&s_btnbiryo, G_SFX_Click, NULL);
     event_play(6);
 
-    s_status.nutrition += 20.f; // 추측
-    if (s_status.nutrition > 100.f) s_status.nutrition = 100.f;
-
-    float mul = get_exp_multiplier();
-    s_plantExp += 1.f * mul;
-
-    add_exp(EXP_GIVE_FERT);
+    log_level_up(sim_action_fertilize(&s_sim));
 
     SDL_Log("give nutrients");
 }
@@ -1185,21 +1013,15 @@ static void layout(void)
 }
 
 // -----------------------------
-// 배경 애니메이션 로드 (기존 내용 그대로 둠)
+// 배경 애니메이션 로드
+// 시트를 표면으로 읽어 프레임을 파싱한 뒤, 렌더러 한도에 맞춘 배치(s_bgLayout)로 페이지를 올림
 // -----------------------------
 static void load_background_animation(void)
 {
-    destroy_frame_textures();
-    s_bgFrameCount = 0;
-    s_bgFrameIndex = 0;
-    s_bgFrameElapsedMs = 0.f;
-    s_bgFramesUseAtlas = false;
+    free_background_animation();
 
-    if (s_bgAtlas) { SDL_DestroyTexture(s_bgAtlas); s_bgAtlas = NULL; }
-
-
-    s_bgAtlas = IMG_LoadTexture(G_Renderer, ASSETS_IMAGES_DIR "sunset.png");
-    if (!s_bgAtlas) {
+    SDL_Surface* sheet = IMG_Load(ASSETS_IMAGES_DIR "sunset.png");
+    if (!sheet) {
         SDL_Log("[ANIM] sunset.png failed: %s", IMG_GetError());
     }
 
@@ -1207,14 +1029,13 @@ static void load_background_animation(void)
     s_room_open = IMG_LoadTexture(G_Renderer, ASSETS_IMAGES_DIR "room-2-2.png");
 
     JSON_Value* root = json_parse_file(ASSETS_DIR "data/sunset.json");
-    if (!root) { SDL_Log("[ANIM] parse fail"); return; }
+    if (!root) { SDL_Log("[ANIM] parse fail"); if (sheet) SDL_FreeSurface(sheet); return; }
     JSON_Object* robj = json_value_get_object(root);
 
     JSON_Object* framesObj = json_object_get_object(robj, "frames");
     JSON_Array* framesArr = json_object_get_array(robj, "frames");
 
-    int atlasW = 0, atlasH = 0;
-    if (s_bgAtlas) SDL_QueryTexture(s_bgAtlas, NULL, NULL, &atlasW, &atlasH);
+    int atlasW = sheet ? sheet->w : 0, atlasH = sheet ? sheet->h : 0;
 
     // frames as object
     if (framesObj) {
@@ -1307,62 +1128,28 @@ static void load_background_animation(void)
 
     if (s_bgFrameCount <= 0) {
         SDL_Log("[ANIM] parsed but no valid frames");
+        if (sheet) SDL_FreeSurface(sheet);
         return;
     }
 
-    // 아틀라스 텍스처가 있다면 아틀라스 모드 사용(성능 좋음)
-    if (s_bgAtlas) { s_bgFramesUseAtlas = true; return; }
-
-    // (옵션) 아틀라스가 없다면 분할 텍스쳐 생성
-    SDL_Surface* atlasSurface = IMG_Load(ASSETS_IMAGES_DIR "room.png");
-    if (!atlasSurface) { SDL_Log("[ANIM] fallback surface load fail: %s", IMG_GetError()); s_bgFrameCount = 0; return; }
-
-    if (atlasSurface->format->format != SDL_PIXELFORMAT_RGBA32) {
-        SDL_Surface* converted = SDL_ConvertSurfaceFormat(atlasSurface, SDL_PIXELFORMAT_RGBA32, 0);
-        if (!converted) {
-            SDL_Log("[ANIM] surface convert fail: %s", SDL_GetError());
-            SDL_FreeSurface(atlasSurface);
-            s_bgFrameCount = 0;
-            return;
-        }
-        SDL_FreeSurface(atlasSurface);
-        atlasSurface = converted;
-    }
-
-    for (int i = 0; i < s_bgFrameCount; ++i) {
-        AnimFrame* fr = &s_bgFrames[i];
-        SDL_Surface* frameSurface =
-            SDL_CreateRGBSurfaceWithFormat(0, fr->rect.w, fr->rect.h, 32, atlasSurface->format->format);
-        if (!frameSurface) { SDL_Log("[ANIM] create frame surface fail: %s", SDL_GetError()); continue; }
-
-        if (SDL_BlitSurface(atlasSurface, &fr->rect, frameSurface, NULL) < 0) {
-            SDL_Log("[ANIM] blit fail: %s", SDL_GetError());
-            SDL_FreeSurface(frameSurface);
-            continue;
-        }
-
-        SDL_Texture* tex = SDL_CreateTextureFromSurface(G_Renderer, frameSurface);
-        SDL_FreeSurface(frameSurface);
-        if (!tex) { SDL_Log("[ANIM] create texture fail: %s", SDL_GetError()); continue; }
-        fr->texture = tex;
-    }
-
-    SDL_FreeSurface(atlasSurface);
-
-    // 유효 텍스쳐만 남기기(compact)
-    int write = 0;
-    for (int read = 0; read < s_bgFrameCount; ++read) {
-        if (!s_bgFrames[read].texture) continue;
-        if (write != read) s_bgFrames[write] = s_bgFrames[read];
-        ++write;
+    // 프레임 → (페이지, 사각형). 한도 안이면 원본 그대로 한 장
+    SDL_Rect rects[ATLAS_MAX_FRAMES];
+    int maxW, maxH;
+    for (int i = 0; i < s_bgFrameCount; ++i) rects[i] = s_bgFrames[i].rect;
+    atlas_max_texture_size(G_Renderer, &maxW, &maxH);
+    if (!atlas_layout_build(rects, s_bgFrameCount, maxW, maxH, &s_bgLayout)) {
+        s_bgFrameCount = 0;
+        if (sheet) SDL_FreeSurface(sheet);
+        return;
     }
-    s_bgFrameCount = write;
 
-    if (s_bgFrameCount == 0) {
-        SDL_Log("[ANIM] no usable splitted textures");
-        return;
+    // 시간대 변형(sunny/night)은 같은 배치로 thumb_cache 가 올림. sunset 이 없어도 그쪽은 그대로 동작
+    if (sheet) {
+        atlas_upload(G_Renderer, sheet, &s_bgLayout, &s_bgAtlas);
+        SDL_FreeSurface(sheet);
     }
-    SDL_Log("[ANIM] using fallback splitted textures");
+    s_bgFramesUseAtlas = true;
+    SDL_Log("[ANIM] bg %d frames in %d page(s)", s_bgFrameCount, s_bgLayout.page_count);
 }
 
 // -----------------------------
@@ -1380,6 +1167,7 @@ static void init(void* arg)
     G_SelectedPlantIndex = idx;
     s_plant = plantdb_get(idx);
     if (!s_plant) { scene_switch(SCENE_SELECT_PLANT); return; }
+    stats_store_open(plantdb_id(s_plant));
 
     if (s_bgFrameCount <= 0) {
         load_background_animation();
@@ -1388,51 +1176,22 @@ static void init(void* arg)
     SDL_Log("[GAME] bg frames loaded: count=%d, useAtlas=%d", s_bgFrameCount, (int)s_bgFramesUseAtlas);
 
     s_waterCount = 0;
-    s_windowOpen = false;
     s_light_level = 0;
 
     SDL_Log("[GAME] bg frames loaded: count=%d, useAtlas=%d", s_bgFrameCount, (int)s_bgFramesUseAtlas);
 
     s_waterCount = 0;
-    s_windowOpen = false;
 
     if (!s_pot) {
         s_pot = IMG_LoadTexture(G_Renderer, ASSETS_IMAGES_DIR "pot.png");
         if (!s_pot) SDL_Log("GAMEPLAY: load pot.png fail: %s", IMG_GetError());
     }
 
-    if (!s_bgDay) {
+    // 배경 변형은 작업 스레드가 풀어 둠 (지금 것 먼저, 나머지는 전환이 다가오면). 변형마다 한 칸
+    thumb_cache_init(BG_VARIANT_COUNT);
 
-        s_bgDay = IMG_LoadTexture(G_Renderer, ASSETS_IMAGES_DIR "sunny.png");
-        if (!s_bgDay) SDL_Log("GAMEPLAY: load bg_day.png fail: %s", IMG_GetError());
-    }
-
-    if (!s_bgNight) {
-
-        s_bgNight = IMG_LoadTexture(G_Renderer, ASSETS_IMAGES_DIR "night.png");
-        if (!s_bgNight) SDL_Log("GAMEPLAY: load bg_night.png fail: %s", IMG_GetError());
-    }
-
-    if (!s_bgSunrise) {
-
-        s_bgSunrise = IMG_LoadTexture(G_Renderer, ASSETS_IMAGES_DIR "sunset.png");
-        if (!s_bgSunrise) SDL_Log("GAMEPLAY: load bg_sunrise.png fail: %s", IMG_GetError());
-    }
-
-
-    if (!s_weatherClouds) {
-        s_weatherClouds = IMG_LoadTexture(G_Renderer, ASSETS_IMAGES_DIR "cloud.png");
-    }
-
-    if (!s_weatherRain) {
 
-        s_weatherRain = IMG_LoadTexture(G_Renderer, ASSETS_IMAGES_DIR "rainy.png"); // ?
-    }
-
-    if (!s_weatherSnow) {
-
-        s_weatherSnow = IMG_LoadTexture(G_Renderer, ASSETS_IMAGES_DIR "snowy.png");
-    }
+    weather_fx_init();
 
 
 
@@ -1513,30 +1272,15 @@ static void init(void* arg)
         else SDL_Log("exit loading success");
     }
 
-    if (!s_texBugIdle)
-    {
-        s_texBugIdle = IMG_LoadTexture(G_Renderer, ASSETS_IMAGES_DIR "event_bugs.png");
-        if (!s_texBugIdle)
-            SDL_Log("GAMEPLAY: load event_bugs.png fail: %s", IMG_GetError());
-    }
-    if (!s_texMoldIdle)
-    {
-        s_texMoldIdle = IMG_LoadTexture(G_Renderer, ASSETS_IMAGES_DIR "event_gompang.png");
-        if (!s_texMoldIdle)
-            SDL_Log("GAMEPLAY: load event_gompang.png fail: %s", IMG_GetError());
-    }
-    if (!s_texBugSpray)
-    {
-        s_texBugSpray = IMG_LoadTexture(G_Renderer, ASSETS_IMAGES_DIR "event_bugSpray.png");
-        if (!s_texBugSpray)
-            SDL_Log("GAMEPLAY: load event_bugSpray.png fail: %s", IMG_GetError());
-    }
-    if (!s_texMoldSpray)
-    {
-        s_texMoldSpray = IMG_LoadTexture(G_Renderer, ASSETS_IMAGES_DIR "event_gompangSpray.png");
-        if (!s_texMoldSpray)
-            SDL_Log("GAMEPLAY: load event_gompangSpray.png fail: %s", IMG_GetError());
-    }
+    if (s_bugIdle.pages.count <= 0)
+        load_effect_strip(&s_bugIdle, ASSETS_IMAGES_DIR "event_bugs.png", BUG_IDLE_FRAME_W, BUG_IDLE_FRAME_H, BUG_IDLE_FRAMES);
+    if (s_moldIdle.pages.count <= 0)
+        load_effect_strip(&s_moldIdle, ASSETS_IMAGES_DIR "event_gompang.png", MOLD_IDLE_FRAME_W, MOLD_IDLE_FRAME_H, MOLD_IDLE_FRAMES);
+    if (s_bugSpray.pages.count <= 0)
+        load_effect_strip(&s_bugSpray, ASSETS_IMAGES_DIR "event_bugSpray.png", BUG_SPRAY_FRAME_W, BUG_SPRAY_FRAME_H, BUG_SPRAY_FRAMES);
+    if (s_moldSpray.pages.count <= 0)
+        load_effect_strip(&s_moldSpray, ASSETS_IMAGES_DIR "event_gompangSpray.png", MOLD_SPRAY_FRAME_W, MOLD_SPRAY_FRAME_H, MOLD_SPRAY_FRAMES);
+    load_event_sheets();
 
     s_bugIdleAnim.totalFrames = BUG_IDLE_FRAMES;
     s_bugIdleAnim.frameDuration = 1.0f / IDLE_FPS;
@@ -1550,13 +1294,26 @@ static void init(void* arg)
 
 
 
-    // 날씨 데이터 초기 로드
-    if (weather_load(&g_weather)) {
+    // 날씨 데이터: 서비스가 이미 받아 둔 것 (아직 없으면 기본값, 오면 on_weather_changed 에서 반영)
+    const WeatherInfo* curWeather = weather_service_current();
+    if (curWeather) {
+        g_weather = *curWeather;
+    }
+    else {
+        SDL_memset(&g_weather, 0, sizeof(g_weather));
         weather_compute_sun_secs(&g_weather);
     }
-    g_last_weather_check = SDL_GetTicks();
-    g_timeOfDay = weather_get_time_of_day(&g_weather);
-    g_last_tod_check = SDL_GetTicks();
+    if (!g_weatherSub)
+        g_weatherSub = weather_service_subscribe(on_weather_changed, NULL);
+    g_schedTag = WEATHER_TAG_UNKNOWN;
+    g_schedWhen = 0;
+    dayclock_init(&g_dayClock, &g_weather, on_tod_changed, NULL);
+    g_timeOfDay = dayclock_current(&g_dayClock);
+
+    // 들어올 때부터 지금 시간대 배경 (sunset 에서 크로스페이드로 넘어가지 않게)
+    s_bgCur = s_bgNext = pick_background(g_timeOfDay);
+    s_bgBlend = 0.0f;
+    request_background(s_bgCur, THUMB_PRIO_VISIBLE);
 
     // 오디오
     if (Mix_PlayingMusic()) {
@@ -1623,22 +1380,34 @@ static void init(void* arg)
     ui_button_set_icons(&s_btnexit, s_exit, texexitHover, texexitPressed);
 
 
-    s_status.moisture = 60.f;
-    s_status.temp = (float)s_room_temperature; // 방 온도 따라감
-    s_status.humidity = 60.f;
-    s_status.light = 0.f;
-    s_status.happiness = 70.f;
-    s_status.nutrition = 70.f;
+    // 경험치/레벨/방 상태는 씬을 다시 들어와도 유지, 상태값만 초기화
+    if (!s_simReady) {
+        sim_init(&s_sim, s_plant, NULL, (Uint64)time(NULL));
+        s_sim.level = 3;
+        s_simReady = true;
+    }
+    s_sim.plant = s_plant;
+    if (snapshot_apply_pending(&s_sim)) {
+        // 이어하기: 저장된 상태 그대로 (날씨 이벤트 중이면 이벤트 날씨 유지)
+        sim_set_weather(&s_sim, g_weather.tag);
+    }
+    else {
+        s_sim.window_open = false;
+        sim_set_weather(&s_sim, g_weather.tag);
+        sim_reset_status(&s_sim);
+    }
+    s_lastSnapshot = SDL_GetTicks();
+    s_lastStatSec = -1;
 
-    if (s_plantLevel == 1) {
+    if (s_sim.level == 1) {
         s_monstera = IMG_LoadTexture(G_Renderer, ASSETS_IMAGES_DIR "monsteraLv1.png");
     }
-    else if (s_plantLevel == 2) {
+    else if (s_sim.level == 2) {
         s_monstera = IMG_LoadTexture(G_Renderer, ASSETS_IMAGES_DIR "monsteraLv2.png");
         //anim_load_from_json(G_Renderer, ASSETS_IMAGES_DIR "monsteraLv2.png", ASSETS_DIR "data/monsteraLv2.json", s_plantFrames, 64, &s_monstera, &s_plantFrameCount);
 
     }
-    else if (s_plantLevel == 3) {
+    else if (s_sim.level == 3) {
         s_monstera = IMG_LoadTexture(G_Renderer, ASSETS_IMAGES_DIR "monsteraLv3.png");
         //anim_load_from_json(G_Renderer, ASSETS_IMAGES_DIR "monsteraLv3.png", ASSETS_DIR "data/monsteraLv3.json", s_plantFrames, 64, &s_monstera, &s_plantFrameCount);
     }
@@ -1661,6 +1430,13 @@ static void handle(SDL_Event* e)
         if (e->key.keysym.sym == SDLK_ESCAPE) { scene_switch_fade(SCENE_MAINMENU, 0.2f, 0.4f); return; }
         if (e->key.keysym.sym == SDLK_w) { on_window(NULL); }
         if (e->key.keysym.sym == SDLK_SPACE) { on_water(NULL); }
+        if (e->key.keysym.sym == SDLK_TAB) { scene_switch_fade(SCENE_STATS, 0.2f, 0.3f); return; }
+
+        // QA/시연용 시간 조작: F5 일시정지, F6 1분 진행(일시정지 중), F7/F8 배속 ÷10/×10
+        if (e->key.keysym.sym == SDLK_F5) { gameclock_set_paused(!gameclock_paused()); }
+        if (e->key.keysym.sym == SDLK_F6) { gameclock_step(60.f); }
+        if (e->key.keysym.sym == SDLK_F7) { gameclock_set_scale(gameclock_scale() / 10.f); }
+        if (e->key.keysym.sym == SDLK_F8) { gameclock_set_scale(gameclock_scale() * 10.f); }
     }
 
     ui_button_handle(&s_btnBack, e);
@@ -1700,229 +1476,78 @@ static void update(float dt)
         }
     }
 
-    update_weather_if_needed();
+    // 시간대: 다음 전환 시각과 비교만 (바뀌는 순간 on_tod_changed)
+    dayclock_tick(&g_dayClock);
 
-    // 시간대는 10초마다 한 번만 다시 계산
-    Uint32 now = SDL_GetTicks();
-    if (now - g_last_tod_check >= TOD_INTERVAL_MS) {
-        g_last_tod_check = now;
-        g_timeOfDay = weather_get_time_of_day(&g_weather);
-        // printf("[TIMEOFDAY] mode=%d\n", g_timeOfDay);
-    }
 
-
-    if (s_plantLevel == 1) {
+    if (s_sim.level == 1) {
         s_monstera = IMG_LoadTexture(G_Renderer, ASSETS_IMAGES_DIR "monsteraLv1.png");
     }
-    else if (s_plantLevel == 2) {
+    else if (s_sim.level == 2) {
         s_monstera = IMG_LoadTexture(G_Renderer, ASSETS_IMAGES_DIR "monsteraLv2.png");
         //anim_load_from_json(G_Renderer, ASSETS_IMAGES_DIR "monsteraLv2.png", ASSETS_DIR "data/monsteraLv2.json", s_plantFrames, 64, &s_monstera, &s_plantFrameCount);
 
     }
-    else if (s_plantLevel == 3) {
+    else if (s_sim.level == 3) {
         s_monstera = IMG_LoadTexture(G_Renderer, ASSETS_IMAGES_DIR "monsteraLv3.png");
         //anim_load_from_json(G_Renderer, ASSETS_IMAGES_DIR "monsteraLv3.png", ASSETS_DIR "data/monsteraLv3.json", s_plantFrames, 64, &s_monstera, &s_plantFrameCount);
     }
 
-    ////////////////////////////////////////////////////////////////////////////
-    int w = 1920, h = 1080;
-
-    // ---------------- 시간대 계산 ----------------
-    TimeOfDay tod = weather_get_time_of_day(&g_weather);
-
-    bool hasAtlasAnim = (s_bgFramesUseAtlas && s_bgAtlas && s_bgFrameCount > 0);
-
-    if (tod == TIMEOFDAY_SUNRISE || tod == TIMEOFDAY_SUNSET) {
-        // ✅ 일출/일몰 시간대: sunset 애니메이션 사용
-
-        if (g_weather.tag == WEATHER_TAG_CLEAR) {
-            background_change = true;
-
-            SDL_DestroyTexture(s_bgAtlas);
-            s_bgAtlas = NULL;
-            s_bgAtlas = IMG_LoadTexture(G_Renderer, ASSETS_IMAGES_DIR "sunset.png");
-
-            background_change = false;
-        }
-        else if (g_weather.tag == WEATHER_TAG_CLOUDY) {
-            background_change = true;
-
-            SDL_DestroyTexture(s_bgAtlas);
-            s_bgAtlas = NULL;
-            s_bgAtlas = IMG_LoadTexture(G_Renderer, ASSETS_IMAGES_DIR "cloud.png");
-
-            background_change = false;
-        }
-        else if (g_weather.tag == WEATHER_TAG_RAIN) {
-            background_change = true;
-
-            SDL_DestroyTexture(s_bgAtlas);
-            s_bgAtlas = NULL;
-            s_bgAtlas = IMG_LoadTexture(G_Renderer, ASSETS_IMAGES_DIR "rainy.png");
-
-            background_change = false;
-        }
-        else {
-            background_change = true;
-
-            SDL_DestroyTexture(s_bgAtlas);
-            s_bgAtlas = NULL;
-            s_bgAtlas = IMG_LoadTexture(G_Renderer, ASSETS_IMAGES_DIR "snowy.png");
-
-            background_change = false;
-        }
-
-
-    }
-    else if (tod == TIMEOFDAY_DAY) {
-        // ✅ 낮: 낮 배경 이미지
-        if (g_weather.tag == WEATHER_TAG_CLEAR) {
-            background_change = true;
-
-            SDL_DestroyTexture(s_bgAtlas);
-            s_bgAtlas = NULL;
-            s_bgAtlas = IMG_LoadTexture(G_Renderer, ASSETS_IMAGES_DIR "sunny.png");
-
-            background_change = false;
-        }
-        else if (g_weather.tag == WEATHER_TAG_CLOUDY) {
-            background_change = true;
-
-            SDL_DestroyTexture(s_bgAtlas);
-            s_bgAtlas = NULL;
-            s_bgAtlas = IMG_LoadTexture(G_Renderer, ASSETS_IMAGES_DIR "cloud.png");
-
-            background_change = false;
-        }
-        else if (g_weather.tag == WEATHER_TAG_RAIN) {
-            background_change = true;
-
-            SDL_DestroyTexture(s_bgAtlas);
-            s_bgAtlas = NULL;
-            s_bgAtlas = IMG_LoadTexture(G_Renderer, ASSETS_IMAGES_DIR "rainy.png");
-
-            background_change = false;
-        }
-        else {
-            background_change = true;
-
-            SDL_DestroyTexture(s_bgAtlas);
-            s_bgAtlas = NULL;
-            s_bgAtlas = IMG_LoadTexture(G_Renderer, ASSETS_IMAGES_DIR "snowy.png");
-
-            background_change = false;
-        }
-
-    }
-    else { // ✅ TIMEOFDAY_NIGHT
-        if (g_weather.tag == WEATHER_TAG_CLEAR) {
-            background_change = true;
-
-            SDL_DestroyTexture(s_bgAtlas);
-            s_bgAtlas = NULL;
-            s_bgAtlas = IMG_LoadTexture(G_Renderer, ASSETS_IMAGES_DIR "night.png");
-
-            background_change = false;
-        }
-        else if (g_weather.tag == WEATHER_TAG_CLOUDY) {
-            background_change = true;
-
-            SDL_DestroyTexture(s_bgAtlas);
-            s_bgAtlas = NULL;
-            s_bgAtlas = IMG_LoadTexture(G_Renderer, ASSETS_IMAGES_DIR "cloud.png");
-
-            background_change = false;
-        }
-        else if (g_weather.tag == WEATHER_TAG_RAIN) {
-            background_change = true;
-
-            SDL_DestroyTexture(s_bgAtlas);
-            s_bgAtlas = NULL;
-            s_bgAtlas = IMG_LoadTexture(G_Renderer, ASSETS_IMAGES_DIR "rainy.png");
-
-            background_change = false;
-        }
-        else {
-            background_change = true;
-
-            SDL_DestroyTexture(s_bgAtlas);
-            s_bgAtlas = NULL;
-            s_bgAtlas = IMG_LoadTexture(G_Renderer, ASSETS_IMAGES_DIR "snowy.png");
-
-            background_change = false;
-        }
-
-    }
-
-
-
-    if (now - g_last_tod_check >= TOD_INTERVAL_MS) {
-        g_last_tod_check = now;
-
-        TimeOfDay newTod = weather_get_time_of_day(&g_weather);
-
-        // 시간대가 바뀌었을 때만 페이드 시작
-        if (newTod != g_timeOfDay) {
-            g_tod_before = g_timeOfDay;
-            g_tod_after = newTod;
-            g_tod_fade_active = 1;
-            g_tod_fade_t = 0.0f;
-
-            // 실제 적용은 페이드 중간/끝에서 할 거라 여기선 g_timeOfDay 유지 or 바로 바꿔도 됨
-            // 나는 "현재 상태 기준으로 렌더 + 페이드 오버레이" 방식쓸 거라 여기서 바꾸지 않아도 됨.
-        }
-    }
-
-    // ---- 페이드 타이머 업데이트 ----
-    if (g_tod_fade_active) {
-        g_tod_fade_t += dt;
-        if (g_tod_fade_t >= TOD_FADE_TIME) {
-            g_tod_fade_active = 0;
-            g_tod_fade_t = TOD_FADE_TIME;
-            // 페이드 끝나면 실제 시간대 값을 전환 후 상태로 고정
-            g_timeOfDay = g_tod_after;
-        }
-    }
-
-   
-    if (now - g_last_tod_check >= TOD_INTERVAL_MS) {
-        g_last_tod_check = now;
-        TimeOfDay newTod = weather_get_time_of_day(&g_weather);
-
-        if (newTod != g_timeOfDay) {
-            g_tod_before = g_timeOfDay;
-            g_tod_after = newTod;
-            g_tod_fade_active = 1;
-            g_tod_fade_t = 0.0f;
+    // 배경: 고르기/미리 디코드/크로스페이드
+    update_background(dt);
+    {
+        int ww, wh;
+        SDL_GetRendererOutputSize(G_Renderer, &ww, &wh);
+        TimeOfDay tod = dayclock_current(&g_dayClock);
+        weather_fx_set(s_sim.weather_tag, weather_intensity(), tod == TIMEOFDAY_NIGHT);
+        weather_fx_update(dt, ww, wh);
+    }
+
+
+    // 랜덤 이벤트 + 상태값 업데이트 (core/sim.c)
+    apply_forecast();
+    bool hadBug = s_sim.has_bug;
+    bool hadMold = s_sim.has_mold;
+    int eventBefore = s_sim.weather_event_active;
+
+    // 게임 시계 기준으로 진행. 배속이 크면 여러 번 나눠서 (렌더는 프레임당 1번 그대로)
+    float simDt = gameclock_dt();
+    if (simDt > 0.f) {
+        int steps = (int)SDL_ceilf(simDt / SIM_MAX_SUBSTEP);
+        if (steps > SIM_MAX_SUBSTEPS) steps = SIM_MAX_SUBSTEPS;
+        float sub = simDt / (float)steps;
+        double t = (double)gameclock_time() - simDt;
+        for (int i = 0; i < steps; i++) {
+            sim_step(&s_sim, sub);
+
+            // 통계용 샘플: 새 게임 초에 들어섰을 때만 (1x 에선 초당 1번)
+            t += sub;
+            Sint64 sec = (Sint64)t;
+            if (sec == s_lastStatSec) continue;
+            s_lastStatSec = sec;
+            float v[STATS_CH_COUNT];
+            v[STATS_CH_MOISTURE] = s_sim.status.moisture;
+            v[STATS_CH_TEMP] = s_sim.status.temp;
+            v[STATS_CH_HUMIDITY] = s_sim.status.humidity;
+            v[STATS_CH_HAPPINESS] = s_sim.status.happiness;
+            stats_store_sample(sec, v);
         }
     }
 
-    if (g_tod_fade_active) {
-        g_tod_fade_t += dt;
-        if (g_tod_fade_t >= TOD_FADE_TIME) {
-            g_tod_fade_active = 0;
-            g_tod_fade_t = TOD_FADE_TIME;
-            g_timeOfDay = g_tod_after;
-        }
+    if (SDL_GetTicks() - s_lastSnapshot >= SNAPSHOT_INTERVAL_MS) {
+        s_lastSnapshot = SDL_GetTicks();
+        snapshot_save(&s_sim);
     }
 
-
-    // 랜덤 이벤트들
-    cooltime -= dt;
-
-    if (cooltime <= 0.f) {
-        update_weather_event(dt);   // 랜덤 날씨 이벤트
+    if (!hadBug && s_sim.has_bug) SDL_Log("[EVENT] Bug appeared!");
+    if (!hadMold && s_sim.has_mold) SDL_Log("[EVENT] Mold appeared!");
+    if (eventBefore != s_sim.weather_event_active) {
+        if (s_sim.weather_event_active)
+            SDL_Log("[WEATHER EVENT] start: base=%d event=%d", (int)s_sim.base_tag, (int)s_sim.weather_tag);
+        else
+            SDL_Log("[WEATHER EVENT] end, restore=%d", (int)s_sim.base_tag);
     }
 
-    update_random_events(dt);   // 벌레, 곰팡이 생성
-
-    // 상태값 업데이트
-    update_moisture(dt);
-    update_temperature(dt);
-    update_humidity(dt);
-    update_happiness(dt);
-    update_nutrition(dt);
-
     update_spray_anims(dt);
     // 이벤트 애니메이션 진행
     event_anim_update(dt);
@@ -1932,50 +1557,28 @@ static void render(SDL_Renderer* r)
 {
     int w, h; SDL_GetRendererOutputSize(r, &w, &h);
 
-    TimeOfDay tod = weather_get_time_of_day(&g_weather);
-
-    if (background_change) {
-        float half = TOD_FADE_TIME * 0.5f;
-
-        if (g_tod_fade_t < half) {
-            tod = g_tod_before;
-        }
-        else {
-            tod = g_tod_after;
-        }
-    }
-
-    bool hasAtlasAnim = (s_bgFramesUseAtlas && s_bgAtlas && s_bgFrameCount > 0);
-
-    if (hasAtlasAnim) {
+    // 배경: 지금 것 위에 다음 것을 알파로 겹침 (둘 다 상주 중이라 전환 중에도 읽기 없음)
+    if (s_bgFramesUseAtlas && s_bgFrameCount > 0) {
         SDL_Rect dst = { 0,0,w,h };
-        SDL_Rect src = s_bgFrames[s_bgFrameIndex].rect;
-        SDL_RenderCopy(r, s_bgAtlas, &src, &dst);
+        SDL_Rect src;
+        const AtlasPages* curPages = background_texture(s_bgCur);
+        SDL_Texture* cur = atlas_frame(curPages ? curPages : &s_bgAtlas, s_bgFrameIndex, &src);
+        if (cur) SDL_RenderCopy(r, cur, &src, &dst);
+        SDL_Texture* next = (s_bgNext != s_bgCur && s_bgBlend > 0.0f)
+            ? atlas_frame(background_texture(s_bgNext), s_bgFrameIndex, &src) : NULL;
+        if (next) {
+            SDL_SetTextureAlphaMod(next, (Uint8)(s_bgBlend * 255.0f));
+            SDL_RenderCopy(r, next, &src, &dst);
+            SDL_SetTextureAlphaMod(next, 255);
+        }
     }
 
-  
-
-    render_time_tint(r, tod, w, h);
+    weather_fx_render(r);
 
-    if (background_change) {
-        float t = g_tod_fade_t / TOD_FADE_TIME;
-        if (t < 0.0f) t = 0.0f;
-        if (t > 1.0f) t = 1.0f;
+    // 시간대 색: 해 위상으로 연속
+    render_time_tint(r, dayclock_sun_phase(&g_dayClock), w, h);
 
-        float alphaNorm;
-        if (t < 0.5f) alphaNorm = t / 0.5f;
-        else          alphaNorm = (1.0f - t) / 0.5f;
-
-        Uint8 a = (Uint8)(alphaNorm * 255);
-
-        SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_BLEND);
-        SDL_SetRenderDrawColor(r, 0, 0, 0, a);
-        SDL_Rect full = { 0, 0, w, h };
-        SDL_RenderFillRect(r, &full);
-        SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_NONE);
-    }
-
-    if (!window_open) {
+    if (!s_sim.window_open) {
         if (s_room) {
             SDL_Rect dst = { 0,0,w,h };
             SDL_RenderCopy(r, s_room, NULL, &dst);
@@ -1992,11 +1595,11 @@ static void render(SDL_Renderer* r)
     SDL_Color body = { 240,236,228,255 };
     SDL_Color clock = { 240,236,228,255 };
     int x = 140, y = 140;
-    draw_text(r, title, x, y, "%s", s_plant->name_kr);
+    draw_text(r, title, x, y, "%s", plantdb_name(s_plant));
     draw_text(r, body, x, y + 36, "물 준 횟수: %d회 · 권장 %d일", s_waterCount, s_plant->water_days);
-    draw_text(r, body, x, y + 72, "창문: %s", s_windowOpen ? "열림" : "닫힘");
+    draw_text(r, body, x, y + 72, "창문: %s", s_sim.window_open ? "열림" : "닫힘");
     draw_text(r, body, x, y + 108, "빛 세기: %d", s_light_level);
-    draw_text(r, body, x, y + 144, "방 온도: %d", s_room_temperature);
+    draw_text(r, body, x, y + 144, "방 온도: %d", s_sim.room_temperature);
 
     char timebuf[32];
     char daybuf[32];
@@ -2004,6 +1607,10 @@ static void render(SDL_Renderer* r)
     get_current_day_string(daybuf, sizeof(daybuf));
     draw_text2(r, clock, x + 1500, y, 140, 37, "%s", timebuf);
     draw_text2(r, clock, x + 1500, y + 40, 160, 37, "%s", daybuf);
+    if (gameclock_paused())
+        draw_text(r, clock, x + 1500, y + 80, "일시정지");
+    else if (gameclock_scale() > 1.f)
+        draw_text(r, clock, x + 1500, y + 80, "x%.0f", gameclock_scale());
 
     ui_button_render(r, G_FontMain, &s_btnBack, NULL);
     ui_button_render(r, G_FontMain, &s_btnWater, NULL);
@@ -2020,21 +1627,21 @@ static void render(SDL_Renderer* r)
 
     // ★ 이벤트 애니메이션 렌더
 
-    if (s_plantLevel == 1) {
+    if (s_sim.level == 1) {
         SDL_Rect plant_location = (SDL_Rect){ w / 2 - 10, h - 330, 6 * 3, 17 * 3 };
         SDL_RenderCopy(r, s_monstera, NULL, &plant_location);
     }
-    else if (s_plantLevel == 2) {
+    else if (s_sim.level == 2) {
         SDL_Rect plant_location = (SDL_Rect){ w / 2 - 70, h - 390, 56 * 2, 57 * 2 };
         SDL_RenderCopy(r, s_monstera, NULL, &plant_location);
     }
-    else if (s_plantLevel == 3) {
+    else if (s_sim.level == 3) {
         SDL_Rect plant_location = (SDL_Rect){ w / 2 - 125, h - 545, 116 * 2, 132 * 2 };
         SDL_RenderCopy(r, s_monstera, NULL, &plant_location);
     }
     
     /*
-    if (s_plantLevel == 1) {
+    if (s_sim.level == 1) {
         SDL_RenderCopy(r, s_monstera, NULL, &plant_location);
     }
     else {
@@ -2050,11 +1657,11 @@ static void render(SDL_Renderer* r)
 
     event_anim_render(r);
 
-    if (s_hasBug == true) {
+    if (s_sim.has_bug == true) {
         SDL_Color bug = {255,0,0,255};
         draw_text(r, bug, w / 2, 300, " 벌레가 나타났습니다!");
     }
-    if (s_hasMold == true) {
+    if (s_sim.has_mold == true) {
         SDL_Color bug = { 0,255,0,255 };
         draw_text(r, bug, w / 2, 350, " 곰팡이가 나타났습니다!");
     }
@@ -2083,8 +1690,12 @@ static void render(SDL_Renderer* r)
 
 static void cleanup(void)
 {
-    destroy_frame_textures();
-    if (s_bgAtlas) { SDL_DestroyTexture(s_bgAtlas);       s_bgAtlas = NULL; }
+    weather_service_unsubscribe(g_weatherSub);
+    g_weatherSub = 0;
+    thumb_cache_shutdown();   // 배경 변형 텍스처도 여기서 정리
+    s_bgCur = s_bgNext = BG_SUNSET;
+    s_bgBlend = 0.0f;
+    free_background_animation();
     if (s_bgTexture) { SDL_DestroyTexture(s_bgTexture);     s_bgTexture = NULL; }
     if (s_backIcon) { SDL_DestroyTexture(s_backIcon);      s_backIcon = NULL; }
     if (s_water) { SDL_DestroyTexture(s_water);         s_water = NULL; }
@@ -2099,33 +1710,14 @@ static void cleanup(void)
     if (s_lamp_levelup) { SDL_DestroyTexture(s_lamp_levelup);  s_lamp_levelup = NULL; }
     if (s_lamp_leveldown) { SDL_DestroyTexture(s_lamp_leveldown);s_lamp_leveldown = NULL; }
 
-    if (s_weatherClouds) { SDL_DestroyTexture(s_weatherClouds); s_weatherClouds = NULL; }
-    if (s_weatherRain) { SDL_DestroyTexture(s_weatherRain);   s_weatherRain = NULL; }
-    if (s_weatherSnow) { SDL_DestroyTexture(s_weatherSnow);   s_weatherSnow = NULL; }
 
-    if (s_texBugIdle)
-    {
-        SDL_DestroyTexture(s_texBugIdle);
-        s_texBugIdle = NULL;
-    }
-    if (s_texMoldIdle)
-    {
-        SDL_DestroyTexture(s_texMoldIdle);
-        s_texMoldIdle = NULL;
-    }
-    if (s_texBugSpray)
-    {
-        SDL_DestroyTexture(s_texBugSpray);
-        s_texBugSpray = NULL;
-    }
-    if (s_texMoldSpray)
-    {
-        SDL_DestroyTexture(s_texMoldSpray);
-        s_texMoldSpray = NULL;
-    }
+    atlas_free(&s_bugIdle.pages);
+    atlas_free(&s_moldIdle.pages);
+    atlas_free(&s_bugSpray.pages);
+    atlas_free(&s_moldSpray.pages);
 
 
-    destroy_event_frames();
+    free_event_sheets();
 
     Mix_HookMusicFinished(NULL);
 
@@ -2133,6 +1725,9 @@ static void cleanup(void)
         if (s_gameBGMs[i]) { Mix_FreeMusic(s_gameBGMs[i]); s_gameBGMs[i] = NULL; }
     }
     s_bgmLoaded = 0;
+
+    stats_store_save();
+    if (s_simReady) snapshot_save(&s_sim);
 }
 
 static Scene SCENE_OBJ = { init, handle, update, render, cleanup, "Gameplay" };
@@ -2,6 +2,7 @@
 #include "../scene_manager.h"
 #include "../game.h"
 #include "../include/ui.h"
+#include "../include/atlas.h"
 #include <SDL2/SDL_image.h>
 #include <parson.h>
 
@@ -17,8 +18,10 @@ typedef struct {
     int      duration;  // ms 단위
 } LFrame;
 
-static SDL_Texture* s_animAtlas = NULL; // 예: assets/images/loading_sheet.png
-static LFrame       s_animFrames[128];
+// 시트는 프레임마다 투명 테두리를 잘라 올림 (atlas_load_trimmed)
+static AtlasLayout  s_animLayout;
+static AtlasPages   s_animAtlas;
+static LFrame       s_animFrames[ATLAS_MAX_FRAMES];
 static int          s_animCount = 0;
 static int          s_animIndex = 0;
 static float        s_animElapsed = 0.f;
@@ -29,16 +32,9 @@ static const float S_WAIT_DURATION = 3.0f; // ✅ n초 대기
 
 
 static int load_loading_anim(const char* sheetPath, const char* jsonPath) {
-    // 시트 텍스처
-    if (s_animAtlas) { SDL_DestroyTexture(s_animAtlas); s_animAtlas = NULL; }
-    s_animAtlas = IMG_LoadTexture(G_Renderer, sheetPath);
-    if (!s_animAtlas) {
-        SDL_Log("[LOADING ANIM] sheet load fail: %s", IMG_GetError());
-        return 0;
-    }
-    int atlasW = 0, atlasH = 0; SDL_QueryTexture(s_animAtlas, NULL, NULL, &atlasW, &atlasH);
+    atlas_free(&s_animAtlas);
 
-    // JSON 파싱
+    // JSON 파싱 (시트 밖 프레임은 atlas_load_trimmed 가 빈 프레임으로 둠)
     JSON_Value* root = json_parse_file(jsonPath);
     if (!root) { SDL_Log("[LOADING ANIM] json parse fail"); return 0; }
     JSON_Object* robj = json_value_get_object(root);
@@ -64,8 +60,6 @@ static int load_loading_anim(const char* sheetPath, const char* jsonPath) {
 
             // 범위 체크
             if (fr.rect.w <= 0 || fr.rect.h <= 0) continue;
-            if (fr.rect.x<0 || fr.rect.y<0 ||
-                fr.rect.x + fr.rect.w>atlasW || fr.rect.y + fr.rect.h>atlasH) continue;
 
             s_animFrames[s_animCount++] = fr;
         }
@@ -86,14 +80,21 @@ static int load_loading_anim(const char* sheetPath, const char* jsonPath) {
             if (fr.duration <= 0) fr.duration = 100;
 
             if (fr.rect.w <= 0 || fr.rect.h <= 0) continue;
-            if (fr.rect.x<0 || fr.rect.y<0 ||
-                fr.rect.x + fr.rect.w>atlasW || fr.rect.y + fr.rect.h>atlasH) continue;
 
             s_animFrames[s_animCount++] = fr;
         }
     }
     json_value_free(root);
 
+    // 시트 텍스처
+    SDL_Rect rects[ATLAS_MAX_FRAMES];
+    for (int i = 0; i < s_animCount; ++i) rects[i] = s_animFrames[i].rect;
+    if (s_animCount > 0 && !atlas_load_trimmed(G_Renderer, sheetPath, rects, s_animCount, &s_animLayout, &s_animAtlas)) {
+        SDL_Log("[LOADING ANIM] sheet load fail: %s", sheetPath);
+        s_animCount = 0;
+        return 0;
+    }
+
     SDL_Log("[LOADING ANIM] loaded frames=%d", s_animCount);
     return (s_animCount > 0);
 }
@@ -179,7 +180,7 @@ static void render(SDL_Renderer* r) {
 
     int w,h; SDL_GetRendererOutputSize(r,&w,&h);
 
-    if (s_animAtlas && s_animCount > 0) {
+    if (s_animAtlas.count > 0 && s_animCount > 0) {
         const LFrame* fr = &s_animFrames[s_animIndex];
         // 스케일 배수 (원본이 작다면 키워서)
         const int scale = 3; // 원하는 배수
@@ -189,7 +190,7 @@ static void render(SDL_Renderer* r) {
             fr->rect.w * scale,
             fr->rect.h * scale
         };
-        SDL_RenderCopy(r, s_animAtlas, &fr->rect, &dst);
+        atlas_draw_frame(r, &s_animAtlas, s_animIndex, &dst);
     }
 
     if (G_FontMain) {
@@ -213,7 +214,7 @@ static void render(SDL_Renderer* r) {
     ui_progress_render(r, G_FontMain, &g_LoadingBar);
 }
 
-static void cleanup(void) { if (s_animAtlas) { SDL_DestroyTexture(s_animAtlas); s_animAtlas = NULL; } }
+static void cleanup(void) { atlas_free(&s_animAtlas); s_animCount = 0; }
 
 void loading_begin(SceneID target, LoadingJobFn job, void* userdata,
                    float fade_out_sec, float fade_in_sec)
@@ -6,6 +6,8 @@
 #include "../include/gameplay.h"
 #include "../include/core.h"
 #include "../include/settings.h"
+#include "../include/snapshot.h"
+#include "../include/atlas.h"
 #include <stdbool.h>
 #include <parson.h>
 #define BTN_COUNT 6
@@ -19,11 +21,12 @@ typedef struct
 {
     SDL_Rect rect;
     int duration_ms;
-    SDL_Texture *texture;
 } AnimFrame;
 
-static SDL_Texture *s_bgAtlas = NULL;
-static AnimFrame s_bgFrames[128];
+// mainscene.png 는 5280x2970 이라 렌더러 한도를 넘으면 여러 페이지로 나눠 올림
+static AtlasLayout s_bgLayout;
+static AtlasPages s_bgAtlas;
+static AnimFrame s_bgFrames[ATLAS_MAX_FRAMES];
 static int s_bgFrameCount = 0;
 static int s_bgFrameIndex = 0;
 static float s_bgFrameElapsedMs = 0.f;
@@ -33,16 +36,13 @@ extern LoadCtx s_loadCtx; // gameplay.c에 '정의'가 있으니 여기선 exter
 extern int gameplay_loading_job(void* userdata, float* out_progress);
 extern int plantdb_find_index_by_id(const char* id); // 네가 가진 유틸로 맞춰 쓰면 됨
 
-static void destroy_frame_textures(void)
+static void free_background_animation(void)
 {
-    for (int i = 0; i < (int)SDL_arraysize(s_bgFrames); ++i)
-    {
-        if (s_bgFrames[i].texture)
-        {
-            SDL_DestroyTexture(s_bgFrames[i].texture);
-            s_bgFrames[i].texture = NULL;
-        }
-    }
+    atlas_free(&s_bgAtlas);
+    s_bgFrameCount = 0;
+    s_bgFrameIndex = 0;
+    s_bgFrameElapsedMs = 0.f;
+    s_bgFramesUseAtlas = false;
 }
 
 static void on_start(void *ud)
@@ -55,10 +55,14 @@ static void on_continue(void *ud)
 {
     (void)ud;
 
+    // 스냅샷이 있으면 그 식물로 (상태는 게임 화면 init 에서 적용)
     const char* last_id = G_Settings.gameplay.last_selected_plant;
+    if (snapshot_load())
+        last_id = snapshot_pending_plant();
     int idx = plantdb_find_index_by_id(last_id);
     if (idx < 0) {
         SDL_Log("[CONTINUE] invalid plant id '%s', fallback to select scene", last_id);
+        snapshot_discard();
         scene_switch(SCENE_SELECT_PLANT);
         return;
     }
@@ -130,29 +134,20 @@ static void layout(void)
 
 static void load_background_animation(void)
 {
-    destroy_frame_textures();
+    free_background_animation();
 
-    s_bgFrameCount = 0;
-    s_bgFrameIndex = 0;
-    s_bgFrameElapsedMs = 0.f;
-    s_bgFramesUseAtlas = false;
-
-    if (s_bgAtlas)
-    {
-        SDL_DestroyTexture(s_bgAtlas);
-        s_bgAtlas = NULL;
-    }
-
-    s_bgAtlas = IMG_LoadTexture(G_Renderer, ASSETS_IMAGES_DIR "mainscene.png");
-    if (!s_bgAtlas)
+    SDL_Surface *sheet = IMG_Load(ASSETS_IMAGES_DIR "mainscene.png");
+    if (!sheet)
     {
         SDL_Log("[MAINMENU] Load mainscene.png failed: %s", IMG_GetError());
+        return;
     }
 
     JSON_Value *root = json_parse_file(ASSETS_DIR "data/mainscene.json");
     if (!root)
     {
         SDL_Log("[MAINMENU] Parse mainscene.json failed");
+        SDL_FreeSurface(sheet);
         return;
     }
 
@@ -162,6 +157,7 @@ static void load_background_animation(void)
     {
         SDL_Log("[MAINMENU] mainscene.json missing frames object");
         json_value_free(root);
+        SDL_FreeSurface(sheet);
         return;
     }
 
@@ -187,12 +183,13 @@ static void load_background_animation(void)
         frame.rect.y = (int)json_object_get_number(rectObj, "y");
         frame.rect.w = (int)json_object_get_number(rectObj, "w");
         frame.rect.h = (int)json_object_get_number(rectObj, "h");
-        frame.texture = NULL;
 
         double duration = json_object_get_number(frameObj, "duration");
         frame.duration_ms = duration > 0 ? (int)duration : 100;
 
-        if (frame.rect.w <= 0 || frame.rect.h <= 0)
+        if (frame.rect.w <= 0 || frame.rect.h <= 0 ||
+            frame.rect.x < 0 || frame.rect.y < 0 ||
+            frame.rect.x + frame.rect.w > sheet->w || frame.rect.y + frame.rect.h > sheet->h)
             continue;
 
         s_bgFrames[s_bgFrameCount++] = frame;
@@ -203,89 +200,28 @@ static void load_background_animation(void)
     if (s_bgFrameCount == 0)
     {
         SDL_Log("[MAINMENU] mainscene.json parsed but no valid frames");
+        SDL_FreeSurface(sheet);
         return;
     }
 
-    if (s_bgAtlas)
+    // 프레임 → (페이지, 사각형). 한도 안이면 원본 그대로 한 장
+    SDL_Rect rects[ATLAS_MAX_FRAMES];
+    int maxW, maxH;
+    for (int i = 0; i < s_bgFrameCount; ++i)
+        rects[i] = s_bgFrames[i].rect;
+    atlas_max_texture_size(G_Renderer, &maxW, &maxH);
+    if (atlas_layout_build(rects, s_bgFrameCount, maxW, maxH, &s_bgLayout) &&
+        atlas_upload(G_Renderer, sheet, &s_bgLayout, &s_bgAtlas))
     {
         s_bgFramesUseAtlas = true;
-        return;
+        SDL_Log("[MAINMENU] mainscene %d frames in %d page(s)", s_bgFrameCount, s_bgAtlas.count);
     }
-
-    SDL_Surface *atlasSurface = IMG_Load(ASSETS_IMAGES_DIR "mainscene.png");
-    if (!atlasSurface)
+    else
     {
-        SDL_Log("[MAINMENU] Load mainscene.png as surface failed: %s", IMG_GetError());
+        SDL_Log("[MAINMENU] mainscene atlas unavailable, using gradient");
         s_bgFrameCount = 0;
-        return;
-    }
-
-    if (atlasSurface->format->format != SDL_PIXELFORMAT_RGBA32)
-    {
-        SDL_Surface *converted = SDL_ConvertSurfaceFormat(atlasSurface, SDL_PIXELFORMAT_RGBA32, 0);
-        if (!converted)
-        {
-            SDL_Log("[MAINMENU] Convert mainscene surface failed: %s", SDL_GetError());
-            SDL_FreeSurface(atlasSurface);
-            s_bgFrameCount = 0;
-            return;
-        }
-        SDL_FreeSurface(atlasSurface);
-        atlasSurface = converted;
-    }
-
-    for (int i = 0; i < s_bgFrameCount; ++i)
-    {
-        AnimFrame *frame = &s_bgFrames[i];
-        SDL_Surface *frameSurface = SDL_CreateRGBSurfaceWithFormat(0, frame->rect.w, frame->rect.h, 32, atlasSurface->format->format);
-        if (!frameSurface)
-        {
-            SDL_Log("[MAINMENU] Create frame surface failed: %s", SDL_GetError());
-            continue;
-        }
-
-        SDL_Rect src = frame->rect;
-        if (SDL_BlitSurface(atlasSurface, &src, frameSurface, NULL) < 0)
-        {
-            SDL_Log("[MAINMENU] Blit frame surface failed: %s", SDL_GetError());
-            SDL_FreeSurface(frameSurface);
-            continue;
-        }
-
-        SDL_Texture *tex = SDL_CreateTextureFromSurface(G_Renderer, frameSurface);
-        SDL_FreeSurface(frameSurface);
-
-        if (!tex)
-        {
-            SDL_Log("[MAINMENU] Create frame texture failed: %s", SDL_GetError());
-            continue;
-        }
-
-        frame->texture = tex;
     }
-
-    SDL_FreeSurface(atlasSurface);
-
-    int writeIndex = 0;
-    for (int readIndex = 0; readIndex < s_bgFrameCount; ++readIndex)
-    {
-        if (!s_bgFrames[readIndex].texture)
-            continue;
-
-        if (writeIndex != readIndex)
-            s_bgFrames[writeIndex] = s_bgFrames[readIndex];
-
-        ++writeIndex;
-    }
-    s_bgFrameCount = writeIndex;
-
-    if (s_bgFrameCount == 0)
-    {
-        SDL_Log("[MAINMENU] No usable frame textures produced for mainscene");
-        return;
-    }
-
-    SDL_Log("[MAINMENU] Using fallback frame textures for mainscene animation");
+    SDL_FreeSurface(sheet);
 }
 
 static void init(void *arg)
@@ -455,36 +391,14 @@ static void render(SDL_Renderer *r)
     // 1) 배경
     int w, h;
     SDL_GetRendererOutputSize(r, &w, &h);
-    bool usingAnimatedBg = false;
-    if (s_bgFrameCount > 0)
-    {
-        if (s_bgFramesUseAtlas && s_bgAtlas)
-            usingAnimatedBg = true;
-        else if (!s_bgFramesUseAtlas && s_bgFrames[s_bgFrameIndex].texture)
-            usingAnimatedBg = true;
-    }
+    SDL_Rect src;
+    SDL_Texture *frameTex = (s_bgFramesUseAtlas && s_bgFrameCount > 0)
+        ? atlas_frame(&s_bgAtlas, s_bgFrameIndex, &src) : NULL;
 
-    if (usingAnimatedBg)
-    {
-        SDL_Rect dst = {0, 0, w, h};
-        if (s_bgFramesUseAtlas && s_bgAtlas)
-        {
-            SDL_Rect src = s_bgFrames[s_bgFrameIndex].rect;
-            SDL_RenderCopy(r, s_bgAtlas, &src, &dst);
-        }
-        else
-        {
-            SDL_Texture *frameTex = s_bgFrames[s_bgFrameIndex].texture;
-            if (frameTex)
-            {
-                SDL_RenderCopy(r, frameTex, NULL, &dst);
-            }
-        }
-    }
-    else if (s_bgAtlas)
+    if (frameTex)
     {
         SDL_Rect dst = {0, 0, w, h};
-        SDL_RenderCopy(r, s_bgAtlas, NULL, &dst);
+        SDL_RenderCopy(r, frameTex, &src, &dst);
     }
     else
     {
@@ -566,19 +480,7 @@ static void render(SDL_Renderer *r)
 
 static void cleanup(void)
 {
-    if (s_bgAtlas)
-    {
-        SDL_DestroyTexture(s_bgAtlas);
-        s_bgAtlas = NULL;
-        s_bgFrameCount = 0;
-        s_bgFrameIndex = 0;
-        s_bgFrameElapsedMs = 0.f;
-    }
-    destroy_frame_textures();
-    s_bgFrameCount = 0;
-    s_bgFrameIndex = 0;
-    s_bgFrameElapsedMs = 0.f;
-    s_bgFramesUseAtlas = false;
+    free_background_animation();
     if (s_titleFont)
     {
         TTF_CloseFont(s_titleFont);
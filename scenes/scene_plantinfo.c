@@ -183,11 +183,11 @@ bool plantinfo_init(void *arg)
         return false;
 
     destroy_plant_texture();
-    if (s_ctx.plant->icon_path[0])
+    if (plantdb_icon(s_ctx.plant)[0])
     {
-        s_ctx.plant_texture = IMG_LoadTexture(G_Renderer, s_ctx.plant->icon_path);
+        s_ctx.plant_texture = IMG_LoadTexture(G_Renderer, plantdb_icon(s_ctx.plant));
         if (!s_ctx.plant_texture)
-            SDL_Log("PLANTINFO: failed to load plant icon %s: %s", s_ctx.plant->icon_path, IMG_GetError());
+            SDL_Log("PLANTINFO: failed to load plant icon %s: %s", plantdb_icon(s_ctx.plant), IMG_GetError());
     }
 
     int w, h;
@@ -313,9 +313,9 @@ void plantinfo_render(void)
         SDL_Color bodyColor = {82, 60, 42, 255};
         SDL_Color subtleColor = {118, 96, 74, 255};
 
-        draw_text(r, s_ctx.font_title, nameColor, textX, textY, "%s", s_ctx.plant->name_kr);
+        draw_text(r, s_ctx.font_title, nameColor, textX, textY, "%s", plantdb_name(s_ctx.plant));
         textY += 48;
-        draw_text(r, s_ctx.font_body, subtleColor, textX, textY, "학명: %s", s_ctx.plant->latin);
+        draw_text(r, s_ctx.font_body, subtleColor, textX, textY, "학명: %s", plantdb_latin(s_ctx.plant));
         textY += 40;
 
         draw_text(r, s_ctx.font_body, bodyColor, textX, textY, "물 주기: %d일 간격", s_ctx.plant->water_days);
@@ -387,8 +387,8 @@ static void plantinfo_on_select(void* userdata) {
     G_SelectedPlantIndex = idx;
 
     const PlantInfo* plant = plantdb_get(idx);
-    if (plant && plant->id[0]) {
-        SDL_strlcpy(G_Settings.gameplay.last_selected_plant, plant->id,
+    if (plant && plantdb_id(plant)[0]) {
+        SDL_strlcpy(G_Settings.gameplay.last_selected_plant, plantdb_id(plant),
             sizeof(G_Settings.gameplay.last_selected_plant));
         settings_save(); // 저장 함수가 있다면 호출
     }
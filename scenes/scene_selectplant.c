@@ -4,6 +4,7 @@
 #include "../include/ui.h"
 #include "../include/core.h"
 #include "../include/loading.h"
+#include "../include/plant_search.h"
 
 #include <stdint.h>
 
@@ -18,8 +19,22 @@
 #define GRID_SLOT_LEFT_X 32.0f
 #define GRID_SLOT_RIGHT_X 176.0f
 #define GRID_TOP_MARGIN 240
+#define SEARCH_TEXT_MAX 128
+#define SEARCH_MAX_RESULTS 256
+#define SEARCH_BOX_HEIGHT 40
 static int s_rows = 0, s_cols = MAX_COL;
 static int s_topIndex = 0; // 스크롤용
+static Uint32 s_catalogGen = 0;   // 행 수를 계산한 카탈로그 세대
+// 검색: 입력이 있으면 그리드는 카탈로그 대신 검색 결과를 보여 줌
+static char s_query[SEARCH_TEXT_MAX];     // 확정된 입력
+static char s_composing[SEARCH_TEXT_MAX]; // IME 조합 중인 글자
+static int s_results[SEARCH_MAX_RESULTS];
+static int s_resultCount = 0;
+static int s_searchActive = 0;
+// 검색 줄 글자 텍스처: 입력/조합 글자가 바뀔 때만 다시 만듦
+static SDL_Texture *s_searchTex = NULL;
+static int s_searchTexW = 0, s_searchTexH = 0;
+static int s_searchTexDirty = 1;
 static Mix_Chunk *sfx_click = NULL;
 static UIButton s_btnExit;
 static UIButton s_btnPrevPage;
@@ -32,6 +47,24 @@ static SDL_Texture *start_grid = NULL;
 static SDL_Texture *select_titlebar = NULL;
 static int s_titlebarW = 0;
 static int s_titlebarH = 0;
+// 쪽 캐시: 그리드 배경 + 이름을 렌더 타깃에 한 번만 그려 두고 매 프레임은 통째로 복사.
+// 지금 쪽과 앞뒤 쪽을 들고 있어서 넘기기 애니메이션도 복사 두 번으로 끝남.
+#define PAGE_CACHE_SLOTS 3
+#define PAGE_FLIP_SEC 0.25f
+typedef struct
+{
+    SDL_Texture *tex;
+    int top;        // 첫 행 (s_topIndex)
+    Uint32 stamp;   // 그릴 때의 s_pageStamp
+    Uint32 lastUse;
+} PageCache;
+static PageCache s_pages[PAGE_CACHE_SLOTS];
+static Uint32 s_pageStamp = 1; // 보이는 목록/카탈로그/타깃이 바뀌면 +1 → 캐시 전부 무효
+static Uint32 s_pageClock = 0;
+static int s_pageW = 0, s_pageH = 0;
+static int s_flipFrom = -1; // 넘기는 중이면 이전 쪽 첫 행 (-1 = 아님)
+static int s_flipDir = 0;
+static float s_flipT = 0.0f;
 static void on_exit(void *ud)
 {
     (void)ud;
@@ -41,7 +74,7 @@ static void on_exit(void *ud)
 static void choose_plant(int idx)
 {
     G_SelectedPlantIndex = idx;
-    SDL_Log("Selected plant idx=%d name=%s", idx, plantdb_get(idx)->name_kr);
+    SDL_Log("Selected plant idx=%d name=%s", idx, plantdb_name(plantdb_get(idx)));
     scene_switch_fade_arg(SCENE_PLANTINFO, (void *)(intptr_t)idx, 0.2f, 0.4f);
 }
 
@@ -64,11 +97,62 @@ static void change_page(int delta)
 {
     int rows_visible = GRID_VISIBLE_ROWS;
     int maxTop = SDL_max(0, s_rows - rows_visible);
+    int oldTop = s_topIndex;
     s_topIndex += delta * rows_visible;
     if (s_topIndex < 0)
         s_topIndex = 0;
     if (s_topIndex > maxTop)
         s_topIndex = maxTop;
+    if (delta != 0 && s_topIndex != oldTop)
+    {
+        s_flipFrom = oldTop;
+        s_flipDir = delta > 0 ? 1 : -1;
+        s_flipT = 0.0f;
+    }
+}
+
+static int visible_count(void)
+{
+    return s_searchActive ? s_resultCount : plantdb_count();
+}
+
+// 그리드 칸 번호 → plantdb 인덱스 (-1 = 빈 칸)
+static int slot_plant(int pos)
+{
+    if (pos < 0 || pos >= visible_count())
+        return -1;
+    return s_searchActive ? s_results[pos] : pos;
+}
+
+static void update_rows(void)
+{
+    s_rows = (visible_count() + s_cols - 1) / s_cols;
+    change_page(0);
+    s_pageStamp++;
+    s_flipFrom = -1;
+}
+
+// 입력 + 조합 중인 글자로 다시 검색 (색인이 앞 결과를 이어서 거름)
+static void run_search(void)
+{
+    char q[SEARCH_TEXT_MAX * 2];
+    SDL_snprintf(q, sizeof(q), "%s%s", s_query, s_composing);
+    s_searchActive = q[0] != '\0';
+    s_resultCount = s_searchActive ? plant_search_query(q, s_results, SEARCH_MAX_RESULTS) : 0;
+    s_searchTexDirty = 1;
+    s_topIndex = 0;
+    update_rows();
+}
+
+// UTF-8 마지막 글자 하나 지우기
+static void utf8_pop(char *s)
+{
+    size_t n = SDL_strlen(s);
+    while (n > 0 && ((Uint8)s[n - 1] & 0xC0) == 0x80)
+        n--;
+    if (n > 0)
+        n--;
+    s[n] = '\0';
 }
 
 static void on_prev_page(void *ud)
@@ -146,15 +230,254 @@ static SDL_Rect compute_slot_rect(int localRow, int col, const SDL_Rect *gridDst
     return rect;
 }
 
+static SDL_Rect compute_search_rect(const SDL_Rect *gridDst)
+{
+    SDL_Rect r = {gridDst->x, gridDst->y - SEARCH_BOX_HEIGHT - 12, gridDst->w, SEARCH_BOX_HEIGHT};
+    if (r.y < 0)
+        r.y = 0;
+    return r;
+}
+
+// 한 쪽(그리드 배경 + 이름) 그리기. 쪽 캐시에 굽거나, 렌더 타깃이 없으면 화면에 직접
+static void draw_page(SDL_Renderer *r, int top, const SDL_Rect *gridDst)
+{
+    if (start_grid)
+    {
+        SDL_RenderCopy(r, start_grid, NULL, gridDst);
+    }
+
+    for (int rrow = 0; rrow < GRID_VISIBLE_ROWS; rrow++)
+    {
+        for (int c = 0; c < s_cols; c++)
+        {
+            int idx = slot_plant((top + rrow) * s_cols + c);
+            if (idx < 0)
+                break;
+
+            const PlantInfo *p = plantdb_get(idx);
+            SDL_Rect cell = compute_slot_rect(rrow, c, gridDst);
+
+            if (G_FontMain && p)
+            {
+                float scaleX = (float)cell.w / GRID_SLOT_WIDTH;
+                int paddingX = (int)(12 * scaleX);
+                if (paddingX < 8)
+                    paddingX = 8;
+
+                SDL_Color nameColor = {60, 36, 24, 255};
+                SDL_Surface *sName = TTF_RenderUTF8_Blended(G_FontMain, plantdb_name(p), nameColor);
+                if (sName)
+                {
+                    SDL_Texture *texName = SDL_CreateTextureFromSurface(r, sName);
+                    int tw, th;
+                    SDL_QueryTexture(texName, NULL, NULL, &tw, &th);
+                    int availableWidth = cell.w - paddingX * 2;
+                    if (availableWidth < 1)
+                        availableWidth = cell.w - 2;
+                    if (availableWidth < 1)
+                        availableWidth = 1;
+                    if (tw > availableWidth)
+                    {
+                        double shrink = (double)availableWidth / (double)tw;
+                        tw = availableWidth;
+                        th = (int)(th * shrink);
+                    }
+                    if (tw < 1)
+                        tw = 1;
+                    if (th < 1)
+                        th = 1;
+                    int nameY = cell.y + (cell.h - th) / 2;
+                    SDL_Rect nameDst = {cell.x + paddingX, nameY, tw, th};
+                    SDL_RenderCopy(r, texName, NULL, &nameDst);
+                    SDL_DestroyTexture(texName);
+                    SDL_FreeSurface(sName);
+                }
+            }
+        }
+    }
+}
+
+static void free_search_text(void)
+{
+    if (s_searchTex)
+        SDL_DestroyTexture(s_searchTex);
+    s_searchTex = NULL;
+    s_searchTexW = s_searchTexH = 0;
+    s_searchTexDirty = 1;
+}
+
+static void update_search_text(SDL_Renderer *r)
+{
+    if (!s_searchTexDirty || !G_FontMain)
+        return;
+    if (s_searchTex)
+        SDL_DestroyTexture(s_searchTex);
+    s_searchTex = NULL;
+    s_searchTexW = s_searchTexH = 0;
+    s_searchTexDirty = 0;
+
+    char line[SEARCH_TEXT_MAX * 2 + 64];
+    SDL_Color textColor = {60, 36, 24, 255};
+    SDL_Color hintColor = {140, 120, 100, 255};
+    if (s_searchActive)
+        SDL_snprintf(line, sizeof(line), "%s%s  (%d)", s_query, s_composing, plant_search_match_count());
+    else
+        SDL_strlcpy(line, "이름, 초성(ㅁㅅㅌㄹ), 학명으로 검색", sizeof(line));
+    SDL_Surface *sText = TTF_RenderUTF8_Blended(G_FontMain, line, s_searchActive ? textColor : hintColor);
+    if (!sText)
+        return;
+    s_searchTex = SDL_CreateTextureFromSurface(r, sText);
+    if (s_searchTex)
+    {
+        s_searchTexW = sText->w;
+        s_searchTexH = sText->h;
+    }
+    SDL_FreeSurface(sText);
+}
+
+static void free_pages(void)
+{
+    for (int i = 0; i < PAGE_CACHE_SLOTS; i++)
+    {
+        if (s_pages[i].tex)
+            SDL_DestroyTexture(s_pages[i].tex);
+    }
+    SDL_memset(s_pages, 0, sizeof(s_pages));
+    s_pageW = s_pageH = 0;
+}
+
+// top 쪽의 캐시 텍스처. 없으면 build 일 때만 구움 (무효 칸 → 가장 오래 안 쓴 칸 순으로 재사용)
+static SDL_Texture *page_texture(SDL_Renderer *r, int top, int build)
+{
+    PageCache *victim = NULL;
+    Uint32 victimAge = 0;
+    for (int i = 0; i < PAGE_CACHE_SLOTS; i++)
+    {
+        PageCache *pc = &s_pages[i];
+        int valid = pc->tex && pc->stamp == s_pageStamp;
+        if (valid && pc->top == top)
+        {
+            pc->lastUse = ++s_pageClock;
+            return pc->tex;
+        }
+        // 지금 보이는 쪽은 버리지 않음
+        if (valid && (pc->top == s_topIndex || pc->top == s_flipFrom))
+            continue;
+        Uint32 age = valid ? pc->lastUse : 0;
+        if (!victim || age < victimAge)
+        {
+            victim = pc;
+            victimAge = age;
+        }
+    }
+    if (!build || !victim)
+        return NULL;
+
+    if (!victim->tex)
+    {
+        victim->tex = SDL_CreateTexture(r, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, s_pageW, s_pageH);
+        if (!victim->tex)
+        {
+            SDL_Log("[SELECT] page target failed: %s", SDL_GetError());
+            return NULL;
+        }
+        SDL_SetTextureBlendMode(victim->tex, SDL_BLENDMODE_BLEND);
+    }
+
+    SDL_Texture *prevTarget = SDL_GetRenderTarget(r);
+    SDL_SetRenderTarget(r, victim->tex);
+    SDL_SetRenderDrawColor(r, 0, 0, 0, 0);
+    SDL_RenderClear(r);
+    SDL_Rect local = {0, 0, s_pageW, s_pageH};
+    draw_page(r, top, &local);
+    SDL_SetRenderTarget(r, prevTarget);
+
+    victim->top = top;
+    victim->stamp = s_pageStamp;
+    victim->lastUse = ++s_pageClock;
+    return victim->tex;
+}
+
+// 앞뒤 쪽 미리 굽기 (프레임당 하나까지)
+static void prefetch_pages(SDL_Renderer *r)
+{
+    int maxTop = SDL_max(0, s_rows - GRID_VISIBLE_ROWS);
+    int around[2] = {s_topIndex + GRID_VISIBLE_ROWS, s_topIndex - GRID_VISIBLE_ROWS};
+    for (int i = 0; i < 2; i++)
+    {
+        int top = around[i];
+        if (top < 0)
+            top = 0;
+        if (top > maxTop)
+            top = maxTop;
+        if (top == s_topIndex || page_texture(r, top, 0))
+            continue;
+        page_texture(r, top, 1);
+        return;
+    }
+}
+
+// 그리드 그리기: 캐시된 쪽을 복사, 넘기는 중이면 이전 쪽과 나란히 밀어냄
+static void render_grid(SDL_Renderer *r, const SDL_Rect *gridDst)
+{
+    if (!SDL_RenderTargetSupported(r))
+    {
+        draw_page(r, s_topIndex, gridDst);
+        return;
+    }
+    if (gridDst->w != s_pageW || gridDst->h != s_pageH)
+    {
+        free_pages();
+        s_pageW = gridDst->w;
+        s_pageH = gridDst->h;
+    }
+
+    SDL_Texture *cur = page_texture(r, s_topIndex, 1);
+    if (!cur)
+    {
+        draw_page(r, s_topIndex, gridDst);
+        return;
+    }
+
+    SDL_Texture *from = s_flipFrom >= 0 ? page_texture(r, s_flipFrom, 1) : NULL;
+    if (from)
+    {
+        float t = s_flipT / PAGE_FLIP_SEC;
+        if (t > 1.0f)
+            t = 1.0f;
+        float ease = 1.0f - (1.0f - t) * (1.0f - t) * (1.0f - t);
+        int shift = (int)(gridDst->w * ease + 0.5f);
+        SDL_Rect fromDst = *gridDst;
+        SDL_Rect curDst = *gridDst;
+        fromDst.x -= s_flipDir * shift;
+        curDst.x += s_flipDir * (gridDst->w - shift);
+        SDL_RenderSetClipRect(r, gridDst);
+        SDL_RenderCopy(r, from, NULL, &fromDst);
+        SDL_RenderCopy(r, cur, NULL, &curDst);
+        SDL_RenderSetClipRect(r, NULL);
+    }
+    else
+    {
+        SDL_RenderCopy(r, cur, NULL, gridDst);
+    }
+}
+
 static void init(void *arg)
 {
     (void)arg;
     if (!sfx_click)
         sfx_click = Mix_LoadWAV(ASSETS_SOUNDS_DIR "click.wav");
-    // JSON 로드
-    int n = plantdb_load(ASSETS_DIR "plants.json");
+    // 카탈로그는 시작할 때 읽어 둠 (여기서는 JSON 작업 없음)
+    int n = plantdb_count();
     if (n <= 0)
         SDL_Log("WARNING: plants.json empty or fail");
+    s_catalogGen = plantdb_generation();
+    plant_search_prepare();
+    s_query[0] = '\0';
+    s_composing[0] = '\0';
+    s_searchActive = 0;
+    s_resultCount = 0;
+    free_search_text();
 
     int w, h;
     SDL_GetRendererOutputSize(G_Renderer, &w, &h);
@@ -173,6 +496,12 @@ static void init(void *arg)
     s_rows = (n + s_cols - 1) / s_cols;
     s_topIndex = 0;
 
+    // 한글 검색 입력 (IME 후보 창은 검색 칸 아래에)
+    SDL_Rect gridDst = compute_grid_dest(w, h);
+    SDL_Rect searchRect = compute_search_rect(&gridDst);
+    SDL_SetTextInputRect(&searchRect);
+    SDL_StartTextInput();
+
     layout_ui(w, h);
 
     if (!select_background)
@@ -245,11 +574,60 @@ static void handle(SDL_Event *e)
     {
         layout_ui(e->window.data1, e->window.data2);
     }
+    // D3D 등에서 렌더 타깃 내용이 사라짐 → 다시 굽기
+    if (e->type == SDL_RENDER_TARGETS_RESET)
+    {
+        s_pageStamp++;
+    }
+    // 장치를 잃으면 텍스처 자체가 무효 → 버리고 다음 프레임에 새로 만듦
+    if (e->type == SDL_RENDER_DEVICE_RESET)
+    {
+        free_pages();
+        free_search_text();
+    }
 
     ui_button_handle(&s_btnExit, e);
     ui_button_handle(&s_btnPrevPage, e);
     ui_button_handle(&s_btnNextPage, e);
 
+    // 검색어 입력: 확정 글자, 조합 중 글자, 지우기/비우기/첫 결과 선택
+    if (e->type == SDL_TEXTINPUT)
+    {
+        SDL_strlcat(s_query, e->text.text, sizeof(s_query));
+        s_composing[0] = '\0';
+        run_search();
+        return;
+    }
+    if (e->type == SDL_TEXTEDITING)
+    {
+        SDL_strlcpy(s_composing, e->edit.text, sizeof(s_composing));
+        run_search();
+        return;
+    }
+    if (e->type == SDL_KEYDOWN && !s_composing[0])
+    {
+        SDL_Keycode key = e->key.keysym.sym;
+        if (key == SDLK_BACKSPACE && s_query[0])
+        {
+            utf8_pop(s_query);
+            run_search();
+            return;
+        }
+        if (key == SDLK_ESCAPE && s_query[0])
+        {
+            s_query[0] = '\0';
+            run_search();
+            return;
+        }
+        if ((key == SDLK_RETURN || key == SDLK_KP_ENTER) && s_searchActive && s_resultCount > 0)
+        {
+            if (sfx_click)
+                Mix_PlayChannel(-1, sfx_click, 0);
+            choose_plant(s_results[0]);
+            return;
+        }
+    }
+
     // 마우스 클릭으로 항목 선택
     if (e->type == SDL_MOUSEBUTTONUP && e->button.button == SDL_BUTTON_LEFT)
     {
@@ -261,8 +639,8 @@ static void handle(SDL_Event *e)
         { // 화면에 보이는 최대 6행(가변이면 계산)
             for (int c = 0; c < s_cols; c++)
             {
-                int idx = (s_topIndex + r) * s_cols + c;
-                if (idx >= plantdb_count())
+                int idx = slot_plant((s_topIndex + r) * s_cols + c);
+                if (idx < 0)
                     break;
                 SDL_Rect cell = compute_slot_rect(r, c, &gridDst);
                 if (ui_point_in_rect(mx, my, &cell))
@@ -282,6 +660,7 @@ static void handle(SDL_Event *e)
         int rows_visible = GRID_VISIBLE_ROWS;
         int maxTop = SDL_max(0, s_rows - rows_visible);
         s_topIndex -= (e->wheel.y > 0) ? 1 : (e->wheel.y < 0 ? -1 : 0);
+        s_flipFrom = -1;
         if (s_topIndex < 0)
             s_topIndex = 0;
         if (s_topIndex > maxTop)
@@ -289,7 +668,24 @@ static void handle(SDL_Event *e)
     }
 }
 
-static void update(float dt) { (void)dt; }
+static void update(float dt)
+{
+    if (s_flipFrom >= 0)
+    {
+        s_flipT += dt;
+        if (s_flipT >= PAGE_FLIP_SEC)
+            s_flipFrom = -1;
+    }
+    // plants.json 이 바뀌었으면 행 수만 다시 계산 (스크롤 위치 유지), 검색 중이면 결과도 새로
+    if (s_catalogGen != plantdb_generation())
+    {
+        s_catalogGen = plantdb_generation();
+        if (s_searchActive)
+            run_search();
+        else
+            update_rows();
+    }
+}
 
 static void render(SDL_Renderer *r)
 {
@@ -360,69 +756,45 @@ static void render(SDL_Renderer *r)
     int rw, rh;
     SDL_GetRendererOutputSize(r, &rw, &rh);
     SDL_Rect gridDst = compute_grid_dest(rw, rh);
-    if (start_grid)
+    render_grid(r, &gridDst);
+
+    // 검색 칸
+    SDL_Rect searchRect = compute_search_rect(&gridDst);
+    SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(r, 250, 244, 228, 220);
+    SDL_RenderFillRect(r, &searchRect);
+    SDL_SetRenderDrawColor(r, 60, 36, 24, 255);
+    SDL_RenderDrawRect(r, &searchRect);
+    SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_NONE);
+    update_search_text(r);
+    if (s_searchTex)
     {
-        SDL_RenderCopy(r, start_grid, NULL, &gridDst);
-    }
-
-    for (int rrow = 0; rrow < GRID_VISIBLE_ROWS; rrow++)
-    {
-        for (int c = 0; c < s_cols; c++)
+        int tw = s_searchTexW, th = s_searchTexH;
+        int maxW = searchRect.w - 24;
+        if (tw > maxW)
         {
-            int idx = (s_topIndex + rrow) * s_cols + c;
-            if (idx >= plantdb_count())
-                break;
-
-            const PlantInfo *p = plantdb_get(idx);
-            SDL_Rect cell = compute_slot_rect(rrow, c, &gridDst);
-
-            if (G_FontMain && p)
-            {
-                float scaleX = (float)cell.w / GRID_SLOT_WIDTH;
-                int paddingX = (int)(12 * scaleX);
-                if (paddingX < 8)
-                    paddingX = 8;
-
-                SDL_Color nameColor = {60, 36, 24, 255};
-                SDL_Surface *sName = TTF_RenderUTF8_Blended(G_FontMain, p->name_kr, nameColor);
-                if (sName)
-                {
-                    SDL_Texture *texName = SDL_CreateTextureFromSurface(r, sName);
-                    int tw, th;
-                    SDL_QueryTexture(texName, NULL, NULL, &tw, &th);
-                    int availableWidth = cell.w - paddingX * 2;
-                    if (availableWidth < 1)
-                        availableWidth = cell.w - 2;
-                    if (availableWidth < 1)
-                        availableWidth = 1;
-                    if (tw > availableWidth)
-                    {
-                        double shrink = (double)availableWidth / (double)tw;
-                        tw = availableWidth;
-                        th = (int)(th * shrink);
-                    }
-                    if (tw < 1)
-                        tw = 1;
-                    if (th < 1)
-                        th = 1;
-                    int nameY = cell.y + (cell.h - th) / 2;
-                    SDL_Rect nameDst = {cell.x + paddingX, nameY, tw, th};
-                    SDL_RenderCopy(r, texName, NULL, &nameDst);
-                    SDL_DestroyTexture(texName);
-                    SDL_FreeSurface(sName);
-                }
-            }
+            th = (int)(th * ((double)maxW / (double)tw));
+            tw = maxW;
         }
+        SDL_Rect d = {searchRect.x + 12, searchRect.y + (searchRect.h - th) / 2, tw, th};
+        SDL_RenderCopy(r, s_searchTex, NULL, &d);
     }
 
     // 뒤로 버튼
     ui_button_render(r, G_FontMain, &s_btnExit, tex_exit);
     ui_button_render(r, G_FontMain, &s_btnPrevPage, tex_prev);
     ui_button_render(r, G_FontMain, &s_btnNextPage, tex_next);
+
+    if (s_pageW > 0)
+        prefetch_pages(r);
 }
 
 static void cleanup(void)
 {
+    SDL_StopTextInput();
+    free_pages();
+    free_search_text();
+    s_flipFrom = -1;
     if (sfx_click)
     {
         Mix_FreeChunk(sfx_click);
@@ -0,0 +1,332 @@
+#include "../include/scene.h"
+#include "../scene_manager.h"
+#include "../game.h"
+#include "../include/core.h"
+#include "../include/settings.h"
+#include "../include/stats_store.h"
+#include "../include/ui.h"
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+#include <SDL2/SDL_ttf.h>
+#include <stdio.h>
+#include <stdbool.h>
+
+// 통계 화면: 수분/온도/습도/행복도 차트 (core/stats_store.c 의 시계열)
+// 게임 화면에서 Tab 으로 들어오고, 뒤로가기/ESC 로 게임으로 돌아감
+
+typedef struct
+{
+    const char *label;
+    StatsResolution res;
+    Sint64 span; // 보여줄 길이(sec)
+} StatsRange;
+
+static const StatsRange s_ranges[] = {
+    {"6시간", STATS_RES_MINUTE, 6 * 3600},
+    {"2일", STATS_RES_MINUTE, 48 * 3600},
+    {"30일", STATS_RES_HOUR, 30 * 86400},
+    {"1년", STATS_RES_DAY, 365 * 86400},
+};
+enum
+{
+    RANGE_COUNT = (int)(sizeof(s_ranges) / sizeof(s_ranges[0]))
+};
+
+typedef struct
+{
+    StatsChannel ch;
+    const char *label;
+    const char *unit;
+    float vmin, vmax;
+    SDL_Color color;
+} StatsChartDef;
+
+static const StatsChartDef s_defs[STATS_CH_COUNT] = {
+    {STATS_CH_MOISTURE, "수분", "%", 0.f, 100.f, {90, 170, 255, 255}},
+    {STATS_CH_TEMP, "온도", "도", 0.f, 40.f, {255, 140, 90, 255}},
+    {STATS_CH_HUMIDITY, "습도", "%", 0.f, 100.f, {120, 220, 220, 255}},
+    {STATS_CH_HAPPINESS, "행복도", "", 0.f, 100.f, {250, 210, 90, 255}},
+};
+
+// 조회 버퍼 (가장 긴 링 + 진행 중인 칸)
+#define STATS_QUERY_MAX (STATS_DAY_CAP + 1)
+static Sint64 s_qT[STATS_QUERY_MAX];
+static float s_qMin[STATS_QUERY_MAX];
+static float s_qMax[STATS_QUERY_MAX];
+static float s_qAvg[STATS_QUERY_MAX];
+
+static UIChart s_charts[STATS_CH_COUNT];
+static float s_lastValue[STATS_CH_COUNT];
+static int s_pointCount[STATS_CH_COUNT];
+static SDL_Rect s_tabRects[RANGE_COUNT];
+static int s_range = 0;
+
+// 차트 정점 캐시: 저장소 generation / 범위 / 레이아웃이 바뀔 때만 다시 만듦
+static Uint32 s_builtGen = 0;
+static int s_builtRange = -1;
+static bool s_layoutDirty = true;
+
+static UIButton s_btnBack;
+static SDL_Texture *s_backIcon = NULL;
+static SDL_Texture *s_bg = NULL;
+static TTF_Font *s_font = NULL;
+static TTF_Font *s_titleFont = NULL;
+
+static void draw_text(SDL_Renderer *r, TTF_Font *f, int x, int y, const char *s, SDL_Color c)
+{
+    if (!f || !s || !s[0])
+        return;
+    SDL_Surface *sf = TTF_RenderUTF8_Blended(f, s, c);
+    if (!sf)
+        return;
+    SDL_Texture *tx = SDL_CreateTextureFromSurface(r, sf);
+    SDL_Rect d = {x, y, sf->w, sf->h};
+    SDL_FreeSurface(sf);
+    SDL_RenderCopy(r, tx, NULL, &d);
+    SDL_DestroyTexture(tx);
+}
+
+static void on_back(void *ud)
+{
+    (void)ud;
+    scene_switch_fade(SCENE_GAMEPLAY, 0.2f, 0.3f);
+}
+
+static void layout(int w, int h)
+{
+    const int margin = 40;
+    const int top = 170;
+    const int gap = 36;
+    const int labelH = 40;
+
+    s_btnBack.r = (SDL_Rect){margin, margin, 72, 72};
+
+    int tabW = 110, tabH = 44;
+    for (int i = 0; i < RANGE_COUNT; ++i)
+        s_tabRects[i] = (SDL_Rect){w - margin - (RANGE_COUNT - i) * (tabW + 12), margin + 14, tabW, tabH};
+
+    int cw = (w - margin * 2 - gap) / 2;
+    int ch = (h - top - margin - gap) / 2 - labelH;
+    if (ch < 80)
+        ch = 80;
+    for (int i = 0; i < STATS_CH_COUNT; ++i)
+    {
+        int col = i % 2, row = i / 2;
+        s_charts[i].r = (SDL_Rect){margin + col * (cw + gap), top + labelH + row * (ch + labelH + gap), cw, ch};
+    }
+    s_layoutDirty = true;
+}
+
+static void rebuild_charts(void)
+{
+    const StatsRange *rg = &s_ranges[s_range];
+    Sint64 latest = stats_store_latest();
+    Sint64 to = latest >= 0 ? latest : 0;
+    Sint64 from = to - rg->span;
+    int step = stats_store_step(rg->res);
+
+    for (int i = 0; i < STATS_CH_COUNT; ++i)
+    {
+        UIChart *c = &s_charts[i];
+        int n = stats_store_query(rg->res, s_defs[i].ch, from, to, s_qT, s_qMin, s_qMax, s_qAvg, STATS_QUERY_MAX);
+        c->t0 = from;
+        c->t1 = to;
+        c->gap = (Sint64)step * 2;
+        ui_chart_build(c, s_qT, s_qAvg, s_qMin, s_qMax, n);
+        s_pointCount[i] = n;
+        s_lastValue[i] = n > 0 ? s_qAvg[n - 1] : 0.f;
+    }
+
+    s_builtGen = stats_store_generation();
+    s_builtRange = s_range;
+    s_layoutDirty = false;
+}
+
+static void init(void *arg)
+{
+    (void)arg;
+    int w, h;
+    SDL_GetRendererOutputSize(G_Renderer, &w, &h);
+
+    // 게임을 거치지 않고 들어온 경우 마지막 식물
+    if (!stats_store_plant())
+        stats_store_open(G_Settings.gameplay.last_selected_plant);
+
+    ui_button_init(&s_btnBack, (SDL_Rect){0, 0, 0, 0}, "");
+    ui_button_set_callback(&s_btnBack, on_back, NULL);
+    ui_button_set_sfx(&s_btnBack, G_SFX_Click, G_SFX_Hover);
+
+    for (int i = 0; i < STATS_CH_COUNT; ++i)
+    {
+        ui_chart_init(&s_charts[i], (SDL_Rect){0, 0, 0, 0}, s_defs[i].vmin, s_defs[i].vmax);
+        s_charts[i].line = s_defs[i].color;
+        s_charts[i].band = s_defs[i].color;
+        s_charts[i].band.a = 60;
+    }
+    layout(w, h);
+    s_builtRange = -1;
+
+    if (!s_font)
+    {
+        s_font = TTF_OpenFont(ASSETS_FONTS_DIR "NeoDunggeunmoPro-Regular.ttf", 24);
+        if (!s_font)
+            SDL_Log("STATS 폰트로드 실패:%s", TTF_GetError());
+    }
+    if (!s_titleFont)
+    {
+        s_titleFont = TTF_OpenFont(ASSETS_FONTS_DIR "NeoDunggeunmoPro-Regular.ttf", 40);
+        if (!s_titleFont)
+            SDL_Log("STATS 타이틀 폰트로드 실패:%s", TTF_GetError());
+    }
+    if (!s_bg)
+    {
+        s_bg = IMG_LoadTexture(G_Renderer, ASSETS_IMAGES_DIR "select_Background.png");
+        if (!s_bg)
+            SDL_Log("STATS 배경 로드 실패: %s", IMG_GetError());
+    }
+    if (!s_backIcon)
+    {
+        s_backIcon = IMG_LoadTexture(G_Renderer, ASSETS_IMAGES_DIR "I_back.png");
+        if (!s_backIcon)
+            SDL_Log("STATS 뒤로 아이콘 로드 실패: %s", IMG_GetError());
+    }
+}
+
+static void handle(SDL_Event *e)
+{
+    if (e->type == SDL_QUIT)
+    {
+        G_Running = 0;
+        return;
+    }
+
+    ui_button_handle(&s_btnBack, e);
+
+    if (e->type == SDL_WINDOWEVENT && e->window.event == SDL_WINDOWEVENT_SIZE_CHANGED)
+    {
+        layout(e->window.data1, e->window.data2);
+        return;
+    }
+
+    if (e->type == SDL_KEYDOWN)
+    {
+        SDL_Keycode k = e->key.keysym.sym;
+        if (k == SDLK_ESCAPE || k == SDLK_TAB)
+        {
+            on_back(NULL);
+            return;
+        }
+        if (k >= SDLK_1 && k < SDLK_1 + RANGE_COUNT)
+            s_range = (int)(k - SDLK_1);
+    }
+
+    if (e->type == SDL_MOUSEBUTTONDOWN && e->button.button == SDL_BUTTON_LEFT)
+    {
+        for (int i = 0; i < RANGE_COUNT; ++i)
+            if (ui_point_in_rect(e->button.x, e->button.y, &s_tabRects[i]))
+                s_range = i;
+    }
+}
+
+static void update(float dt)
+{
+    (void)dt;
+    if (s_layoutDirty || s_builtRange != s_range || s_builtGen != stats_store_generation())
+        rebuild_charts();
+}
+
+static void render(SDL_Renderer *r)
+{
+    int w, h;
+    SDL_GetRendererOutputSize(r, &w, &h);
+
+    SDL_SetRenderDrawColor(r, 16, 20, 28, 255);
+    SDL_RenderClear(r);
+    if (s_bg)
+    {
+        SDL_Rect dst = {0, 0, w, h};
+        SDL_RenderCopy(r, s_bg, NULL, &dst);
+    }
+
+    SDL_Color white = {235, 235, 235, 255};
+    SDL_Color subtle = {170, 170, 170, 255};
+
+    char title[128];
+    const char *plant = stats_store_plant();
+    int idx = plant ? plantdb_find_index_by_id(plant) : -1;
+    const PlantInfo *p = idx >= 0 ? plantdb_get(idx) : NULL;
+    SDL_snprintf(title, sizeof(title), "%s 성장 기록", p ? plantdb_name(p) : (plant ? plant : ""));
+    draw_text(r, s_titleFont, 140, 50, title, white);
+
+    // 범위 탭
+    for (int i = 0; i < RANGE_COUNT; ++i)
+    {
+        SDL_Rect t = s_tabRects[i];
+        SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_BLEND);
+        SDL_SetRenderDrawColor(r, 0, 0, 0, i == s_range ? 170 : 80);
+        SDL_RenderFillRect(r, &t);
+        SDL_SetRenderDrawColor(r, 255, 255, 255, i == s_range ? 200 : 60);
+        SDL_RenderDrawRect(r, &t);
+        SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_NONE);
+        draw_text(r, s_font, t.x + 16, t.y + 8, s_ranges[i].label, i == s_range ? white : subtle);
+    }
+
+    // 차트
+    for (int i = 0; i < STATS_CH_COUNT; ++i)
+    {
+        const UIChart *c = &s_charts[i];
+        char label[96];
+        if (s_pointCount[i] > 0)
+            SDL_snprintf(label, sizeof(label), "%s  %.1f%s", s_defs[i].label, s_lastValue[i], s_defs[i].unit);
+        else
+            SDL_snprintf(label, sizeof(label), "%s  (기록 없음)", s_defs[i].label);
+        draw_text(r, s_font, c->r.x, c->r.y - 34, label, s_defs[i].color);
+
+        ui_chart_render(r, c);
+
+        char axis[32];
+        SDL_snprintf(axis, sizeof(axis), "%.0f", s_defs[i].vmax);
+        draw_text(r, s_font, c->r.x + 6, c->r.y + 4, axis, subtle);
+        SDL_snprintf(axis, sizeof(axis), "%.0f", s_defs[i].vmin);
+        draw_text(r, s_font, c->r.x + 6, c->r.y + c->r.h - 30, axis, subtle);
+    }
+
+    draw_text(r, s_font, 140, 100, "1~4: 범위", subtle);
+
+    ui_button_render(r, NULL, &s_btnBack, s_backIcon);
+}
+
+static void cleanup(void)
+{
+    for (int i = 0; i < STATS_CH_COUNT; ++i)
+        ui_chart_destroy(&s_charts[i]);
+
+    if (s_backIcon)
+    {
+        SDL_DestroyTexture(s_backIcon);
+        s_backIcon = NULL;
+    }
+    if (s_bg)
+    {
+        SDL_DestroyTexture(s_bg);
+        s_bg = NULL;
+    }
+    if (s_font)
+    {
+        TTF_CloseFont(s_font);
+        s_font = NULL;
+    }
+    if (s_titleFont)
+    {
+        TTF_CloseFont(s_titleFont);
+        s_titleFont = NULL;
+    }
+    s_builtRange = -1;
+}
+
+// 씬 객체
+static Scene SCENE_OBJ = {init, handle, update, render, cleanup, "Stats"};
+Scene *scene_stats_object(void)
+{
+    return &SCENE_OBJ;
+}
@@ -0,0 +1,125 @@
+#include "../include/ui.h"
+
+// 시계열 차트
+// 최소~최대 띠 + 평균 선을 삼각형으로 만들어 두고 SDL_RenderGeometry 한 번으로 그림.
+// 정점은 데이터가 바뀔 때만 ui_chart_build 로 다시 만든다 (렌더는 복사만).
+
+static int chart_reserve(UIChart* c, int verts, int indices)
+{
+    if (verts > c->vcap) {
+        SDL_Vertex* v = (SDL_Vertex*)SDL_realloc(c->verts, sizeof(SDL_Vertex) * verts);
+        if (!v) return 0;
+        c->verts = v;
+        c->vcap = verts;
+    }
+    if (indices > c->icap) {
+        int* i = (int*)SDL_realloc(c->indices, sizeof(int) * indices);
+        if (!i) return 0;
+        c->indices = i;
+        c->icap = indices;
+    }
+    return 1;
+}
+
+static void chart_vertex(UIChart* c, float x, float y, SDL_Color col)
+{
+    SDL_Vertex* v = &c->verts[c->vcount++];
+    v->position.x = x;
+    v->position.y = y;
+    v->color = col;
+    v->tex_coord.x = 0.f;
+    v->tex_coord.y = 0.f;
+}
+
+// 정점 a,b (앞 점) 와 a+2,b+2 (다음 점) 사이 사각형
+static void chart_quad(UIChart* c, int a)
+{
+    int* i = &c->indices[c->icount];
+    i[0] = a;     i[1] = a + 1; i[2] = a + 2;
+    i[3] = a + 1; i[4] = a + 3; i[5] = a + 2;
+    c->icount += 6;
+}
+
+void ui_chart_init(UIChart* c, SDL_Rect r, float vmin, float vmax)
+{
+    SDL_memset(c, 0, sizeof(*c));
+    c->r = r;
+    c->vmin = vmin;
+    c->vmax = vmax > vmin ? vmax : vmin + 1.f;
+    c->thickness = 2.f;
+    c->line = (SDL_Color){ 120, 220, 140, 255 };
+    c->band = (SDL_Color){ 120, 220, 140, 60 };
+}
+
+void ui_chart_build(UIChart* c, const Sint64* t, const float* avg, const float* mn, const float* mx, int n)
+{
+    c->vcount = c->icount = 0;
+    if (!t || !avg || n <= 0 || c->t1 <= c->t0) return;
+
+    int band = mn && mx;
+    if (!chart_reserve(c, n * (band ? 4 : 2), n * (band ? 12 : 6))) return;
+
+    float sx = (float)c->r.w / (float)(c->t1 - c->t0);
+    float sy = (float)c->r.h / (c->vmax - c->vmin);
+    float bottom = (float)(c->r.y + c->r.h);
+#define CHART_X(i) ((float)c->r.x + (float)(t[i] - c->t0) * sx)
+#define CHART_Y(v) (bottom - ((v) - c->vmin) * sy)
+
+    // 띠 (점마다 최소/최대 2개)
+    if (band) {
+        for (int i = 0; i < n; i++) {
+            float x = CHART_X(i);
+            chart_vertex(c, x, CHART_Y(mx[i]), c->band);
+            chart_vertex(c, x, CHART_Y(mn[i]), c->band);
+            if (i > 0 && !(c->gap > 0 && t[i] - t[i - 1] > c->gap)) chart_quad(c, c->vcount - 4);
+        }
+    }
+
+    // 평균 선: 앞뒤 점 방향의 법선으로 두께만큼 벌린 띠
+    float half = c->thickness * 0.5f;
+    for (int i = 0; i < n; i++) {
+        int a = i > 0 ? i - 1 : i;
+        int b = i + 1 < n ? i + 1 : i;
+        float dx = CHART_X(b) - CHART_X(a);
+        float dy = CHART_Y(avg[b]) - CHART_Y(avg[a]);
+        float len = SDL_sqrtf(dx * dx + dy * dy);
+        float nx = 0.f, ny = -half;
+        if (len > 0.0001f) {
+            nx = -dy / len * half;
+            ny = dx / len * half;
+        }
+        float x = CHART_X(i), y = CHART_Y(avg[i]);
+        chart_vertex(c, x + nx, y + ny, c->line);
+        chart_vertex(c, x - nx, y - ny, c->line);
+        if (i > 0 && !(c->gap > 0 && t[i] - t[i - 1] > c->gap)) chart_quad(c, c->vcount - 4);
+    }
+#undef CHART_X
+#undef CHART_Y
+}
+
+void ui_chart_render(SDL_Renderer* ren, const UIChart* c)
+{
+    // 바탕 + 가운데 기준선
+    SDL_SetRenderDrawBlendMode(ren, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(ren, 0, 0, 0, 90);
+    SDL_RenderFillRect(ren, &c->r);
+    SDL_SetRenderDrawColor(ren, 255, 255, 255, 40);
+    SDL_RenderDrawLine(ren, c->r.x, c->r.y + c->r.h / 2, c->r.x + c->r.w, c->r.y + c->r.h / 2);
+    SDL_RenderDrawRect(ren, &c->r);
+
+    if (c->icount > 0) {
+        SDL_RenderSetClipRect(ren, &c->r);
+        SDL_RenderGeometry(ren, NULL, c->verts, c->vcount, c->indices, c->icount);
+        SDL_RenderSetClipRect(ren, NULL);
+    }
+    SDL_SetRenderDrawBlendMode(ren, SDL_BLENDMODE_NONE);
+}
+
+void ui_chart_destroy(UIChart* c)
+{
+    SDL_free(c->verts);
+    SDL_free(c->indices);
+    c->verts = NULL;
+    c->indices = NULL;
+    c->vcount = c->icount = c->vcap = c->icap = 0;
+}
@@ -0,0 +1,258 @@
+#include "../include/ui.h"
+
+// 가상화 리스트
+// - 데이터: fetch 콜백으로 UI_LIST_WINDOW 행씩만 가져와서 들고 있음
+// - 텍스처: 보이는 행 수 + 2 개의 고정 크기 스트리밍 텍스처를 돌려씀
+// → 행이 10만 개여도 메모리/프레임 비용은 보이는 행 수에만 비례
+
+static int list_max_scroll(const UIList* l)
+{
+    int total = l->count * l->row_h;
+    return total > l->r.h ? total - l->r.h : 0;
+}
+
+static void list_clamp_target(UIList* l)
+{
+    float maxs = (float)list_max_scroll(l);
+    if (l->scroll_target < 0.f) l->scroll_target = 0.f;
+    if (l->scroll_target > maxs) l->scroll_target = maxs;
+    if (l->scroll > maxs) l->scroll = maxs;
+    if (l->scroll < 0.f) l->scroll = 0.f;
+}
+
+static void list_free_slots(UIList* l)
+{
+    for (int i = 0; i < UI_LIST_MAX_SLOTS; i++) {
+        if (l->slots[i].tex) SDL_DestroyTexture(l->slots[i].tex);
+        l->slots[i].tex = NULL;
+        l->slots[i].index = -1;
+    }
+    l->slot_count = 0;
+    l->slot_tex_w = 0;
+}
+
+void ui_list_init(UIList* l, SDL_Rect r, int row_h, UIListFetchFn fetch, void* userdata)
+{
+    SDL_memset(l, 0, sizeof(*l));
+    l->r = r;
+    l->row_h = row_h > 0 ? row_h : 24;
+    l->fetch = fetch;
+    l->userdata = userdata;
+    l->color = (SDL_Color){ 200, 200, 200, 255 };
+    for (int i = 0; i < UI_LIST_MAX_SLOTS; i++) l->slots[i].index = -1;
+}
+
+void ui_list_set_rect(UIList* l, SDL_Rect r)
+{
+    // 폭이 바뀌면 행 텍스처 크기도 바뀌어야 함
+    if (r.w != l->r.w) list_free_slots(l);
+    l->r = r;
+    list_clamp_target(l);
+}
+
+void ui_list_invalidate(UIList* l)
+{
+    l->window_count = 0;
+    for (int i = 0; i < UI_LIST_MAX_SLOTS; i++) l->slots[i].index = -1;
+}
+
+void ui_list_set_count(UIList* l, int count)
+{
+    l->count = count > 0 ? count : 0;
+    ui_list_invalidate(l);
+    list_clamp_target(l);
+}
+
+void ui_list_scroll_to(UIList* l, int index)
+{
+    l->scroll = l->scroll_target = (float)(index * l->row_h);
+    list_clamp_target(l);
+}
+
+// 스크롤바 (오른쪽 얇은 막대)
+static SDL_Rect list_track(const UIList* l)
+{
+    SDL_Rect t = { l->r.x + l->r.w - UI_LIST_BAR_W, l->r.y, UI_LIST_BAR_W, l->r.h };
+    return t;
+}
+
+static SDL_Rect list_thumb(const UIList* l)
+{
+    SDL_Rect t = list_track(l);
+    int total = l->count * l->row_h;
+    if (total <= l->r.h) return t;
+    int th = (int)((Sint64)l->r.h * l->r.h / total);
+    if (th < 24) th = 24;
+    int maxs = list_max_scroll(l);
+    t.y += (int)((Sint64)(l->r.h - th) * (Sint64)l->scroll / (maxs > 0 ? maxs : 1));
+    t.h = th;
+    return t;
+}
+
+void ui_list_handle(UIList* l, const SDL_Event* e)
+{
+    if (e->type == SDL_MOUSEWHEEL) {
+        int mx, my;
+        SDL_GetMouseState(&mx, &my);
+        if (!ui_point_in_rect(mx, my, &l->r)) return;
+        l->scroll_target -= (float)(e->wheel.y * l->row_h * 3);
+        list_clamp_target(l);
+    }
+    else if (e->type == SDL_MOUSEBUTTONDOWN && e->button.button == SDL_BUTTON_LEFT) {
+        SDL_Rect track = list_track(l);
+        if (list_max_scroll(l) > 0 && ui_point_in_rect(e->button.x, e->button.y, &track)) {
+            SDL_Rect thumb = list_thumb(l);
+            l->dragging = 1;
+            // 막대 밖을 누르면 그 위치로 바로 점프
+            l->drag_offset = ui_point_in_rect(e->button.x, e->button.y, &thumb) ? e->button.y - thumb.y : thumb.h / 2;
+        }
+    }
+    else if (e->type == SDL_MOUSEBUTTONUP && e->button.button == SDL_BUTTON_LEFT) {
+        l->dragging = 0;
+    }
+
+    if (l->dragging && (e->type == SDL_MOUSEMOTION || e->type == SDL_MOUSEBUTTONDOWN)) {
+        int y = e->type == SDL_MOUSEMOTION ? e->motion.y : e->button.y;
+        SDL_Rect thumb = list_thumb(l);
+        int range = l->r.h - thumb.h;
+        float t = range > 0 ? (float)(y - l->drag_offset - l->r.y) / (float)range : 0.f;
+        if (t < 0.f) t = 0.f;
+        if (t > 1.f) t = 1.f;
+        l->scroll = l->scroll_target = t * (float)list_max_scroll(l);
+    }
+}
+
+void ui_list_update(UIList* l, float dt)
+{
+    // 목표 위치로 부드럽게
+    float d = l->scroll_target - l->scroll;
+    if (d > -0.5f && d < 0.5f) {
+        l->scroll = l->scroll_target;
+        return;
+    }
+    float k = dt * 15.f;
+    if (k > 1.f) k = 1.f;
+    l->scroll += d * k;
+}
+
+// [first, last] 가 데이터 창 안에 있도록 (없으면 가운데 맞춰 다시 가져옴)
+static void list_ensure_window(UIList* l, int first, int last)
+{
+    if (l->window_count > 0 && first >= l->window_first && last < l->window_first + l->window_count)
+        return;
+    if (!l->fetch) return;
+
+    if (!l->window) {
+        l->window = SDL_malloc(sizeof(*l->window) * UI_LIST_WINDOW);
+        if (!l->window) return;
+    }
+
+    int visible = last - first + 1;
+    int start = first - (UI_LIST_WINDOW - visible) / 2;
+    if (start + UI_LIST_WINDOW > l->count) start = l->count - UI_LIST_WINDOW;
+    if (start < 0) start = 0;
+    int want = l->count - start;
+    if (want > UI_LIST_WINDOW) want = UI_LIST_WINDOW;
+
+    l->window_first = start;
+    l->window_count = l->fetch(l->userdata, start, want, l->window);
+    if (l->window_count < 0) l->window_count = 0;
+}
+
+static void list_fill_slot(SDL_Renderer* ren, TTF_Font* font, UIList* l, UIListSlot* s, const char* text)
+{
+    if (!s->tex) {
+        s->tex = SDL_CreateTexture(ren, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STREAMING, l->slot_tex_w, l->row_h);
+        if (!s->tex) return;
+        SDL_SetTextureBlendMode(s->tex, SDL_BLENDMODE_BLEND);
+    }
+
+    void* pixels;
+    int pitch;
+    if (SDL_LockTexture(s->tex, NULL, &pixels, &pitch) != 0) return;
+    for (int y = 0; y < l->row_h; y++) SDL_memset((Uint8*)pixels + y * pitch, 0, (size_t)l->slot_tex_w * 4);
+
+    SDL_Surface* sf = (font && text && text[0]) ? TTF_RenderUTF8_Blended(font, text, l->color) : NULL;
+    if (sf && sf->format->format != SDL_PIXELFORMAT_ARGB8888) {
+        SDL_Surface* cv = SDL_ConvertSurfaceFormat(sf, SDL_PIXELFORMAT_ARGB8888, 0);
+        SDL_FreeSurface(sf);
+        sf = cv;
+    }
+    if (sf) {
+        int w = sf->w < l->slot_tex_w ? sf->w : l->slot_tex_w;
+        int h = sf->h < l->row_h ? sf->h : l->row_h;
+        int oy = (l->row_h - h) / 2;
+        for (int y = 0; y < h; y++)
+            SDL_memcpy((Uint8*)pixels + (y + oy) * pitch, (Uint8*)sf->pixels + y * sf->pitch, (size_t)w * 4);
+        SDL_FreeSurface(sf);
+    }
+    SDL_UnlockTexture(s->tex);
+}
+
+void ui_list_render(SDL_Renderer* ren, TTF_Font* font, UIList* l)
+{
+    if (l->count <= 0 || l->r.w <= UI_LIST_BAR_W || l->r.h <= 0) return;
+
+    int first = (int)l->scroll / l->row_h;
+    int last = ((int)l->scroll + l->r.h - 1) / l->row_h;
+    if (last >= l->count) last = l->count - 1;
+
+    // 텍스처 풀 크기 = 보이는 행 + 2 (위아래로 걸친 행)
+    int need = l->r.h / l->row_h + 2;
+    if (need > UI_LIST_MAX_SLOTS) need = UI_LIST_MAX_SLOTS;
+    if (l->slot_tex_w != l->r.w - UI_LIST_BAR_W || l->slot_count < need) {
+        if (l->slot_tex_w != l->r.w - UI_LIST_BAR_W) list_free_slots(l);
+        l->slot_tex_w = l->r.w - UI_LIST_BAR_W;
+        l->slot_count = need;
+    }
+    if (last - first + 1 > l->slot_count) last = first + l->slot_count - 1;
+
+    list_ensure_window(l, first, last);
+
+    SDL_RenderSetClipRect(ren, &l->r);
+    for (int i = first; i <= last; i++) {
+        UIListSlot* s = NULL;
+        for (int k = 0; k < l->slot_count; k++)
+            if (l->slots[k].index == i) { s = &l->slots[k]; break; }
+
+        if (!s) {
+            // 화면 밖으로 나간 행의 텍스처를 재사용
+            for (int k = 0; k < l->slot_count; k++) {
+                int idx = l->slots[k].index;
+                if (idx < first || idx > last) { s = &l->slots[k]; break; }
+            }
+            if (!s) continue;
+            int w = i - l->window_first;
+            const char* text = (w >= 0 && w < l->window_count) ? l->window[w] : "";
+            list_fill_slot(ren, font, l, s, text);
+            s->index = i;
+        }
+
+        if (s->tex) {
+            SDL_Rect dst = { l->r.x, l->r.y + i * l->row_h - (int)l->scroll, l->slot_tex_w, l->row_h };
+            SDL_RenderCopy(ren, s->tex, NULL, &dst);
+        }
+    }
+    SDL_RenderSetClipRect(ren, NULL);
+
+    // 스크롤바
+    if (list_max_scroll(l) > 0) {
+        SDL_Rect track = list_track(l);
+        SDL_Rect thumb = list_thumb(l);
+        SDL_SetRenderDrawBlendMode(ren, SDL_BLENDMODE_BLEND);
+        SDL_SetRenderDrawColor(ren, 255, 255, 255, 30);
+        SDL_RenderFillRect(ren, &track);
+        SDL_SetRenderDrawColor(ren, 255, 255, 255, l->dragging ? 160 : 100);
+        SDL_RenderFillRect(ren, &thumb);
+        SDL_SetRenderDrawBlendMode(ren, SDL_BLENDMODE_NONE);
+    }
+}
+
+void ui_list_destroy(UIList* l)
+{
+    list_free_slots(l);
+    SDL_free(l->window);
+    l->window = NULL;
+    l->window_count = 0;
+    l->count = 0;
+}
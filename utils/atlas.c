@@ -0,0 +1,305 @@
+#include "../include/atlas.h"
+
+void atlas_max_texture_size(SDL_Renderer* r, int* max_w, int* max_h)
+{
+    SDL_RendererInfo info;
+    *max_w = *max_h = 0;
+    if (r && SDL_GetRendererInfo(r, &info) == 0) {
+        *max_w = info.max_texture_width;
+        *max_h = info.max_texture_height;
+    }
+}
+
+// 선반 채우기: 프레임 순서대로 가로로 놓고, 넘치면 다음 줄, 줄이 넘치면 다음 페이지.
+// trim 크기로 채우고, 다른 프레임과 같거나 비어 있는 프레임은 자리를 차지하지 않음
+static bool pack_frames(AtlasLayout* out, int max_w, int max_h)
+{
+    int page = 0, x = 0, y = 0, row_h = 0;
+    for (int i = 0; i < out->frame_count; i++) {
+        const SDL_Rect* t = &out->trim[i];
+        if (out->same_as[i] >= 0) {
+            out->page[i] = out->page[out->same_as[i]];
+            out->dst[i] = out->dst[out->same_as[i]];
+            continue;
+        }
+        if (t->w <= 0 || t->h <= 0) {
+            out->page[i] = 0;
+            out->dst[i] = (SDL_Rect){ 0, 0, 0, 0 };
+            continue;
+        }
+        if (t->w > max_w || t->h > max_h) {
+            SDL_Log("[ATLAS] frame %d (%dx%d) exceeds max texture %dx%d", i, t->w, t->h, max_w, max_h);
+            return false;
+        }
+        if (x + t->w > max_w) { x = 0; y += row_h; row_h = 0; }
+        if (y + t->h > max_h) {
+            if (++page >= ATLAS_MAX_PAGES) {
+                SDL_Log("[ATLAS] needs more than %d pages", ATLAS_MAX_PAGES);
+                return false;
+            }
+            x = y = row_h = 0;
+        }
+        out->page[i] = (Uint8)page;
+        out->dst[i] = (SDL_Rect){ x, y, t->w, t->h };
+        out->page_w[page] = SDL_max(out->page_w[page], x + t->w);
+        out->page_h[page] = SDL_max(out->page_h[page], y + t->h);
+        x += t->w;
+        row_h = SDL_max(row_h, t->h);
+    }
+    out->page_count = page + 1;
+    if (out->page_w[0] <= 0) {
+        SDL_Log("[ATLAS] no visible frames");
+        return false;
+    }
+    return true;
+}
+
+// frames 복사 + 공통 초기값. n 이 너무 크면 자름
+static int layout_init(const SDL_Rect* frames, int n, AtlasLayout* out)
+{
+    SDL_memset(out, 0, sizeof(*out));
+    if (!frames || n <= 0) return 0;
+    if (n > ATLAS_MAX_FRAMES) {
+        SDL_Log("[ATLAS] too many frames (%d > %d)", n, ATLAS_MAX_FRAMES);
+        n = ATLAS_MAX_FRAMES;
+    }
+    out->frame_count = n;
+    for (int i = 0; i < n; i++) {
+        out->src[i] = frames[i];
+        out->trim[i] = (SDL_Rect){ 0, 0, frames[i].w, frames[i].h };
+        out->same_as[i] = -1;
+    }
+    return n;
+}
+
+bool atlas_layout_build(const SDL_Rect* frames, int n, int max_w, int max_h, AtlasLayout* out)
+{
+    n = layout_init(frames, n, out);
+    if (n <= 0) return false;
+    if (max_w <= 0) max_w = SDL_MAX_SINT32;
+    if (max_h <= 0) max_h = SDL_MAX_SINT32;
+
+    // 원본 배치가 한도 안이면 그대로
+    int ext_w = 0, ext_h = 0;
+    for (int i = 0; i < n; i++) {
+        ext_w = SDL_max(ext_w, frames[i].x + frames[i].w);
+        ext_h = SDL_max(ext_h, frames[i].y + frames[i].h);
+    }
+    if (ext_w <= max_w && ext_h <= max_h) {
+        out->identity = true;
+        out->page_count = 1;
+        out->page_w[0] = ext_w;
+        out->page_h[0] = ext_h;
+        for (int i = 0; i < n; i++) out->dst[i] = frames[i];
+        return true;
+    }
+
+    if (!pack_frames(out, max_w, max_h)) return false;
+    SDL_Log("[ATLAS] repacked %d frames (%dx%d) into %d page(s), max %dx%d",
+        n, ext_w, ext_h, out->page_count, max_w, max_h);
+    return true;
+}
+
+// 프레임 안 불투명 픽셀의 경계 (+ 여백 1px: 선형 필터링 때 가장자리가 원래처럼 투명으로 번지게)
+#define ATLAS_TRIM_PAD 1
+
+static SDL_Rect opaque_bounds(const SDL_Surface* s, const SDL_Rect* f)
+{
+    int x0 = f->w, y0 = f->h, x1 = -1, y1 = -1;
+    for (int y = 0; y < f->h; y++) {
+        const Uint8* row = (const Uint8*)s->pixels + (size_t)(f->y + y) * s->pitch + (size_t)f->x * 4;
+        for (int x = 0; x < f->w; x++) {
+            if (row[x * 4 + 3] == 0) continue;      // RGBA32: 바이트 순서 R,G,B,A
+            if (x < x0) x0 = x;
+            if (x > x1) x1 = x;
+            if (y < y0) y0 = y;
+            y1 = y;
+        }
+    }
+    if (x1 < 0) return (SDL_Rect){ 0, 0, 0, 0 };
+    x0 = SDL_max(0, x0 - ATLAS_TRIM_PAD);
+    y0 = SDL_max(0, y0 - ATLAS_TRIM_PAD);
+    x1 = SDL_min(f->w - 1, x1 + ATLAS_TRIM_PAD);
+    y1 = SDL_min(f->h - 1, y1 + ATLAS_TRIM_PAD);
+    return (SDL_Rect){ x0, y0, x1 - x0 + 1, y1 - y0 + 1 };
+}
+
+static Uint32 region_hash(const SDL_Surface* s, int x, int y, int w, int h)
+{
+    Uint32 hash = 2166136261u;          // FNV-1a
+    for (int r = 0; r < h; r++) {
+        const Uint8* p = (const Uint8*)s->pixels + (size_t)(y + r) * s->pitch + (size_t)x * 4;
+        for (int i = 0; i < w * 4; i++) { hash ^= p[i]; hash *= 16777619u; }
+    }
+    return hash;
+}
+
+static bool region_equal(const SDL_Surface* s, int ax, int ay, int bx, int by, int w, int h)
+{
+    for (int r = 0; r < h; r++) {
+        const Uint8* a = (const Uint8*)s->pixels + (size_t)(ay + r) * s->pitch + (size_t)ax * 4;
+        const Uint8* b = (const Uint8*)s->pixels + (size_t)(by + r) * s->pitch + (size_t)bx * 4;
+        if (SDL_memcmp(a, b, (size_t)w * 4) != 0) return false;
+    }
+    return true;
+}
+
+bool atlas_layout_build_trimmed(SDL_Surface* sheet, const SDL_Rect* frames, int n, int max_w, int max_h, AtlasLayout* out)
+{
+    n = layout_init(frames, n, out);
+    if (n <= 0 || !sheet) return false;
+    if (max_w <= 0) max_w = SDL_MAX_SINT32;
+    if (max_h <= 0) max_h = SDL_MAX_SINT32;
+
+    SDL_Surface* rgba = sheet;
+    if (sheet->format->format != SDL_PIXELFORMAT_RGBA32) {
+        rgba = SDL_ConvertSurfaceFormat(sheet, SDL_PIXELFORMAT_RGBA32, 0);
+        if (!rgba) {
+            SDL_Log("[ATLAS] convert fail: %s", SDL_GetError());
+            return false;
+        }
+    }
+    if (SDL_MUSTLOCK(rgba)) SDL_LockSurface(rgba);
+
+    Uint32 hashes[ATLAS_MAX_FRAMES];
+    long long before = 0, after = 0;
+    int unique = 0;
+    for (int i = 0; i < n; i++) {
+        const SDL_Rect* f = &frames[i];
+        before += (long long)f->w * f->h;
+        if (f->x < 0 || f->y < 0 || f->x + f->w > rgba->w || f->y + f->h > rgba->h) {
+            out->trim[i] = (SDL_Rect){ 0, 0, 0, 0 };
+            continue;
+        }
+        SDL_Rect t = opaque_bounds(rgba, f);
+        out->trim[i] = t;
+        if (t.w <= 0) continue;
+
+        int sx = f->x + t.x, sy = f->y + t.y;
+        hashes[i] = region_hash(rgba, sx, sy, t.w, t.h);
+        for (int j = 0; j < i; j++) {
+            const SDL_Rect* u = &out->trim[j];
+            if (out->same_as[j] >= 0 || u->w != t.w || u->h != t.h || u->x != t.x || u->y != t.y || hashes[j] != hashes[i])
+                continue;
+            if (region_equal(rgba, sx, sy, frames[j].x + u->x, frames[j].y + u->y, t.w, t.h)) {
+                out->same_as[i] = (Sint16)j;
+                break;
+            }
+        }
+        if (out->same_as[i] < 0) {
+            after += (long long)t.w * t.h;
+            unique++;
+        }
+    }
+
+    if (SDL_MUSTLOCK(rgba)) SDL_UnlockSurface(rgba);
+    if (rgba != sheet) SDL_FreeSurface(rgba);
+
+    out->trimmed = true;
+    if (!pack_frames(out, max_w, max_h)) return false;
+    SDL_Log("[ATLAS] trimmed %d frames -> %d unique, %lld -> %lld px (%d%%)",
+        n, unique, before, after, before > 0 ? (int)(after * 100 / before) : 0);
+    return true;
+}
+
+bool atlas_load_trimmed(SDL_Renderer* r, const char* path, const SDL_Rect* frames, int n, AtlasLayout* layout, AtlasPages* out)
+{
+    SDL_memset(out, 0, sizeof(*out));
+    SDL_Surface* sheet = IMG_Load(path);
+    if (!sheet) {
+        SDL_Log("[ATLAS] load fail %s : %s", path, IMG_GetError());
+        return false;
+    }
+    int maxW, maxH;
+    atlas_max_texture_size(r, &maxW, &maxH);
+    bool ok = atlas_layout_build_trimmed(sheet, frames, n, maxW, maxH, layout) &&
+              atlas_upload(r, sheet, layout, out);
+    SDL_FreeSurface(sheet);
+    if (!ok) SDL_Log("[ATLAS] %s unavailable", path);
+    return ok;
+}
+
+SDL_Surface* atlas_pack_page(SDL_Surface* sheet, const AtlasLayout* l, int page, bool* owned)
+{
+    *owned = false;
+    if (!sheet || !l || page < 0 || page >= l->page_count) return NULL;
+    if (l->identity && sheet->w == l->page_w[0] && sheet->h == l->page_h[0]) return sheet;
+
+    SDL_Surface* out = SDL_CreateRGBSurfaceWithFormat(0, l->page_w[page], l->page_h[page], 32, SDL_PIXELFORMAT_RGBA32);
+    if (!out) {
+        SDL_Log("[ATLAS] page surface fail: %s", SDL_GetError());
+        return NULL;
+    }
+    // 알파 섞지 않고 그대로 복사
+    SDL_BlendMode mode;
+    SDL_GetSurfaceBlendMode(sheet, &mode);
+    SDL_SetSurfaceBlendMode(sheet, SDL_BLENDMODE_NONE);
+    if (l->identity) {
+        SDL_Rect r = { 0, 0, l->page_w[0], l->page_h[0] };   // 프레임이 없는 오른쪽/아래 여백만 잘림
+        SDL_BlitSurface(sheet, &r, out, NULL);
+    } else {
+        for (int i = 0; i < l->frame_count; i++) {
+            if (l->page[i] != page || l->same_as[i] >= 0 || l->trim[i].w <= 0) continue;
+            SDL_Rect s = { l->src[i].x + l->trim[i].x, l->src[i].y + l->trim[i].y, l->trim[i].w, l->trim[i].h };
+            SDL_Rect d = l->dst[i];
+            SDL_BlitSurface(sheet, &s, out, &d);
+        }
+    }
+    SDL_SetSurfaceBlendMode(sheet, mode);
+    *owned = true;
+    return out;
+}
+
+bool atlas_upload(SDL_Renderer* r, SDL_Surface* sheet, const AtlasLayout* l, AtlasPages* out)
+{
+    SDL_memset(out, 0, sizeof(*out));
+    if (!r || !sheet || !l || l->page_count <= 0) return false;
+    out->layout = l;
+    for (int p = 0; p < l->page_count; p++) {
+        bool owned;
+        SDL_Surface* s = atlas_pack_page(sheet, l, p, &owned);
+        out->tex[p] = s ? SDL_CreateTextureFromSurface(r, s) : NULL;
+        if (owned) SDL_FreeSurface(s);
+        if (!out->tex[p]) {
+            SDL_Log("[ATLAS] page %d upload fail: %s", p, SDL_GetError());
+            atlas_free(out);
+            return false;
+        }
+        out->count = p + 1;
+    }
+    return true;
+}
+
+void atlas_free(AtlasPages* a)
+{
+    if (!a) return;
+    for (int p = 0; p < a->count; p++)
+        if (a->tex[p]) SDL_DestroyTexture(a->tex[p]);
+    SDL_memset(a, 0, sizeof(*a));
+}
+
+SDL_Texture* atlas_frame(const AtlasPages* a, int i, SDL_Rect* src)
+{
+    if (!a || !a->layout || i < 0 || i >= a->layout->frame_count) return NULL;
+    int p = a->layout->page[i];
+    if (p >= a->count) return NULL;
+    *src = a->layout->dst[i];
+    return a->tex[p];
+}
+
+void atlas_draw_frame(SDL_Renderer* r, const AtlasPages* a, int i, const SDL_Rect* dst)
+{
+    SDL_Rect src;
+    SDL_Texture* tex = atlas_frame(a, i, &src);
+    if (!tex || src.w <= 0) return;
+    const AtlasLayout* l = a->layout;
+    if (!l->trimmed) {
+        SDL_RenderCopy(r, tex, &src, dst);
+        return;
+    }
+    // 원래 프레임 → dst 배율로 잘린 영역 위치를 되살림 (소수 좌표라 배율이 커도 1px 어긋남 없음)
+    float sx = (float)dst->w / l->src[i].w, sy = (float)dst->h / l->src[i].h;
+    const SDL_Rect* t = &l->trim[i];
+    SDL_FRect d = { dst->x + t->x * sx, dst->y + t->y * sy, t->w * sx, t->h * sy };
+    SDL_RenderCopyF(r, tex, &src, &d);
+}
@@ -0,0 +1,654 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include <stdio.h>
+#include <string.h>
+#include "../include/balance.h"
+#include "../include/common.h"
+#include "../include/core.h"
+#include "../include/sim.h"
+#include "../include/parson.h"
+
+// 밸런스 시뮬레이터
+// 파라미터 그리드(정책 x 날씨 x 벌레/곰팡이/이벤트 확률)의 각 칸마다
+// 식물 일생을 --runs 번 돌리고 분포를 CSV/JSON 으로 출력한다.
+//
+// 예) GROWING.exe --balance --runs 100000 --policy attentive,casual --weather clear,rain
+//                  --bug-rate 0.0005,0.001 --format csv --out balance.csv
+//
+// 한 칸 안의 run 들을 모든 코어에 나눠서 돌림 (SDL_AtomicAdd 로 청크 배분)
+// run 시드 = hash(seed, cell, run) 이라 스레드 수와 상관없이 결과가 같다.
+
+#define BAL_MAX_LIST       16
+#define BAL_MAX_THREADS    64
+#define BAL_CHUNK          64      // 워커가 한 번에 가져가는 run 수
+#define BAL_PEST_NEGLECT   600.f   // 벌레/곰팡이를 10분 넘게 방치하면 방치 이벤트
+
+// ---------------- 플레이어 정책 ----------------
+typedef struct BalancePolicy {
+    const char* name;
+    float check_sec;        // 평균 확인 간격(sec)
+    float check_jitter;     // 간격 흔들림 비율 (0~1)
+    float miss_chance;      // 확인 시점에 아예 안 들어올 확률
+    float water_below;      // moisture < opt - water_below 이면 물 주기
+    float water_until;      // moisture >= opt + water_until 까지 채움
+    float fert_below;       // nutrition < fert_below 이면 비료
+    float treat_chance;     // 벌레/곰팡이를 보고 처리할 확률
+    bool  fix_temp;         // 적정 온도 벗어나면 온도 버튼 누름
+} BalancePolicy;
+
+static const BalancePolicy s_policies[] = {
+    // name          간격         흔들림  놓침   물<    물까지  비료<  처리   온도
+    { "attentive",   10.f * 60.f,  0.3f, 0.02f,  5.f,   5.f, 50.f, 1.0f, true  },
+    { "casual",    2.f * 3600.f,   0.5f, 0.15f, 15.f,   0.f, 30.f, 0.8f, true  },
+    { "neglectful", 8.f * 3600.f,  0.5f, 0.35f, 30.f, -10.f, 15.f, 0.5f, false },
+};
+#define BAL_POLICY_COUNT ((int)(sizeof(s_policies) / sizeof(s_policies[0])))
+
+// ---------------- 설정 / 결과 ----------------
+typedef struct BalanceCell {
+    int        policy;      // s_policies 인덱스
+    WeatherTag weather;
+    float      bug_rate;
+    float      mold_rate;
+    float      event_rate;
+} BalanceCell;
+
+typedef struct BalanceConfig {
+    const PlantInfo* plant;
+    SimParams base;
+
+    int    runs;
+    int    threads;
+    Uint64 seed;
+    int    start_level;
+    int    target_level;
+    float  max_hours;
+    float  dt;
+    bool   full_horizon;    // false: 목표 레벨 도달하면 그 run 은 종료
+
+    int        cell_count;
+    BalanceCell* cells;
+} BalanceConfig;
+
+typedef struct BalanceRun {
+    float  time_to_level;   // sec, 미도달이면 -1
+    float  happiness;       // 시간 가중 평균
+    Uint16 dry;             // 수분 0 도달 횟수
+    Uint16 starve;          // 영양 0 도달 횟수
+    Uint16 pest;            // 벌레/곰팡이 10분 이상 방치 횟수
+} BalanceRun;
+
+typedef struct BalanceJob {
+    const BalanceConfig* cfg;
+    const BalanceCell* cell;
+    Uint64 cell_seed;
+    BalanceRun* results;    // cfg->runs 개
+    SDL_atomic_t next;
+} BalanceJob;
+
+// ---------------- RNG ----------------
+static Uint64 bal_mix(Uint64 x)
+{
+    // splitmix64 finalizer
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+static float bal_rand01(Uint64* state)
+{
+    Uint64 x = *state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    *state = x;
+    return (float)((x * 0x2545F4914F6CDD1DULL) >> 40) / (float)(1 << 24);
+}
+
+// ---------------- 한 번의 일생 ----------------
+static float policy_next_interval(const BalancePolicy* pol, Uint64* rng)
+{
+    float j = (bal_rand01(rng) * 2.f - 1.f) * pol->check_jitter;
+    float sec = pol->check_sec * (1.f + j);
+    return sec < 1.f ? 1.f : sec;
+}
+
+static void policy_act(const BalancePolicy* pol, GrowSim* sim, Uint64* rng)
+{
+    const PlantInfo* p = sim->plant;
+    int guard;
+
+    if (bal_rand01(rng) < pol->miss_chance)
+        return;
+
+    if (sim->has_bug && bal_rand01(rng) < pol->treat_chance)
+        sim_action_kill_bug(sim);
+    if (sim->has_mold && bal_rand01(rng) < pol->treat_chance)
+        sim_action_remove_mold(sim);
+
+    if (sim->status.moisture < p->moisture_opt - pol->water_below) {
+        // 버튼 연타 상한 (실제 플레이어도 무한히 누르진 않음)
+        for (guard = 0; guard < 10 && sim->status.moisture < p->moisture_opt + pol->water_until; guard++)
+            sim_action_water(sim);
+    }
+
+    if (sim->status.nutrition < pol->fert_below)
+        sim_action_fertilize(sim);
+
+    if (pol->fix_temp) {
+        for (guard = 0; guard < 10 && sim->status.temp < p->temp_min; guard++)
+            sim_action_temp_up(sim);
+        for (guard = 0; guard < 10 && sim->status.temp > p->temp_max; guard++)
+            sim_action_temp_down(sim);
+    }
+}
+
+static void run_lifetime(const BalanceConfig* cfg, const BalanceCell* cell, Uint64 seed, BalanceRun* out)
+{
+    const BalancePolicy* pol = &s_policies[cell->policy];
+    SimParams params = cfg->base;
+    GrowSim sim;
+    Uint64 prng = bal_mix(seed ^ 0xA5A5A5A5ULL);  // 정책용 난수는 환경 난수와 분리
+    float horizon = cfg->max_hours * 3600.f;
+    float t = 0.f, next_check;
+    float pest_timer = 0.f;
+    bool  pest_counted = false;
+    bool  was_dry = false, was_starved = false;
+    double happy_acc = 0.0;
+
+    params.bug_chance_per_sec = cell->bug_rate;
+    params.mold_chance_per_sec = cell->mold_rate;
+    params.event_chance_per_sec = cell->event_rate;
+
+    sim_init(&sim, cfg->plant, &params, seed);
+    sim.level = cfg->start_level;
+    sim_set_weather(&sim, cell->weather);
+
+    SDL_memset(out, 0, sizeof(*out));
+    out->time_to_level = -1.f;
+    next_check = policy_next_interval(pol, &prng);
+
+    while (t < horizon) {
+        float dt = cfg->dt;
+        if (t + dt > horizon) dt = horizon - t;
+
+        sim_step(&sim, dt);
+        t += dt;
+        happy_acc += (double)sim.status.happiness * dt;
+
+        // 방치 이벤트: 0 에 "도달"한 순간만 센다
+        bool dry = sim.status.moisture <= 0.f;
+        bool starved = sim.status.nutrition <= 0.f;
+        if (dry && !was_dry && out->dry < 0xFFFF) out->dry++;
+        if (starved && !was_starved && out->starve < 0xFFFF) out->starve++;
+        was_dry = dry;
+        was_starved = starved;
+
+        if (sim.has_bug || sim.has_mold) {
+            pest_timer += dt;
+            if (!pest_counted && pest_timer >= BAL_PEST_NEGLECT) {
+                if (out->pest < 0xFFFF) out->pest++;
+                pest_counted = true;
+            }
+        }
+        else {
+            pest_timer = 0.f;
+            pest_counted = false;
+        }
+
+        if (t >= next_check) {
+            policy_act(pol, &sim, &prng);
+            next_check = t + policy_next_interval(pol, &prng);
+        }
+
+        if (out->time_to_level < 0.f && sim.level >= cfg->target_level) {
+            out->time_to_level = t;
+            if (!cfg->full_horizon) break;
+        }
+    }
+
+    out->happiness = t > 0.f ? (float)(happy_acc / t) : sim.status.happiness;
+}
+
+static int SDLCALL balance_worker(void* data)
+{
+    BalanceJob* job = (BalanceJob*)data;
+    int runs = job->cfg->runs;
+
+    for (;;) {
+        int begin = SDL_AtomicAdd(&job->next, BAL_CHUNK);
+        if (begin >= runs) break;
+        int end = begin + BAL_CHUNK;
+        if (end > runs) end = runs;
+
+        for (int i = begin; i < end; i++) {
+            Uint64 seed = bal_mix(job->cell_seed ^ (Uint64)i);
+            run_lifetime(job->cfg, job->cell, seed, &job->results[i]);
+        }
+    }
+    return 0;
+}
+
+// ---------------- 통계 ----------------
+typedef struct BalanceStats {
+    int    reached;
+    double ttl_mean;
+    float  ttl_pct[6];      // p10 p25 p50 p75 p90 p99 (hour)
+    double happy_mean;
+    float  happy_pct[3];    // p10 p50 p90
+    double dry_mean, starve_mean, pest_mean;
+    float  neglect_p50, neglect_p90;
+} BalanceStats;
+
+static const float s_ttl_q[6] = { 0.10f, 0.25f, 0.50f, 0.75f, 0.90f, 0.99f };
+static const char* s_ttl_names[6] = { "p10", "p25", "p50", "p75", "p90", "p99" };
+static const float s_happy_q[3] = { 0.10f, 0.50f, 0.90f };
+static const char* s_happy_names[3] = { "p10", "p50", "p90" };
+
+static int cmp_float(const void* a, const void* b)
+{
+    float x = *(const float*)a, y = *(const float*)b;
+    return (x > y) - (x < y);
+}
+
+// 정렬된 배열에서 선형 보간 분위수
+static float percentile(const float* sorted, int n, float q)
+{
+    if (n <= 0) return -1.f;
+    float pos = q * (float)(n - 1);
+    int lo = (int)pos;
+    if (lo >= n - 1) return sorted[n - 1];
+    float f = pos - (float)lo;
+    return sorted[lo] + (sorted[lo + 1] - sorted[lo]) * f;
+}
+
+static void compute_stats(const BalanceRun* r, int n, float* scratch, BalanceStats* st)
+{
+    int i, k = 0;
+    SDL_memset(st, 0, sizeof(*st));
+
+    // 레벨 도달 시간 (도달한 run 만)
+    for (i = 0; i < n; i++) {
+        if (r[i].time_to_level >= 0.f) {
+            scratch[k++] = r[i].time_to_level / 3600.f;
+            st->ttl_mean += r[i].time_to_level / 3600.f;
+        }
+    }
+    st->reached = k;
+    if (k > 0) st->ttl_mean /= k;
+    SDL_qsort(scratch, (size_t)k, sizeof(float), cmp_float);
+    for (i = 0; i < 6; i++) st->ttl_pct[i] = percentile(scratch, k, s_ttl_q[i]);
+
+    // 행복도
+    for (i = 0; i < n; i++) {
+        scratch[i] = r[i].happiness;
+        st->happy_mean += r[i].happiness;
+    }
+    if (n > 0) st->happy_mean /= n;
+    SDL_qsort(scratch, (size_t)n, sizeof(float), cmp_float);
+    for (i = 0; i < 3; i++) st->happy_pct[i] = percentile(scratch, n, s_happy_q[i]);
+
+    // 방치 이벤트
+    for (i = 0; i < n; i++) {
+        st->dry_mean += r[i].dry;
+        st->starve_mean += r[i].starve;
+        st->pest_mean += r[i].pest;
+        scratch[i] = (float)(r[i].dry + r[i].starve + r[i].pest);
+    }
+    if (n > 0) {
+        st->dry_mean /= n;
+        st->starve_mean /= n;
+        st->pest_mean /= n;
+    }
+    SDL_qsort(scratch, (size_t)n, sizeof(float), cmp_float);
+    st->neglect_p50 = percentile(scratch, n, 0.50f);
+    st->neglect_p90 = percentile(scratch, n, 0.90f);
+}
+
+// ---------------- 출력 ----------------
+static const char* weather_name(WeatherTag t)
+{
+    switch (t) {
+    case WEATHER_TAG_CLEAR:  return "clear";
+    case WEATHER_TAG_CLOUDY: return "cloudy";
+    case WEATHER_TAG_RAIN:   return "rain";
+    case WEATHER_TAG_SNOW:   return "snow";
+    default:                 return "unknown";
+    }
+}
+
+static void write_csv_header(FILE* fp)
+{
+    fprintf(fp, "policy,weather,bug_rate,mold_rate,event_rate,runs,reached");
+    for (int i = 0; i < 6; i++) fprintf(fp, ",ttl_%s_h", s_ttl_names[i]);
+    fprintf(fp, ",ttl_mean_h");
+    for (int i = 0; i < 3; i++) fprintf(fp, ",happy_%s", s_happy_names[i]);
+    fprintf(fp, ",happy_mean,dry_mean,starve_mean,pest_mean,neglect_p50,neglect_p90\n");
+}
+
+static void write_csv_row(FILE* fp, const BalanceConfig* cfg, const BalanceCell* c, const BalanceStats* st)
+{
+    fprintf(fp, "%s,%s,%g,%g,%g,%d,%d",
+        s_policies[c->policy].name, weather_name(c->weather),
+        c->bug_rate, c->mold_rate, c->event_rate, cfg->runs, st->reached);
+    for (int i = 0; i < 6; i++) fprintf(fp, ",%.4f", st->ttl_pct[i]);
+    fprintf(fp, ",%.4f", st->ttl_mean);
+    for (int i = 0; i < 3; i++) fprintf(fp, ",%.2f", st->happy_pct[i]);
+    fprintf(fp, ",%.2f,%.4f,%.4f,%.4f,%.1f,%.1f\n",
+        st->happy_mean, st->dry_mean, st->starve_mean, st->pest_mean,
+        st->neglect_p50, st->neglect_p90);
+}
+
+static JSON_Value* stats_to_json(const BalanceConfig* cfg, const BalanceCell* c, const BalanceStats* st)
+{
+    JSON_Value* v = json_value_init_object();
+    JSON_Object* o = json_value_get_object(v);
+    char key[64];
+
+    json_object_set_string(o, "policy", s_policies[c->policy].name);
+    json_object_set_string(o, "weather", weather_name(c->weather));
+    json_object_set_number(o, "bug_rate", c->bug_rate);
+    json_object_set_number(o, "mold_rate", c->mold_rate);
+    json_object_set_number(o, "event_rate", c->event_rate);
+    json_object_set_number(o, "runs", cfg->runs);
+    json_object_set_number(o, "reached", st->reached);
+
+    for (int i = 0; i < 6; i++) {
+        SDL_snprintf(key, sizeof(key), "time_to_level_h.%s", s_ttl_names[i]);
+        json_object_dotset_number(o, key, st->ttl_pct[i]);
+    }
+    json_object_dotset_number(o, "time_to_level_h.mean", st->ttl_mean);
+
+    for (int i = 0; i < 3; i++) {
+        SDL_snprintf(key, sizeof(key), "happiness.%s", s_happy_names[i]);
+        json_object_dotset_number(o, key, st->happy_pct[i]);
+    }
+    json_object_dotset_number(o, "happiness.mean", st->happy_mean);
+
+    json_object_dotset_number(o, "neglect.dry_mean", st->dry_mean);
+    json_object_dotset_number(o, "neglect.starve_mean", st->starve_mean);
+    json_object_dotset_number(o, "neglect.pest_mean", st->pest_mean);
+    json_object_dotset_number(o, "neglect.total_p50", st->neglect_p50);
+    json_object_dotset_number(o, "neglect.total_p90", st->neglect_p90);
+    return v;
+}
+
+// ---------------- 인자 파싱 ----------------
+// "a,b,c" → 최대 BAL_MAX_LIST 개의 토큰. 더 있으면 -1
+static int split_list(const char* s, char out[][32])
+{
+    int n = 0;
+    while (s && *s) {
+        const char* comma = SDL_strchr(s, ',');
+        size_t len = comma ? (size_t)(comma - s) : SDL_strlen(s);
+        if (len > 0) {
+            if (n == BAL_MAX_LIST) return -1;
+            if (len >= 32) len = 31;
+            SDL_memcpy(out[n], s, len);
+            out[n][len] = '\0';
+            n++;
+        }
+        s = comma ? comma + 1 : NULL;
+    }
+    return n;
+}
+
+// 같은 옵션을 여러 번 줘도 목록 하나에 이어 붙임. BAL_MAX_LIST 개를 넘으면 에러
+static int too_many(const char* opt)
+{
+    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[BALANCE] too many values for %s (max %d)", opt, BAL_MAX_LIST);
+    return 1;
+}
+
+static bool parse_floats(const char* s, const char* opt, float* out, int* n)
+{
+    char tok[BAL_MAX_LIST][32];
+    int k = split_list(s, tok);
+    if (k < 0 || *n + k > BAL_MAX_LIST) { too_many(opt); return false; }
+    for (int i = 0; i < k; i++) out[(*n)++] = (float)SDL_atof(tok[i]);
+    return true;
+}
+
+static WeatherTag parse_weather(const char* s)
+{
+    if (SDL_strcasecmp(s, "clear") == 0)  return WEATHER_TAG_CLEAR;
+    if (SDL_strcasecmp(s, "cloudy") == 0) return WEATHER_TAG_CLOUDY;
+    if (SDL_strcasecmp(s, "rain") == 0)   return WEATHER_TAG_RAIN;
+    if (SDL_strcasecmp(s, "snow") == 0)   return WEATHER_TAG_SNOW;
+    return WEATHER_TAG_UNKNOWN;
+}
+
+static int parse_policy(const char* s)
+{
+    for (int i = 0; i < BAL_POLICY_COUNT; i++)
+        if (SDL_strcasecmp(s, s_policies[i].name) == 0) return i;
+    return -1;
+}
+
+static void print_usage(void)
+{
+    printf(
+        "usage: GROWING --balance [options]\n"
+        "  --plant ID           plants.json 의 식물 id (기본 monstera)\n"
+        "  --runs N             칸마다 돌릴 일생 수 (기본 10000)\n"
+        "  --threads N          워커 스레드 수 (기본 CPU 코어 수)\n"
+        "  --seed N             기본 1\n"
+        "  --start-level N      시작 레벨 (기본 1)\n"
+        "  --target-level N     목표 레벨 (기본 3)\n"
+        "  --max-hours H        일생 길이 상한, 게임 시간 (기본 72)\n"
+        "  --dt SEC             시뮬 스텝 (기본 1.0)\n"
+        "  --full               목표 도달 후에도 max-hours 까지 계속 돌림\n"
+        "  --policy LIST        attentive,casual,neglectful (기본 전부)\n"
+        "  --weather LIST       clear,cloudy,rain,snow (기본 clear)\n"
+        "  --bug-rate LIST      벌레 확률/초\n"
+        "  --mold-rate LIST     곰팡이 확률/초\n"
+        "  --event-rate LIST    날씨 이벤트 확률/초\n"
+        "  --format csv|json    (기본 csv)\n"
+        "  --out PATH           (기본 stdout)\n");
+}
+
+int balance_main(int argc, char** argv)
+{
+    BalanceConfig cfg;
+    const char* plant_id = "monstera";
+    const char* format = "csv";
+    const char* out_path = NULL;
+
+    int   policies[BAL_MAX_LIST], policy_n = 0;
+    WeatherTag weathers[BAL_MAX_LIST];
+    int   weather_n = 0;
+    float bugs[BAL_MAX_LIST], molds[BAL_MAX_LIST], events[BAL_MAX_LIST];
+    int   bug_n = 0, mold_n = 0, event_n = 0;
+    char  tok[BAL_MAX_LIST][32];
+    int   i, n;
+
+    SDL_memset(&cfg, 0, sizeof(cfg));
+    sim_default_params(&cfg.base);
+    cfg.runs = 10000;
+    cfg.threads = SDL_GetCPUCount();
+    cfg.seed = 1;
+    cfg.start_level = 1;
+    cfg.target_level = 3;
+    cfg.max_hours = 72.f;
+    cfg.dt = 1.f;
+
+    for (i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        const char* v = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (SDL_strcmp(a, "--balance") == 0) continue;
+        if (SDL_strcmp(a, "--help") == 0) { print_usage(); return 0; }
+        if (SDL_strcmp(a, "--full") == 0) { cfg.full_horizon = true; continue; }
+        if (!v) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[BALANCE] missing value for %s", a);
+            print_usage();
+            return 1;
+        }
+        i++;
+
+        if (SDL_strcmp(a, "--plant") == 0) plant_id = v;
+        else if (SDL_strcmp(a, "--runs") == 0) cfg.runs = SDL_atoi(v);
+        else if (SDL_strcmp(a, "--threads") == 0) cfg.threads = SDL_atoi(v);
+        else if (SDL_strcmp(a, "--seed") == 0) cfg.seed = SDL_strtoull(v, NULL, 10);
+        else if (SDL_strcmp(a, "--start-level") == 0) cfg.start_level = SDL_atoi(v);
+        else if (SDL_strcmp(a, "--target-level") == 0) cfg.target_level = SDL_atoi(v);
+        else if (SDL_strcmp(a, "--max-hours") == 0) cfg.max_hours = (float)SDL_atof(v);
+        else if (SDL_strcmp(a, "--dt") == 0) cfg.dt = (float)SDL_atof(v);
+        else if (SDL_strcmp(a, "--format") == 0) {
+            if (SDL_strcmp(v, "csv") != 0 && SDL_strcmp(v, "json") != 0) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[BALANCE] unknown format: %s (csv|json)", v);
+                return 1;
+            }
+            format = v;
+        }
+        else if (SDL_strcmp(a, "--out") == 0) out_path = v;
+        else if (SDL_strcmp(a, "--bug-rate") == 0) { if (!parse_floats(v, a, bugs, &bug_n)) return 1; }
+        else if (SDL_strcmp(a, "--mold-rate") == 0) { if (!parse_floats(v, a, molds, &mold_n)) return 1; }
+        else if (SDL_strcmp(a, "--event-rate") == 0) { if (!parse_floats(v, a, events, &event_n)) return 1; }
+        else if (SDL_strcmp(a, "--policy") == 0) {
+            n = split_list(v, tok);
+            if (n < 0) return too_many(a);
+            for (int k = 0; k < n; k++) {
+                int p = parse_policy(tok[k]);
+                if (p < 0) {
+                    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[BALANCE] unknown policy: %s", tok[k]);
+                    return 1;
+                }
+                if (policy_n == BAL_MAX_LIST) return too_many(a);
+                policies[policy_n++] = p;
+            }
+        }
+        else if (SDL_strcmp(a, "--weather") == 0) {
+            n = split_list(v, tok);
+            if (n < 0) return too_many(a);
+            for (int k = 0; k < n; k++) {
+                WeatherTag w = parse_weather(tok[k]);
+                if (w == WEATHER_TAG_UNKNOWN) {
+                    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[BALANCE] unknown weather: %s", tok[k]);
+                    return 1;
+                }
+                if (weather_n == BAL_MAX_LIST) return too_many(a);
+                weathers[weather_n++] = w;
+            }
+        }
+        else {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[BALANCE] unknown option: %s", a);
+            print_usage();
+            return 1;
+        }
+    }
+
+    if (cfg.runs <= 0 || cfg.dt <= 0.f || cfg.max_hours <= 0.f) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[BALANCE] runs/dt/max-hours must be > 0");
+        return 1;
+    }
+    if (cfg.threads < 1) cfg.threads = 1;
+    if (cfg.threads > BAL_MAX_THREADS) cfg.threads = BAL_MAX_THREADS;
+
+    // 기본값: 정책 전부, 맑음, 게임 기본 확률
+    if (policy_n == 0) for (i = 0; i < BAL_POLICY_COUNT; i++) policies[policy_n++] = i;
+    if (weather_n == 0) weathers[weather_n++] = WEATHER_TAG_CLEAR;
+    if (bug_n == 0) bugs[bug_n++] = cfg.base.bug_chance_per_sec;
+    if (mold_n == 0) molds[mold_n++] = cfg.base.mold_chance_per_sec;
+    if (event_n == 0) events[event_n++] = cfg.base.event_chance_per_sec;
+
+    // 식물 데이터
+    if (plantdb_load(ASSETS_DIR "plants.json") <= 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[BALANCE] plants.json load failed");
+        return 1;
+    }
+    int pidx = plantdb_find_index_by_id(plant_id);
+    if (pidx < 0) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[BALANCE] unknown plant id: %s", plant_id);
+        plantdb_free();
+        return 1;
+    }
+    cfg.plant = plantdb_get(pidx);
+
+    // 그리드 전개
+    cfg.cell_count = policy_n * weather_n * bug_n * mold_n * event_n;
+    cfg.cells = (BalanceCell*)SDL_calloc((size_t)cfg.cell_count, sizeof(BalanceCell));
+    BalanceRun* results = (BalanceRun*)SDL_malloc(sizeof(BalanceRun) * (size_t)cfg.runs);
+    float* scratch = (float*)SDL_malloc(sizeof(float) * (size_t)cfg.runs);
+    if (!cfg.cells || !results || !scratch) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[BALANCE] out of memory (runs=%d)", cfg.runs);
+        SDL_free(cfg.cells); SDL_free(results); SDL_free(scratch);
+        plantdb_free();
+        return 1;
+    }
+    n = 0;
+    for (int p = 0; p < policy_n; p++)
+        for (int w = 0; w < weather_n; w++)
+            for (int b = 0; b < bug_n; b++)
+                for (int m = 0; m < mold_n; m++)
+                    for (int e = 0; e < event_n; e++) {
+                        BalanceCell* c = &cfg.cells[n++];
+                        c->policy = policies[p];
+                        c->weather = weathers[w];
+                        c->bug_rate = bugs[b];
+                        c->mold_rate = molds[m];
+                        c->event_rate = events[e];
+                    }
+
+    FILE* fp = stdout;
+    if (out_path) {
+        fp = fopen(out_path, "w");
+        if (!fp) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "[BALANCE] cannot open %s", out_path);
+            SDL_free(cfg.cells); SDL_free(results); SDL_free(scratch);
+            plantdb_free();
+            return 1;
+        }
+    }
+    bool as_json = SDL_strcmp(format, "json") == 0;
+    JSON_Value* root = as_json ? json_value_init_array() : NULL;
+    if (!as_json) write_csv_header(fp);
+
+    SDL_Log("[BALANCE] plant=%s cells=%d runs=%d threads=%d",
+        plantdb_id(cfg.plant), cfg.cell_count, cfg.runs, cfg.threads);
+    Uint64 t0 = SDL_GetPerformanceCounter();
+
+    for (n = 0; n < cfg.cell_count; n++) {
+        BalanceJob job;
+        SDL_Thread* th[BAL_MAX_THREADS];
+        BalanceStats st;
+
+        job.cfg = &cfg;
+        job.cell = &cfg.cells[n];
+        job.cell_seed = bal_mix(cfg.seed ^ bal_mix((Uint64)n + 1));
+        job.results = results;
+        SDL_AtomicSet(&job.next, 0);
+
+        // 메인 스레드도 워커로 참여
+        for (i = 0; i < cfg.threads - 1; i++)
+            th[i] = SDL_CreateThread(balance_worker, "balance", &job);
+        balance_worker(&job);
+        for (i = 0; i < cfg.threads - 1; i++)
+            if (th[i]) SDL_WaitThread(th[i], NULL);
+
+        compute_stats(results, cfg.runs, scratch, &st);
+        if (as_json) json_array_append_value(json_value_get_array(root), stats_to_json(&cfg, job.cell, &st));
+        else write_csv_row(fp, &cfg, job.cell, &st);
+    }
+
+    double secs = (double)(SDL_GetPerformanceCounter() - t0) / (double)SDL_GetPerformanceFrequency();
+    SDL_Log("[BALANCE] done: %d lifetimes in %.2fs (%.0f/s)",
+        cfg.cell_count * cfg.runs, secs, secs > 0 ? (cfg.cell_count * (double)cfg.runs) / secs : 0.0);
+
+    if (as_json) {
+        char* s = json_serialize_to_string_pretty(root);
+        if (s) {
+            fputs(s, fp);
+            fputc('\n', fp);
+            json_free_serialized_string(s);
+        }
+        json_value_free(root);
+    }
+    if (fp != stdout) fclose(fp);
+
+    SDL_free(cfg.cells);
+    SDL_free(results);
+    SDL_free(scratch);
+    plantdb_free();
+    return 0;
+}
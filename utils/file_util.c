@@ -0,0 +1,16 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include "../include/utils.h"
+#include <stdio.h>
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+bool file_replace(const char* tmp, const char* path)
+{
+#ifdef _WIN32
+    // CRT rename 은 대상이 있으면 실패하고, remove 후 rename 은 그 사이에 꺼지면 둘 다 잃음
+    return MoveFileExA(tmp, path, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return rename(tmp, path) == 0;     // POSIX rename 은 덮어쓰기가 원자적
+#endif
+}
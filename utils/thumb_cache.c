@@ -0,0 +1,281 @@
+#include "../include/thumb_cache.h"
+#include <SDL2/SDL_image.h>
+
+typedef enum {
+    THUMB_EMPTY = 0,
+    THUMB_QUEUED,       // 작업 스레드 대기
+    THUMB_DECODING,     // 작업 스레드가 읽는 중 (버리지 않음)
+    THUMB_DECODED,      // 표면 준비, 텍스처 업로드 대기
+    THUMB_READY,
+    THUMB_FAILED
+} ThumbState;
+
+typedef struct ThumbSlot {
+    ThumbState   state;
+    Uint32       hash;
+    char         path[256];
+    int          priority;
+    Uint32       lastUse;   // LRU 시각 (s_clock)
+    const AtlasLayout* layout;                  // 있으면 이 배치대로 페이지를 나눠 올림
+    SDL_Surface* surface[ATLAS_MAX_PAGES];      // 업로드 대기 페이지 (layout 없으면 [0] 한 장)
+    int          surfaceCount;
+    AtlasPages   pages;
+} ThumbSlot;
+
+static ThumbSlot*  s_slots = NULL;
+static int         s_cap = 0;
+static Uint32      s_clock = 0;
+static SDL_mutex*  s_lock = NULL;
+static SDL_cond*   s_wake = NULL;
+static SDL_Thread* s_worker = NULL;
+static bool        s_quit = false;
+
+static Uint32 hash_path(const char* s)
+{
+    Uint32 h = 2166136261u;             // FNV-1a
+    while (*s) { h ^= (Uint8)*s++; h *= 16777619u; }
+    return h;
+}
+
+static void slot_release(ThumbSlot* t)
+{
+    for (int p = 0; p < t->surfaceCount; p++)
+        if (t->surface[p]) SDL_FreeSurface(t->surface[p]);
+    atlas_free(&t->pages);
+    SDL_memset(t, 0, sizeof(*t));
+}
+
+// 읽은 시트 → 업로드할 페이지 표면들 (layout 이 있으면 한도 안으로 다시 채움). 잠금 밖에서
+static int split_pages(SDL_Surface* sheet, const AtlasLayout* layout, SDL_Surface** out)
+{
+    if (!sheet) return 0;
+    if (!layout) { out[0] = sheet; return 1; }
+
+    bool keepSheet = false;
+    int n = 0;
+    for (; n < layout->page_count; n++) {
+        bool owned;
+        out[n] = atlas_pack_page(sheet, layout, n, &owned);
+        if (!out[n]) break;
+        if (!owned) keepSheet = true;
+    }
+    if (!keepSheet) SDL_FreeSurface(sheet);
+    if (n < layout->page_count) {
+        for (int p = 0; p < n; p++) if (out[p] != sheet) SDL_FreeSurface(out[p]);
+        if (keepSheet) SDL_FreeSurface(sheet);
+        return 0;
+    }
+    return n;
+}
+
+// 잠금 상태에서 호출
+static ThumbSlot* find_slot(const char* path, Uint32 h)
+{
+    for (int i = 0; i < s_cap; i++) {
+        ThumbSlot* t = &s_slots[i];
+        if (t->state != THUMB_EMPTY && t->hash == h && SDL_strcmp(t->path, path) == 0) return t;
+    }
+    return NULL;
+}
+
+// 잠금 상태에서 호출: 다음에 풀 것 (우선순위 → 최근 요청 순)
+static ThumbSlot* next_job(void)
+{
+    ThumbSlot* best = NULL;
+    for (int i = 0; i < s_cap; i++) {
+        ThumbSlot* t = &s_slots[i];
+        if (t->state != THUMB_QUEUED) continue;
+        if (!best || t->priority < best->priority ||
+            (t->priority == best->priority && t->lastUse > best->lastUse))
+            best = t;
+    }
+    return best;
+}
+
+static int thumb_worker(void* ud)
+{
+    (void)ud;
+    char path[256];
+    SDL_LockMutex(s_lock);
+    for (;;) {
+        ThumbSlot* job = NULL;
+        while (!s_quit && !(job = next_job()))
+            SDL_CondWait(s_wake, s_lock);
+        if (s_quit) break;
+
+        job->state = THUMB_DECODING;
+        SDL_strlcpy(path, job->path, sizeof(path));
+        const AtlasLayout* layout = job->layout;
+        SDL_UnlockMutex(s_lock);
+
+        // 파일 읽기 + PNG 풀기 + 페이지 나누기는 잠금 밖에서
+        SDL_Surface* pages[ATLAS_MAX_PAGES];
+        SDL_Surface* surf = IMG_Load(path);
+        if (!surf) SDL_Log("[THUMB] load fail %s : %s", path, IMG_GetError());
+        int n = split_pages(surf, layout, pages);
+
+        SDL_LockMutex(s_lock);
+        for (int p = 0; p < n; p++) job->surface[p] = pages[p];    // DECODING 중인 칸은 버리지 않으므로 그대로 유효
+        job->surfaceCount = n;
+        job->state = n > 0 ? THUMB_DECODED : THUMB_FAILED;
+    }
+    SDL_UnlockMutex(s_lock);
+    return 0;
+}
+
+bool thumb_cache_init(int capacity)
+{
+    if (s_slots) return true;
+    if (capacity <= 0) capacity = THUMB_CACHE_DEFAULT_CAP;
+    s_slots = (ThumbSlot*)SDL_calloc(capacity, sizeof(ThumbSlot));
+    s_lock = SDL_CreateMutex();
+    s_wake = SDL_CreateCond();
+    if (!s_slots || !s_lock || !s_wake) {
+        SDL_Log("[THUMB] init failed: %s", SDL_GetError());
+        thumb_cache_shutdown();
+        return false;
+    }
+    s_cap = capacity;
+    s_clock = 0;
+    s_quit = false;
+    s_worker = SDL_CreateThread(thumb_worker, "thumb_io", NULL);
+    if (!s_worker) SDL_Log("[THUMB] worker failed, decoding on main thread: %s", SDL_GetError());
+    return true;
+}
+
+void thumb_cache_shutdown(void)
+{
+    if (s_worker) {
+        SDL_LockMutex(s_lock);
+        s_quit = true;
+        SDL_CondSignal(s_wake);
+        SDL_UnlockMutex(s_lock);
+        SDL_WaitThread(s_worker, NULL);
+        s_worker = NULL;
+    }
+    for (int i = 0; i < s_cap; i++) slot_release(&s_slots[i]);
+    SDL_free(s_slots);
+    s_slots = NULL;
+    s_cap = 0;
+    if (s_wake) { SDL_DestroyCond(s_wake); s_wake = NULL; }
+    if (s_lock) { SDL_DestroyMutex(s_lock); s_lock = NULL; }
+}
+
+void thumb_cache_request(const char* path, int priority)
+{
+    thumb_cache_request_atlas(path, priority, NULL);
+}
+
+void thumb_cache_request_atlas(const char* path, int priority, const AtlasLayout* layout)
+{
+    if (!s_slots || !path || !*path) return;
+    Uint32 h = hash_path(path);
+
+    SDL_LockMutex(s_lock);
+    ThumbSlot* t = find_slot(path, h);
+    if (t) {
+        if (priority < t->priority) t->priority = priority;
+        t->lastUse = ++s_clock;
+        SDL_UnlockMutex(s_lock);
+        return;
+    }
+
+    // 빈 칸, 없으면 풀고 있는 것 빼고 가장 오래 안 쓴 칸
+    ThumbSlot* victim = NULL;
+    for (int i = 0; i < s_cap; i++) {
+        ThumbSlot* c = &s_slots[i];
+        if (c->state == THUMB_EMPTY) { victim = c; break; }
+        if (c->state == THUMB_DECODING) continue;
+        if (!victim || c->lastUse < victim->lastUse) victim = c;
+    }
+    if (victim) {
+        slot_release(victim);
+        SDL_strlcpy(victim->path, path, sizeof(victim->path));
+        victim->hash = h;
+        victim->priority = priority;
+        victim->layout = layout;
+        victim->lastUse = ++s_clock;
+        victim->state = THUMB_QUEUED;
+        SDL_CondSignal(s_wake);
+    }
+    SDL_UnlockMutex(s_lock);
+}
+
+SDL_Texture* thumb_cache_get(const char* path)
+{
+    if (!s_slots || !path) return NULL;
+    SDL_Texture* tex = NULL;
+    SDL_LockMutex(s_lock);
+    ThumbSlot* t = find_slot(path, hash_path(path));
+    if (t) {
+        t->lastUse = ++s_clock;
+        if (t->state == THUMB_READY) tex = t->pages.tex[0];
+    }
+    SDL_UnlockMutex(s_lock);
+    return tex;
+}
+
+const AtlasPages* thumb_cache_get_atlas(const char* path)
+{
+    if (!s_slots || !path) return NULL;
+    const AtlasPages* pages = NULL;
+    SDL_LockMutex(s_lock);
+    ThumbSlot* t = find_slot(path, hash_path(path));
+    if (t) {
+        t->lastUse = ++s_clock;
+        if (t->state == THUMB_READY) pages = &t->pages;
+    }
+    SDL_UnlockMutex(s_lock);
+    return pages;
+}
+
+bool thumb_cache_failed(const char* path)
+{
+    if (!s_slots || !path) return false;
+    SDL_LockMutex(s_lock);
+    ThumbSlot* t = find_slot(path, hash_path(path));
+    bool failed = t && t->state == THUMB_FAILED;
+    SDL_UnlockMutex(s_lock);
+    return failed;
+}
+
+void thumb_cache_pump(SDL_Renderer* ren, int max_uploads)
+{
+    if (!s_slots) return;
+    SDL_LockMutex(s_lock);
+
+    // 작업 스레드를 못 만들었으면 여기서 하나씩 직접
+    if (!s_worker) {
+        ThumbSlot* job = next_job();
+        if (job) {
+            job->surfaceCount = split_pages(IMG_Load(job->path), job->layout, job->surface);
+            job->state = job->surfaceCount > 0 ? THUMB_DECODED : THUMB_FAILED;
+        }
+    }
+
+    // 보이는 것 먼저 업로드
+    for (int n = 0; n < max_uploads; n++) {
+        ThumbSlot* best = NULL;
+        for (int i = 0; i < s_cap; i++) {
+            ThumbSlot* t = &s_slots[i];
+            if (t->state == THUMB_DECODED && (!best || t->priority < best->priority)) best = t;
+        }
+        if (!best) break;
+        bool ok = true;
+        best->pages.layout = best->layout;
+        for (int p = 0; p < best->surfaceCount; p++) {
+            SDL_Texture* tex = ok ? SDL_CreateTextureFromSurface(ren, best->surface[p]) : NULL;
+            SDL_FreeSurface(best->surface[p]);
+            best->surface[p] = NULL;
+            if (!tex) { ok = false; continue; }
+            best->pages.tex[best->pages.count++] = tex;
+        }
+        best->surfaceCount = 0;
+        if (!ok) {
+            SDL_Log("[THUMB] upload fail %s : %s", best->path, SDL_GetError());
+            atlas_free(&best->pages);
+        }
+        best->state = ok ? THUMB_READY : THUMB_FAILED;
+    }
+    SDL_UnlockMutex(s_lock);
+}
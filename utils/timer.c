@@ -1,2 +1,90 @@
 #include "../include/utils.h"
 Uint32 timer_now_ms(void) { return SDL_GetTicks(); }
+
+// ---------------- 게임 시계 ----------------
+static time_t s_clockBase = 0;     // 시작 시 실제 시각
+static double s_clockElapsed = 0;  // 시작 후 흐른 게임 시간(sec)
+static float  s_clockDt = 0.f;
+static float  s_clockScale = 1.f;
+static bool   s_clockPaused = false;
+static float  s_clockPendingStep = 0.f;
+
+void gameclock_init(void)
+{
+    s_clockBase = time(NULL);
+    s_clockElapsed = 0.0;
+    s_clockDt = 0.f;
+    s_clockScale = 1.f;
+    s_clockPaused = false;
+    s_clockPendingStep = 0.f;
+}
+
+void gameclock_tick(float real_dt)
+{
+    if (s_clockBase == 0) gameclock_init();
+
+    // 창 드래그 등으로 멈췄다 돌아온 프레임이 한꺼번에 수만 초로 튀지 않게
+    if (real_dt < 0.f) real_dt = 0.f;
+    if (real_dt > 0.25f) real_dt = 0.25f;
+
+    if (s_clockPaused) {
+        s_clockDt = s_clockPendingStep;
+        s_clockPendingStep = 0.f;
+    }
+    else {
+        s_clockDt = real_dt * s_clockScale;
+    }
+    s_clockElapsed += s_clockDt;
+}
+
+float gameclock_dt(void) { return s_clockDt; }
+
+Uint64 gameclock_ms(void) { return (Uint64)(s_clockElapsed * 1000.0); }
+
+time_t gameclock_time(void)
+{
+    if (s_clockBase == 0) return time(NULL);
+    return s_clockBase + (time_t)s_clockElapsed;
+}
+
+void gameclock_localtime(struct tm* out)
+{
+    time_t t = gameclock_time();
+#ifdef _WIN32
+    localtime_s(out, &t);
+#else
+    localtime_r(&t, out);
+#endif
+}
+
+int gameclock_sec_of_day(void)
+{
+    struct tm lt;
+    gameclock_localtime(&lt);
+    return lt.tm_hour * 3600 + lt.tm_min * 60 + lt.tm_sec;
+}
+
+void gameclock_set_scale(float scale)
+{
+    if (scale < GAMECLOCK_SCALE_MIN) scale = GAMECLOCK_SCALE_MIN;
+    if (scale > GAMECLOCK_SCALE_MAX) scale = GAMECLOCK_SCALE_MAX;
+    s_clockScale = scale;
+    SDL_Log("[CLOCK] scale x%.0f", s_clockScale);
+}
+
+float gameclock_scale(void) { return s_clockScale; }
+
+void gameclock_set_paused(bool paused)
+{
+    s_clockPaused = paused;
+    s_clockPendingStep = 0.f;
+    SDL_Log("[CLOCK] %s", paused ? "paused" : "resumed");
+}
+
+bool gameclock_paused(void) { return s_clockPaused; }
+
+void gameclock_step(float game_sec)
+{
+    if (!s_clockPaused || game_sec <= 0.f) return;
+    s_clockPendingStep += game_sec;
+}
@@ -1,12 +1,11 @@
 #define _CRT_SECURE_NO_WARNINGS
 #include "../include/weather.h"
+#include "../include/utils.h"
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 #include <time.h>
 
-#define WEATHER_FILE_PATH "assets/weather_state.txt"
-
 // 문자열 → enum 변환
 static WeatherTag map_tag(const char* t) {
     if (strcmp(t, "CLEAR") == 0) return WEATHER_TAG_CLEAR;
@@ -73,6 +72,13 @@ int weather_load(struct WeatherInfo* out) {
     return 1;
 }
 
+int weather_is_valid(const struct WeatherInfo* w) {
+    if (w->tag == WEATHER_TAG_UNKNOWN && w->raw_weather[0] == '\0') return 0;   // TAG/RAW 줄이 없음
+    if (w->temp < -90.0 || w->temp > 70.0) return 0;
+    if (w->humidity < 0 || w->humidity > 100) return 0;
+    return 1;
+}
+
 
 void weather_compute_sun_secs(struct WeatherInfo* w) {
     int y, M, d, h, m, s;
@@ -91,45 +97,144 @@ void weather_compute_sun_secs(struct WeatherInfo* w) {
     }
 }
 
-// 현재 로컬 시간(KST 기준이라고 가정)에서 시간대 계산
+// 게임 시계 기준 로컬 시간(KST 기준이라고 가정)에서 시간대 계산
 TimeOfDay weather_get_time_of_day(const struct WeatherInfo* w) {
-    time_t now = time(NULL);
-    struct tm* lt = localtime(&now);   // 로컬 시간 (윈도우 KST면 그대로 KST)
-
-    if (!lt) {
-        return TIMEOFDAY_DAY; // 실패 시 기본값 (설계 선택)
-    }
-
-    int cur_sec = lt->tm_hour * 3600 + lt->tm_min * 60 + lt->tm_sec;
+    return weather_get_time_of_day_at(w, gameclock_sec_of_day());
+}
 
-    // 구간 폭은 "게임 느낌"에 맞춰 적당히 정한 거라 설계 선택 (추측이 아니라 디자인)
+// 구간 폭은 "게임 느낌"에 맞춰 적당히 정한 거라 설계 선택 (추측이 아니라 디자인)
+static void compute_edges(int sunrise_sec, int sunset_sec, int edges[4]) {
     const int SUNRISE_BEFORE = 30 * 60;   // 일출 30분 전까지는 밤
     const int SUNRISE_AFTER = 60 * 60;   // 일출 후 1시간까지는 일출 구간
     const int SUNSET_BEFORE = 60 * 60;   // 일몰 1시간 전부터 일몰 구간 시작
     const int SUNSET_AFTER = 30 * 60;   // 일몰 후 30분까지 일몰 구간 계속
 
-    int sunrise_start = w->sunrise_sec - SUNRISE_BEFORE;
-    int sunrise_end = w->sunrise_sec + SUNRISE_AFTER;
-    int sunset_start = w->sunset_sec - SUNSET_BEFORE;
-    int sunset_end = w->sunset_sec + SUNSET_AFTER;
+    edges[0] = sunrise_sec - SUNRISE_BEFORE;
+    edges[1] = sunrise_sec + SUNRISE_AFTER;
+    edges[2] = sunset_sec - SUNSET_BEFORE;
+    edges[3] = sunset_sec + SUNSET_AFTER;
 
     // 범위 보정 (0~24h 사이 유지)
-    if (sunrise_start < 0) sunrise_start = 0;
-    if (sunset_end > 24 * 3600) sunset_end = 24 * 3600;
+    if (edges[0] < 0) edges[0] = 0;
+    if (edges[3] > 24 * 3600) edges[3] = 24 * 3600;
+}
 
-    if (cur_sec < sunrise_start) {
+static TimeOfDay band_at(const int edges[4], int cur_sec) {
+    if (cur_sec < edges[0]) {
         return TIMEOFDAY_NIGHT;
     }
-    else if (cur_sec < sunrise_end) {
+    else if (cur_sec < edges[1]) {
         return TIMEOFDAY_SUNRISE;
     }
-    else if (cur_sec < sunset_start) {
+    else if (cur_sec < edges[2]) {
         return TIMEOFDAY_DAY;
     }
-    else if (cur_sec < sunset_end) {
+    else if (cur_sec < edges[3]) {
         return TIMEOFDAY_SUNSET;
     }
     else {
         return TIMEOFDAY_NIGHT;
     }
-}
\ No newline at end of file
+}
+
+TimeOfDay weather_get_time_of_day_at(const struct WeatherInfo* w, int cur_sec) {
+    int edges[4];
+    compute_edges(w->sunrise_sec, w->sunset_sec, edges);
+    return band_at(edges, cur_sec);
+}
+
+// ---------------- 시간대 시계 ----------------
+#define DAY_MS (24LL * 3600 * 1000)
+
+// cur_sec 뒤로 시간대가 실제로 바뀌는 첫 경계 (없으면 자정 = 다음 날 다시 계산)
+static int next_edge(const int edges[4], int cur_sec) {
+    TimeOfDay cur = band_at(edges, cur_sec);
+    int best = 24 * 3600;
+    for (int i = 0; i < 4; i++) {
+        if (edges[i] > cur_sec && edges[i] < best && band_at(edges, edges[i]) != cur)
+            best = edges[i];
+    }
+    return best;
+}
+
+// 지금 시각 기준으로 오늘 0시/현재 구간/다음 전환 다시 계산 (localtime 은 여기서만)
+static void dayclock_resync(DayClock* dc) {
+    long long now = (long long)gameclock_ms();
+    int sec = gameclock_sec_of_day();
+    dc->day_start_ms = now - (long long)sec * 1000;
+    dc->tod = band_at(dc->edges, sec);
+    dc->next_ms = dc->day_start_ms + (long long)next_edge(dc->edges, sec) * 1000;
+}
+
+void dayclock_init(DayClock* dc, const struct WeatherInfo* w, DayClockCallback cb, void* ud) {
+    memset(dc, 0, sizeof(*dc));
+    dc->on_change = cb;
+    dc->ud = ud;
+    dc->sunrise_sec = w->sunrise_sec;
+    dc->sunset_sec = w->sunset_sec;
+    compute_edges(w->sunrise_sec, w->sunset_sec, dc->edges);
+    dayclock_resync(dc);
+}
+
+void dayclock_set_sun(DayClock* dc, const struct WeatherInfo* w) {
+    if (w->sunrise_sec == dc->sunrise_sec && w->sunset_sec == dc->sunset_sec) return;
+    TimeOfDay before = dc->tod;
+    dc->sunrise_sec = w->sunrise_sec;
+    dc->sunset_sec = w->sunset_sec;
+    compute_edges(w->sunrise_sec, w->sunset_sec, dc->edges);
+    dayclock_resync(dc);
+    if (dc->tod != before && dc->on_change) dc->on_change(before, dc->tod, dc->ud);
+}
+
+int dayclock_tick(DayClock* dc) {
+    long long now = (long long)gameclock_ms();
+    if (now < dc->next_ms) return 0;     // 거의 모든 프레임은 여기서 끝
+
+    // 배속이 크면 한 프레임에 경계를 여러 개 지날 수 있음 → 순서대로 하나씩
+    int fired = 0;
+    for (int guard = 0; now >= dc->next_ms; guard++) {
+        if (guard == 16) {
+            // 며칠씩 건너뛴 경우: 중간 전환은 생략하고 지금 기준으로 맞춤
+            TimeOfDay before = dc->tod;
+            dayclock_resync(dc);
+            if (dc->tod != before && dc->on_change) dc->on_change(before, dc->tod, dc->ud);
+            return fired + 1;
+        }
+        long long at = dc->next_ms;
+        if (at >= dc->day_start_ms + DAY_MS) dc->day_start_ms += DAY_MS;
+        int sec = (int)((at - dc->day_start_ms) / 1000);
+
+        TimeOfDay before = dc->tod;
+        dc->tod = band_at(dc->edges, sec);
+        dc->next_ms = dc->day_start_ms + (long long)next_edge(dc->edges, sec) * 1000;
+        if (dc->tod != before) {
+            fired++;
+            if (dc->on_change) dc->on_change(before, dc->tod, dc->ud);
+        }
+    }
+    return fired;
+}
+
+TimeOfDay dayclock_current(const DayClock* dc) {
+    return dc->tod;
+}
+
+void dayclock_peek_next(const DayClock* dc, TimeOfDay* next, long long* in_ms) {
+    long long sec = ((dc->next_ms - dc->day_start_ms) / 1000) % (24 * 3600);
+    *next = band_at(dc->edges, (int)sec);
+    *in_ms = dc->next_ms - (long long)gameclock_ms();
+}
+
+float dayclock_sun_phase(const DayClock* dc) {
+    long long inDay = ((long long)gameclock_ms() - dc->day_start_ms) % DAY_MS;
+    if (inDay < 0) inDay += DAY_MS;
+    double sec = (double)inDay / 1000.0;
+    double rise = dc->sunrise_sec, set = dc->sunset_sec;
+    if (set <= rise) return sec < 12 * 3600 ? 0.25f : 0.75f;   // 일출/일몰을 못 읽었을 때
+
+    if (sec >= rise && sec < set)
+        return (float)(0.5 * (sec - rise) / (set - rise));
+    double night = 24.0 * 3600 - (set - rise);
+    double since = sec >= set ? sec - set : sec + 24.0 * 3600 - set;
+    return (float)(0.5 + 0.5 * since / night);
+}
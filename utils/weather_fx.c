@@ -0,0 +1,337 @@
+#include "../include/weather_fx.h"
+#include <math.h>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define WEATHER_FX_SSE 1
+#endif
+
+typedef enum { FX_RAIN = 0, FX_SNOW, FX_CLOUD, FX_MOTE, FX_KIND_COUNT } FxKind;
+
+// 종류별 최대 개수 (세기 1 일 때). 합이 WEATHER_FX_MAX 를 넘지 않게
+static const int   FX_KIND_MAX[FX_KIND_COUNT] = { 1200, 500, 12, 80 };
+// 세기가 오를 때 프레임당 새로 만드는 수 (한꺼번에 생기지 않게)
+static const int   FX_SPAWN_PER_FRAME[FX_KIND_COUNT] = { 40, 8, 1, 2 };
+static const float FX_LEVEL_RATE = 0.5f;       // 세기 변화 속도 (1/sec)
+
+#define FX_CLOUD_SEGS 8
+#define FX_VERT_MAX  (4 + FX_CLOUD_SEGS * 12 + 12 + WEATHER_FX_MAX * 4)
+#define FX_INDEX_MAX (6 + FX_CLOUD_SEGS * 3 * 12 + WEATHER_FX_MAX * 6)
+
+// ---- 입자 (SoA) ----
+static float s_x[WEATHER_FX_MAX], s_y[WEATHER_FX_MAX];
+static float s_vx[WEATHER_FX_MAX], s_vy[WEATHER_FX_MAX];
+static float s_life[WEATHER_FX_MAX];    // 남은 시간 (sec)
+static float s_age[WEATHER_FX_MAX];     // 지난 시간 (sec). 눈 흔들림/먼지 깜빡임 위상
+static float s_size[WEATHER_FX_MAX];
+static Uint8 s_kind[WEATHER_FX_MAX];
+static int   s_count = 0;
+static int   s_alive[FX_KIND_COUNT];
+
+static float s_level[FX_KIND_COUNT];    // 지금 세기 (목표로 천천히 따라감)
+static float s_target[FX_KIND_COUNT];
+static float s_overcast = 0.f, s_overcastTarget = 0.f;     // 하늘 흐림 (덮는 알파 0~1)
+static bool  s_night = false;
+static bool  s_prefill = true;          // 씬 진입 직후 한 번은 화면 전체에 바로 채움
+static int   s_w = APP_WIDTH, s_h = APP_HEIGHT;
+static Uint64 s_rng = 0x9E3779B97F4A7C15ULL;
+
+static SDL_Vertex s_verts[FX_VERT_MAX];
+static int        s_indices[FX_INDEX_MAX];
+static int        s_vcount = 0, s_icount = 0;
+
+static float fx_rand01(void)
+{
+    Uint64 x = s_rng;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    s_rng = x;
+    return (float)((x * 0x2545F4914F6CDD1DULL) >> 40) / (float)(1 << 24);
+}
+
+static float fx_range(float a, float b) { return a + (b - a) * fx_rand01(); }
+
+void weather_fx_init(void)
+{
+    s_count = 0;
+    SDL_memset(s_alive, 0, sizeof(s_alive));
+    SDL_memset(s_level, 0, sizeof(s_level));
+    SDL_memset(s_target, 0, sizeof(s_target));
+    s_overcast = s_overcastTarget = 0.f;
+    s_prefill = true;
+    s_rng ^= (Uint64)SDL_GetTicks() * 0x9E3779B97F4A7C15ULL;
+    if (!s_rng) s_rng = 1;
+}
+
+void weather_fx_set(WeatherTag tag, float intensity, bool night)
+{
+    if (intensity < 0.f) intensity = 0.f;
+    if (intensity > 1.f) intensity = 1.f;
+    SDL_memset(s_target, 0, sizeof(s_target));
+    s_overcastTarget = 0.f;
+    s_night = night;
+
+    switch (tag) {
+    case WEATHER_TAG_CLEAR:
+        if (!night) s_target[FX_MOTE] = 1.f;
+        break;
+    case WEATHER_TAG_CLOUDY:
+        s_target[FX_CLOUD] = intensity;
+        s_overcastTarget = 0.25f * intensity;
+        break;
+    case WEATHER_TAG_RAIN:
+        s_target[FX_RAIN] = 0.7f * intensity;
+        s_target[FX_CLOUD] = 0.5f;
+        s_overcastTarget = 0.35f * intensity;
+        break;
+    case WEATHER_TAG_STORM:
+        s_target[FX_RAIN] = 1.f;
+        s_target[FX_CLOUD] = 0.8f;
+        s_overcastTarget = 0.5f;
+        break;
+    case WEATHER_TAG_SNOW:
+        s_target[FX_SNOW] = intensity;
+        s_target[FX_CLOUD] = 0.4f;
+        s_overcastTarget = 0.15f * intensity;
+        break;
+    default:
+        break;
+    }
+    if (s_prefill) {
+        SDL_memcpy(s_level, s_target, sizeof(s_level));
+        s_overcast = s_overcastTarget;
+    }
+}
+
+// i 번 칸을 kind 입자로 (새로 만들거나 화면 밖으로 나간 것 재사용). anywhere 면 화면 안 아무 데나
+static void spawn(int i, FxKind kind, bool anywhere)
+{
+    float sc = (float)s_h / APP_HEIGHT;
+    s_kind[i] = (Uint8)kind;
+    s_age[i] = 0.f;
+    switch (kind) {
+    case FX_RAIN:
+        s_vy[i] = s_h * fx_range(1.4f, 1.9f);
+        s_vx[i] = s_vy[i] * 0.15f;                   // 바람에 살짝 기울어짐
+        s_x[i] = fx_range(-0.2f, 1.0f) * s_w;
+        s_y[i] = anywhere ? fx_range(0.f, 1.f) * s_h : fx_range(-0.25f, 0.f) * s_h;
+        s_size[i] = fx_range(14.f, 26.f) * sc;       // 빗줄기 길이
+        s_life[i] = 10.f;
+        break;
+    case FX_SNOW:
+        s_vy[i] = s_h * fx_range(0.06f, 0.14f);
+        s_vx[i] = fx_range(-20.f, 20.f) * sc;
+        s_x[i] = fx_range(0.f, 1.f) * s_w;
+        s_y[i] = anywhere ? fx_range(0.f, 1.f) * s_h : fx_range(-0.1f, 0.f) * s_h;
+        s_size[i] = fx_range(2.f, 5.f) * sc;
+        s_age[i] = fx_range(0.f, 6.2831853f);        // 흔들림 위상
+        s_life[i] = 60.f;
+        break;
+    case FX_CLOUD:
+        s_size[i] = fx_range(80.f, 180.f) * sc;      // 반지름
+        s_vx[i] = s_w * fx_range(0.01f, 0.025f);
+        s_vy[i] = 0.f;
+        s_x[i] = anywhere ? fx_range(0.f, 1.f) * s_w : -s_size[i];
+        s_y[i] = fx_range(0.f, 0.35f) * s_h;
+        s_life[i] = 600.f;
+        break;
+    case FX_MOTE:
+        s_x[i] = fx_range(0.f, 1.f) * s_w;
+        s_y[i] = fx_range(0.f, 1.f) * s_h;
+        s_vx[i] = fx_range(-15.f, 15.f) * sc;
+        s_vy[i] = fx_range(-12.f, 6.f) * sc;
+        s_size[i] = fx_range(1.5f, 3.5f) * sc;
+        s_life[i] = fx_range(3.f, 6.f);
+        break;
+    default:
+        break;
+    }
+}
+
+// 마지막 입자를 i 로 옮겨 채움
+static void kill(int i)
+{
+    int last = --s_count;
+    s_alive[s_kind[i]]--;
+    if (i == last) return;
+    s_x[i] = s_x[last];       s_y[i] = s_y[last];
+    s_vx[i] = s_vx[last];     s_vy[i] = s_vy[last];
+    s_life[i] = s_life[last]; s_age[i] = s_age[last];
+    s_size[i] = s_size[last]; s_kind[i] = s_kind[last];
+}
+
+// 위치/시간 적분. 배열이 4의 배수 크기라 꼬리 처리 없이 4개씩 (죽은 칸도 같이 돌지만 다음 생성 때 덮어씀)
+static void integrate(float dt)
+{
+    int n = (s_count + 3) & ~3;
+#ifdef WEATHER_FX_SSE
+    __m128 vdt = _mm_set1_ps(dt);
+    for (int i = 0; i < n; i += 4) {
+        _mm_storeu_ps(&s_x[i], _mm_add_ps(_mm_loadu_ps(&s_x[i]), _mm_mul_ps(_mm_loadu_ps(&s_vx[i]), vdt)));
+        _mm_storeu_ps(&s_y[i], _mm_add_ps(_mm_loadu_ps(&s_y[i]), _mm_mul_ps(_mm_loadu_ps(&s_vy[i]), vdt)));
+        _mm_storeu_ps(&s_life[i], _mm_sub_ps(_mm_loadu_ps(&s_life[i]), vdt));
+        _mm_storeu_ps(&s_age[i], _mm_add_ps(_mm_loadu_ps(&s_age[i]), vdt));
+    }
+#else
+    for (int i = 0; i < n; i++) {
+        s_x[i] += s_vx[i] * dt;
+        s_y[i] += s_vy[i] * dt;
+        s_life[i] -= dt;
+        s_age[i] += dt;
+    }
+#endif
+}
+
+static bool out_of_view(int i)
+{
+    float m = s_size[i] + 4.f;
+    return s_life[i] <= 0.f || s_y[i] - m > s_h || s_x[i] - m > s_w || s_x[i] + m < -0.25f * s_w;
+}
+
+void weather_fx_update(float dt, int w, int h)
+{
+    if (w > 0) s_w = w;
+    if (h > 0) s_h = h;
+    if (dt > 0.1f) dt = 0.1f;   // 멈췄다 돌아올 때 한꺼번에 튀지 않게
+
+    float step = FX_LEVEL_RATE * dt;
+    for (int k = 0; k < FX_KIND_COUNT; k++) {
+        if (s_level[k] < s_target[k]) s_level[k] = SDL_min(s_target[k], s_level[k] + step);
+        else                          s_level[k] = SDL_max(s_target[k], s_level[k] - step);
+    }
+    if (s_overcast < s_overcastTarget) s_overcast = SDL_min(s_overcastTarget, s_overcast + step);
+    else                               s_overcast = SDL_max(s_overcastTarget, s_overcast - step);
+
+    integrate(dt);
+
+    int want[FX_KIND_COUNT];
+    for (int k = 0; k < FX_KIND_COUNT; k++) want[k] = (int)(FX_KIND_MAX[k] * s_level[k]);
+
+    // 화면을 벗어난 입자: 아직 모자라면 위에서 다시, 넘치면 버림
+    for (int i = 0; i < s_count; ) {
+        if (!out_of_view(i)) { i++; continue; }
+        FxKind k = (FxKind)s_kind[i];
+        if (s_alive[k] <= want[k]) { spawn(i, k, k == FX_MOTE); i++; }
+        else kill(i);
+    }
+
+    for (int k = 0; k < FX_KIND_COUNT; k++) {
+        int n = want[k] - s_alive[k];
+        if (!s_prefill && n > FX_SPAWN_PER_FRAME[k]) n = FX_SPAWN_PER_FRAME[k];
+        for (; n > 0 && s_count < WEATHER_FX_MAX; n--) {
+            spawn(s_count++, (FxKind)k, s_prefill || k == FX_MOTE);
+            s_alive[k]++;
+        }
+    }
+    s_prefill = false;
+}
+
+static void fx_vertex(float x, float y, SDL_Color c)
+{
+    SDL_Vertex* v = &s_verts[s_vcount++];
+    v->position.x = x;
+    v->position.y = y;
+    v->color = c;
+    v->tex_coord.x = 0.f;
+    v->tex_coord.y = 0.f;
+}
+
+// 정점 a..a+3 사각형 (0-1-2, 0-2-3)
+static void fx_quad(int a)
+{
+    int* i = &s_indices[s_icount];
+    i[0] = a; i[1] = a + 1; i[2] = a + 2;
+    i[3] = a; i[4] = a + 2; i[5] = a + 3;
+    s_icount += 6;
+}
+
+// 가운데 진하고 가장자리로 갈수록 투명한 원 (부채꼴)
+static void build_cloud(int i)
+{
+    if (s_vcount + FX_CLOUD_SEGS + 1 > FX_VERT_MAX || s_icount + FX_CLOUD_SEGS * 3 > FX_INDEX_MAX) return;
+    SDL_Color mid = s_night ? (SDL_Color){ 60, 65, 80, 110 } : (SDL_Color){ 235, 238, 245, 110 };
+    SDL_Color rim = mid; rim.a = 0;
+    float rx = s_size[i], ry = s_size[i] * 0.45f;    // 납작한 타원
+    int c = s_vcount;
+    fx_vertex(s_x[i], s_y[i], mid);
+    for (int s = 0; s < FX_CLOUD_SEGS; s++) {
+        float a = s * (6.2831853f / FX_CLOUD_SEGS);
+        fx_vertex(s_x[i] + cosf(a) * rx, s_y[i] + sinf(a) * ry, rim);
+    }
+    for (int s = 0; s < FX_CLOUD_SEGS; s++) {
+        int* ix = &s_indices[s_icount];
+        ix[0] = c; ix[1] = c + 1 + s; ix[2] = c + 1 + (s + 1) % FX_CLOUD_SEGS;
+        s_icount += 3;
+    }
+}
+
+static void build_particle(int i)
+{
+    if (s_vcount + 4 > FX_VERT_MAX || s_icount + 6 > FX_INDEX_MAX) return;
+    float x = s_x[i], y = s_y[i], sz = s_size[i];
+    int a = s_vcount;
+
+    switch ((FxKind)s_kind[i]) {
+    case FX_RAIN: {
+        // 속도 방향으로 늘인 가는 사각형. 꼬리는 투명
+        float len = SDL_sqrtf(s_vx[i] * s_vx[i] + s_vy[i] * s_vy[i]);
+        float dx = s_vx[i] / len, dy = s_vy[i] / len;
+        float tx = x - dx * sz, ty = y - dy * sz;
+        float px = -dy * 0.8f, py = dx * 0.8f;     // 두께 절반
+        SDL_Color head = { 180, 200, 230, 140 };
+        SDL_Color tail = { 180, 200, 230, 0 };
+        fx_vertex(x - px, y - py, head);
+        fx_vertex(x + px, y + py, head);
+        fx_vertex(tx + px, ty + py, tail);
+        fx_vertex(tx - px, ty - py, tail);
+        break;
+    }
+    case FX_SNOW: {
+        x += sinf(s_age[i] * 1.3f) * 12.f * ((float)s_h / APP_HEIGHT);
+        SDL_Color c = { 255, 255, 255, 220 };
+        fx_vertex(x, y - sz, c);
+        fx_vertex(x + sz, y, c);
+        fx_vertex(x, y + sz, c);
+        fx_vertex(x - sz, y, c);
+        break;
+    }
+    case FX_MOTE: {
+        // 나타났다 사라짐: 일생 동안 sin 곡선
+        float t = s_age[i] / (s_age[i] + SDL_max(s_life[i], 0.001f));
+        SDL_Color c = { 255, 240, 190, (Uint8)(160.f * sinf(3.1415927f * t)) };
+        fx_vertex(x, y - sz, c);
+        fx_vertex(x + sz, y, c);
+        fx_vertex(x, y + sz, c);
+        fx_vertex(x - sz, y, c);
+        break;
+    }
+    default:
+        return;
+    }
+    fx_quad(a);
+}
+
+void weather_fx_render(SDL_Renderer* r)
+{
+    s_vcount = s_icount = 0;
+
+    // 하늘 흐림 → 구름 → 비/눈/먼지 순서로 한 묶음
+    if (s_overcast > 0.f) {
+        SDL_Color c = { 70, 78, 92, (Uint8)(s_overcast * 255.f) };
+        fx_vertex(0.f, 0.f, c);
+        fx_vertex((float)s_w, 0.f, c);
+        fx_vertex((float)s_w, (float)s_h, c);
+        fx_vertex(0.f, (float)s_h, c);
+        fx_quad(0);
+    }
+    if (s_alive[FX_CLOUD] > 0)
+        for (int i = 0; i < s_count; i++)
+            if (s_kind[i] == FX_CLOUD) build_cloud(i);
+    for (int i = 0; i < s_count; i++)
+        if (s_kind[i] != FX_CLOUD) build_particle(i);
+
+    if (s_icount == 0) return;
+    SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_BLEND);
+    SDL_RenderGeometry(r, NULL, s_verts, s_vcount, s_indices, s_icount);
+}
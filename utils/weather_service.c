@@ -0,0 +1,353 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include "../include/weather_service.h"
+#include "../include/weather_timeline.h"
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#include <fcntl.h>
+#endif
+
+#define WEATHER_STAT_POLL_MS 1000   // inotify 가 없을 때 파일 확인 간격
+
+// watch_wait 결과: 바뀐 파일
+#define WATCH_STATE    1
+#define WATCH_FORECAST 2
+
+static SDL_Thread*     s_thread = NULL;
+static SDL_mutex*      s_lock = NULL;
+static SDL_cond*       s_wake = NULL;
+static bool            s_quit = false;
+static bool            s_busy = false;          // 공급자 실행 중 (종료 때 기다리지 않음)
+static Uint32          s_interval = WEATHER_SERVICE_DEFAULT_INTERVAL_MS;
+static WeatherProvider s_provider = NULL;
+static void*           s_providerUd = NULL;
+
+// 작업 스레드 → 메인 스레드. 교환으로만 주고받으므로 한 포인터는 항상 한쪽만 소유
+static void*        s_pending = NULL;
+static WeatherInfo* s_current = NULL;           // 메인 스레드 소유
+static void*        s_pendingForecast = NULL;   // WeatherForecast*, 메인 스레드가 타임라인에 합침
+
+// 작업 스레드 전용: 마지막으로 넘긴 내용 (같으면 다시 안 넘김)
+static WeatherInfo s_lastParsed;
+static bool        s_haveParsed = false;
+
+static struct {
+    WeatherListener fn;
+    void* ud;
+} s_listeners[WEATHER_MAX_LISTENERS];
+
+// ---------------------------------------------------------------------------
+// 파일 바뀜 감시: inotify (Linux), 없으면 mtime/크기 비교
+// ---------------------------------------------------------------------------
+#ifdef __linux__
+static int s_inotifyFd = -1;
+static int s_wakePipe[2] = {-1, -1};    // 종료/즉시 갱신 때 poll 깨우기
+#endif
+typedef struct FileStamp {
+    Sint64 mtime, size;
+} FileStamp;
+static FileStamp s_stateStamp = {-1, -1};
+static FileStamp s_forecastStamp = {-1, -1};
+
+static bool file_stamp_changed(const char* path, FileStamp* stamp)
+{
+    struct stat st;
+    Sint64 mtime = -1, size = -1;
+    if (stat(path, &st) == 0) {
+        mtime = (Sint64)st.st_mtime;
+        size = (Sint64)st.st_size;
+    }
+    bool changed = mtime != stamp->mtime || size != stamp->size;
+    stamp->mtime = mtime;
+    stamp->size = size;
+    return changed;
+}
+
+static int file_stamps_changed(void)
+{
+    int changed = 0;
+    if (file_stamp_changed(WEATHER_FILE_PATH, &s_stateStamp)) changed |= WATCH_STATE;
+    if (file_stamp_changed(WEATHER_FORECAST_PATH, &s_forecastStamp)) changed |= WATCH_FORECAST;
+    return changed;
+}
+
+static void watch_open(void)
+{
+    file_stamps_changed();
+#ifdef __linux__
+    // 파일이 아니라 폴더를 봄: 스크립트가 새로 만들거나 rename 으로 바꿔 써도 잡힘
+    s_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (s_inotifyFd >= 0 &&
+        inotify_add_watch(s_inotifyFd, WEATHER_FILE_DIR, IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        close(s_inotifyFd);
+        s_inotifyFd = -1;
+    }
+    if (s_inotifyFd >= 0 && pipe(s_wakePipe) == 0) {
+        fcntl(s_wakePipe[0], F_SETFL, O_NONBLOCK);
+        fcntl(s_wakePipe[1], F_SETFL, O_NONBLOCK);
+    }
+    else if (s_inotifyFd >= 0) {
+        close(s_inotifyFd);
+        s_inotifyFd = -1;
+    }
+    if (s_inotifyFd < 0)
+        SDL_Log("[WEATHER] inotify unavailable, checking file every %d ms", WEATHER_STAT_POLL_MS);
+#endif
+}
+
+static void watch_close(void)
+{
+#ifdef __linux__
+    if (s_inotifyFd >= 0) close(s_inotifyFd);
+    if (s_wakePipe[0] >= 0) close(s_wakePipe[0]);
+    if (s_wakePipe[1] >= 0) close(s_wakePipe[1]);
+    s_inotifyFd = s_wakePipe[0] = s_wakePipe[1] = -1;
+#endif
+}
+
+// 잠금 상태에서 호출: 기다리는 스레드 깨우기
+static void watch_wake(void)
+{
+    SDL_CondSignal(s_wake);
+#ifdef __linux__
+    if (s_wakePipe[1] >= 0) {
+        char c = 1;
+        if (write(s_wakePipe[1], &c, 1) < 0) { /* 이미 깨울 게 쌓여 있음 */ }
+    }
+#endif
+}
+
+#ifdef __linux__
+// inotify 이벤트 중 날씨/예보 파일이 있었는지 (WATCH_*)
+static int drain_inotify(void)
+{
+    char buf[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    int hit = 0;
+    ssize_t len;
+    while ((len = read(s_inotifyFd, buf, sizeof(buf))) > 0) {
+        for (char* p = buf; p < buf + len; ) {
+            const struct inotify_event* ev = (const struct inotify_event*)p;
+            if (ev->len && strcmp(ev->name, WEATHER_FILE_NAME) == 0) hit |= WATCH_STATE;
+            if (ev->len && strcmp(ev->name, WEATHER_FORECAST_NAME) == 0) hit |= WATCH_FORECAST;
+            p += sizeof(struct inotify_event) + ev->len;
+        }
+    }
+    return hit;
+}
+#endif
+
+// 잠금 없이 호출. 바뀐 파일 (WATCH_*), 시간이 다 됐거나 깨웠으면 0
+static int watch_wait(Uint32 timeout_ms)
+{
+#ifdef __linux__
+    if (s_inotifyFd >= 0) {
+        struct pollfd fds[2] = {
+            { s_inotifyFd, POLLIN, 0 },
+            { s_wakePipe[0], POLLIN, 0 },
+        };
+        int timeout = timeout_ms == SDL_MAX_UINT32 ? -1 : (int)timeout_ms;
+        if (poll(fds, 2, timeout) <= 0) return 0;
+        if (fds[1].revents & POLLIN) {
+            char c[16];
+            while (read(s_wakePipe[0], c, sizeof(c)) > 0) {}
+        }
+        return (fds[0].revents & POLLIN) ? drain_inotify() : 0;
+    }
+#endif
+    SDL_LockMutex(s_lock);
+    if (!s_quit)
+        SDL_CondWaitTimeout(s_wake, s_lock, SDL_min(timeout_ms, (Uint32)WEATHER_STAT_POLL_MS));
+    SDL_UnlockMutex(s_lock);
+    return file_stamps_changed();
+}
+
+// ---------------------------------------------------------------------------
+
+bool weather_provider_script(void* ud)
+{
+    (void)ud;
+    int rc = system("python assets/weather_update.py");
+    if (rc != 0) SDL_Log("[WEATHER] update script failed (rc=%d), keeping last file", rc);
+    return rc == 0;
+}
+
+// 파일을 읽어서, 검사를 통과하고 내용이 바뀌었으면 넘김 (아직 안 가져간 이전 것은 여기서 버림)
+static void publish_from_file(void)
+{
+    WeatherInfo w;
+    if (!weather_load(&w)) return;
+    if (!weather_is_valid(&w)) {
+        SDL_Log("[WEATHER] %s rejected (incomplete or out of range), keeping last", WEATHER_FILE_PATH);
+        return;
+    }
+    weather_compute_sun_secs(&w);
+    if (s_haveParsed && SDL_memcmp(&w, &s_lastParsed, sizeof(w)) == 0) return;
+    s_lastParsed = w;
+    s_haveParsed = true;
+
+    WeatherInfo* copy = (WeatherInfo*)SDL_malloc(sizeof(WeatherInfo));
+    if (!copy) return;
+    *copy = w;
+    void* stale = SDL_AtomicSetPtr(&s_pending, copy);
+    SDL_free(stale);
+}
+
+// 예보 파일 → 메인 스레드 (타임라인에 합치는 건 weather_service_poll)
+static void publish_forecast(void)
+{
+    WeatherForecast* fc = (WeatherForecast*)SDL_malloc(sizeof(WeatherForecast));
+    if (!fc) return;
+    if (!weather_forecast_load(WEATHER_FORECAST_PATH, fc)) {
+        SDL_free(fc);
+        return;
+    }
+    void* stale = SDL_AtomicSetPtr(&s_pendingForecast, fc);
+    SDL_free(stale);
+}
+
+static int SDLCALL weather_thread(void* ud)
+{
+    (void)ud;
+    watch_open();
+    publish_from_file();    // 지난번 파일부터 바로 보여 줌
+    publish_forecast();
+
+    Uint32 nextFetch = SDL_GetTicks();
+    for (;;) {
+        SDL_LockMutex(s_lock);
+        bool quit = s_quit;
+        WeatherProvider provider = s_provider;
+        void* pud = s_providerUd;
+        bool fetch = !quit && provider && (Sint32)(SDL_GetTicks() - nextFetch) >= 0;
+        s_busy = fetch;
+        SDL_UnlockMutex(s_lock);
+        if (quit) break;
+
+        if (fetch) {
+            provider(pud);      // 네트워크 왕복 (최대 스크립트 타임아웃). 파일이 바뀌면 감시가 알려 줌
+            nextFetch = SDL_GetTicks() + s_interval;
+            SDL_LockMutex(s_lock);
+            s_busy = false;
+            quit = s_quit;
+            SDL_UnlockMutex(s_lock);
+            if (quit) break;
+        }
+
+        Uint32 wait = SDL_MAX_UINT32;
+        if (provider) {
+            Sint32 left = (Sint32)(nextFetch - SDL_GetTicks());
+            wait = left > 0 ? (Uint32)left : 0;
+        }
+        int changed = watch_wait(wait);
+        if (changed & WATCH_STATE) publish_from_file();
+        if (changed & WATCH_FORECAST) publish_forecast();
+    }
+    return 0;
+}
+
+bool weather_service_start(WeatherProvider provider, void* ud, Uint32 interval_ms)
+{
+    if (s_thread) return true;
+    if (!s_lock) s_lock = SDL_CreateMutex();
+    if (!s_wake) s_wake = SDL_CreateCond();
+    if (!s_lock || !s_wake) {
+        SDL_Log("[WEATHER] init failed: %s", SDL_GetError());
+        return false;
+    }
+    s_provider = provider;
+    s_providerUd = ud;
+    s_interval = interval_ms ? interval_ms : WEATHER_SERVICE_DEFAULT_INTERVAL_MS;
+    s_quit = false;
+    s_haveParsed = false;
+
+    s_thread = SDL_CreateThread(weather_thread, "weather", NULL);
+    if (!s_thread) {
+        // 스레드가 없으면 외부 호출은 하지 않고 파일만 한 번 읽음 (프레임을 멈추지 않기 위해)
+        SDL_Log("[WEATHER] thread failed, using last weather file only: %s", SDL_GetError());
+        publish_from_file();
+        return false;
+    }
+    return true;
+}
+
+void weather_service_stop(void)
+{
+    if (s_thread) {
+        SDL_LockMutex(s_lock);
+        s_quit = true;
+        bool busy = s_busy;
+        watch_wake();
+        SDL_UnlockMutex(s_lock);
+
+        if (busy) {
+            // 스크립트가 끝날 때까지 종료를 붙잡지 않음. 스레드는 끝나면 s_quit 을 보고 스스로 나감
+            // (그래서 잠금/조건 변수/감시 핸들은 남겨 둠)
+            SDL_DetachThread(s_thread);
+            s_thread = NULL;
+        }
+        else {
+            SDL_WaitThread(s_thread, NULL);
+            s_thread = NULL;
+            watch_close();
+            SDL_DestroyCond(s_wake);
+            SDL_DestroyMutex(s_lock);
+            s_wake = NULL;
+            s_lock = NULL;
+            SDL_free(SDL_AtomicSetPtr(&s_pending, NULL));
+            SDL_free(SDL_AtomicSetPtr(&s_pendingForecast, NULL));
+        }
+    }
+    SDL_free(s_current);
+    s_current = NULL;
+    SDL_memset(s_listeners, 0, sizeof(s_listeners));
+    weather_timeline_clear();
+}
+
+bool weather_service_poll(void)
+{
+    WeatherForecast* fc = (WeatherForecast*)SDL_AtomicSetPtr(&s_pendingForecast, NULL);
+    if (fc) {
+        weather_timeline_merge(fc);
+        SDL_free(fc);
+    }
+
+    WeatherInfo* fresh = (WeatherInfo*)SDL_AtomicSetPtr(&s_pending, NULL);
+    if (!fresh) return fc != NULL;
+    WeatherInfo* before = s_current;
+    s_current = fresh;
+    for (int i = 0; i < WEATHER_MAX_LISTENERS; i++) {
+        if (s_listeners[i].fn) s_listeners[i].fn(fresh, before, s_listeners[i].ud);
+    }
+    SDL_free(before);
+    return true;
+}
+
+const WeatherInfo* weather_service_current(void)
+{
+    return s_current;
+}
+
+int weather_service_subscribe(WeatherListener fn, void* ud)
+{
+    if (!fn) return 0;
+    for (int i = 0; i < WEATHER_MAX_LISTENERS; i++) {
+        if (!s_listeners[i].fn) {
+            s_listeners[i].fn = fn;
+            s_listeners[i].ud = ud;
+            return i + 1;
+        }
+    }
+    SDL_Log("[WEATHER] too many listeners (max %d)", WEATHER_MAX_LISTENERS);
+    return 0;
+}
+
+void weather_service_unsubscribe(int handle)
+{
+    if (handle < 1 || handle > WEATHER_MAX_LISTENERS) return;
+    s_listeners[handle - 1].fn = NULL;
+    s_listeners[handle - 1].ud = NULL;
+}
@@ -0,0 +1,131 @@
+#define _CRT_SECURE_NO_WARNINGS
+#include "../include/weather_timeline.h"
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+static WeatherSample s_ring[WEATHER_TIMELINE_CAP];
+static int s_head = 0;      // 가장 오래된 샘플 위치
+static int s_count = 0;
+static int s_cursor = 0;    // 마지막 질의 구간 (논리 인덱스, 0 = 가장 오래된 것)
+
+static WeatherSample* at(int i)
+{
+    return &s_ring[(s_head + i) % WEATHER_TIMELINE_CAP];
+}
+
+static WeatherTag parse_tag(const char* t)
+{
+    if (strcmp(t, "CLEAR") == 0) return WEATHER_TAG_CLEAR;
+    if (strcmp(t, "CLOUDY") == 0) return WEATHER_TAG_CLOUDY;
+    if (strcmp(t, "RAIN") == 0) return WEATHER_TAG_RAIN;
+    if (strcmp(t, "SNOW") == 0) return WEATHER_TAG_SNOW;
+    if (strcmp(t, "STORM") == 0) return WEATHER_TAG_STORM;
+    return WEATHER_TAG_UNKNOWN;
+}
+
+bool weather_forecast_load(const char* path, WeatherForecast* out)
+{
+    out->count = 0;
+    FILE* fp = fopen(path, "r");
+    if (!fp) return false;
+
+    char line[256];
+    while (fgets(line, sizeof(line), fp) && out->count < WEATHER_TIMELINE_CAP) {
+        if (line[0] == '#') continue;
+        long long ts;
+        char tag[16];
+        float temp, hum;
+        if (sscanf(line, "%lld %15s %f %f", &ts, tag, &temp, &hum) != 4) continue;
+        if (temp < -90.f || temp > 70.f || hum < 0.f || hum > 100.f) continue;
+        // 시각이 거꾸로 가는 줄은 버림 (보간/커서가 정렬을 가정)
+        if (out->count > 0 && ts <= out->samples[out->count - 1].ts) continue;
+
+        WeatherSample* s = &out->samples[out->count++];
+        s->ts = (Sint64)ts;
+        s->tag = parse_tag(tag);
+        s->temp = temp;
+        s->humidity = hum;
+    }
+    fclose(fp);
+    return out->count > 0;
+}
+
+void weather_timeline_clear(void)
+{
+    s_head = 0;
+    s_count = 0;
+    s_cursor = 0;
+}
+
+void weather_timeline_merge(const WeatherForecast* fc)
+{
+    if (!fc || fc->count <= 0) return;
+
+    // 새 예보가 덮는 구간은 뒤에서부터 버림 (예보 수정)
+    Sint64 first = fc->samples[0].ts;
+    while (s_count > 0 && at(s_count - 1)->ts >= first) s_count--;
+
+    for (int i = 0; i < fc->count; i++) {
+        if (s_count == WEATHER_TIMELINE_CAP) {
+            s_head = (s_head + 1) % WEATHER_TIMELINE_CAP;
+            s_count--;
+        }
+        *at(s_count++) = fc->samples[i];
+    }
+    s_cursor = 0;
+}
+
+int weather_timeline_count(void)
+{
+    return s_count;
+}
+
+// ts 가 들어가는 구간 [i, i+1) 의 i. 처음보다 앞이면 -1
+static int find_segment(Sint64 ts)
+{
+    int i = s_cursor;
+    if (i >= s_count) i = s_count - 1;
+    while (i > 0 && at(i)->ts > ts) i--;
+    while (i + 1 < s_count && at(i + 1)->ts <= ts) i++;
+    s_cursor = i;
+    return at(i)->ts <= ts ? i : -1;
+}
+
+bool weather_timeline_at(Sint64 ts, WeatherSample* out)
+{
+    if (s_count == 0) return false;
+    int i = find_segment(ts);
+    if (i < 0) return false;
+    if (i + 1 >= s_count) {
+        Sint64 step = i > 0 ? at(i)->ts - at(i - 1)->ts : WEATHER_FORECAST_STEP_SEC;
+        if (ts > at(i)->ts + step) return false;
+        *out = *at(i);
+    }
+    else {
+        const WeatherSample* a = at(i);
+        const WeatherSample* b = at(i + 1);
+        float t = (float)(ts - a->ts) / (float)(b->ts - a->ts);
+        out->tag = a->tag;
+        out->temp = a->temp + (b->temp - a->temp) * t;
+        out->humidity = a->humidity + (b->humidity - a->humidity) * t;
+    }
+    out->ts = ts;
+    return true;
+}
+
+bool weather_timeline_next_change(Sint64 ts, WeatherTag* tag, Sint64* when)
+{
+    if (s_count == 0) return false;
+    int i = find_segment(ts);
+    WeatherTag cur = i < 0 ? WEATHER_TAG_UNKNOWN : at(i)->tag;
+    for (int k = i + 1; k < s_count; k++) {
+        const WeatherSample* s = at(k);
+        if (s->tag != cur && s->tag != WEATHER_TAG_UNKNOWN) {
+            *tag = s->tag;
+            *when = s->ts;
+            return true;
+        }
+    }
+    return false;
+}